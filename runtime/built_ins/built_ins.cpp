@@ -510,7 +510,7 @@ class BuiltInOp<HWFamily, EBuiltInOps::CopyBufferToImage3d> : public BuiltinDisp
         auto dstImage = castToObjectOrAbort<Image>(operationParams.dstMemObj);
 
         // Redescribe image to be byte-copy
-        auto dstImageRedescribed = dstImage->redescribe();
+        auto dstImageRedescribed = dstImage->getRedescribedView();
         multiDispatchInfo.pushRedescribedMemObj(std::unique_ptr<MemObj>(dstImageRedescribed)); // life range same as mdi's
 
         // Calculate srcRowPitch and srcSlicePitch
@@ -596,7 +596,7 @@ class BuiltInOp<HWFamily, EBuiltInOps::CopyImage3dToBuffer> : public BuiltinDisp
         auto srcImage = castToObjectOrAbort<Image>(operationParams.srcMemObj);
 
         // Redescribe image to be byte-copy
-        auto srcImageRedescribed = srcImage->redescribe();
+        auto srcImageRedescribed = srcImage->getRedescribedView();
         multiDispatchInfo.pushRedescribedMemObj(std::unique_ptr<MemObj>(srcImageRedescribed)); // life range same as mdi's
 
         // Calculate dstRowPitch and dstSlicePitch
@@ -679,8 +679,8 @@ class BuiltInOp<HWFamily, EBuiltInOps::CopyImageToImage3d> : public BuiltinDispa
         auto dstImage = castToObjectOrAbort<Image>(operationParams.dstMemObj);
 
         // Redescribe images to be byte-copies
-        auto srcImageRedescribed = srcImage->redescribe();
-        auto dstImageRedescribed = dstImage->redescribe();
+        auto srcImageRedescribed = srcImage->getRedescribedView();
+        auto dstImageRedescribed = dstImage->getRedescribedView();
         multiDispatchInfo.pushRedescribedMemObj(std::unique_ptr<MemObj>(srcImageRedescribed)); // life range same as mdi's
         multiDispatchInfo.pushRedescribedMemObj(std::unique_ptr<MemObj>(dstImageRedescribed)); // life range same as mdi's
 
@@ -743,7 +743,7 @@ class BuiltInOp<HWFamily, EBuiltInOps::FillImage3d> : public BuiltinDispatchInfo
         auto image = castToObjectOrAbort<Image>(operationParams.dstMemObj);
 
         // Redescribe image to be byte-copy
-        auto imageRedescribed = image->redescribeFillImage();
+        auto imageRedescribed = image->getRedescribedFillView();
         multiDispatchInfo.pushRedescribedMemObj(std::unique_ptr<MemObj>(imageRedescribed));
 
         // Set-up kernel
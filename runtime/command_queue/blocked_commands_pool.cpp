@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_queue/blocked_commands_pool.h"
+#include "runtime/helpers/aligned_memory.h"
+#include "runtime/memory_manager/memory_constants.h"
+
+namespace OCLRT {
+const uint32_t BlockedCommandsPool::numSizeClasses;
+const size_t BlockedCommandsPool::maxCachedBuffersPerClass;
+const size_t BlockedCommandsPool::defaultMaxCachedBytes;
+
+BlockedCommandsPool::~BlockedCommandsPool() {
+    for (auto &sizeClass : cachedBuffers) {
+        for (auto buffer : sizeClass) {
+            alignedFree(buffer);
+        }
+        sizeClass.clear();
+    }
+}
+
+uint32_t BlockedCommandsPool::getSizeClass(size_t size) {
+    uint32_t sizeClass = 0;
+    while (getClassSize(sizeClass) < size) {
+        sizeClass++;
+    }
+    return sizeClass;
+}
+
+size_t BlockedCommandsPool::getClassSize(uint32_t sizeClass) {
+    return MemoryConstants::pageSize << sizeClass;
+}
+
+void *BlockedCommandsPool::obtain(size_t size, size_t &obtainedSize) {
+    auto sizeClass = getSizeClass(size);
+    if (sizeClass >= numSizeClasses) {
+        obtainedSize = alignUp(size, MemoryConstants::pageSize);
+        std::unique_lock<std::mutex> lock(mtx);
+        systemAllocationsCount++;
+        lock.unlock();
+        return alignedMalloc(obtainedSize, MemoryConstants::pageSize);
+    }
+
+    obtainedSize = getClassSize(sizeClass);
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        auto &freeBuffers = cachedBuffers[sizeClass];
+        if (!freeBuffers.empty()) {
+            auto buffer = freeBuffers.back();
+            freeBuffers.pop_back();
+            cachedBytes -= obtainedSize;
+            return buffer;
+        }
+        systemAllocationsCount++;
+    }
+    return alignedMalloc(obtainedSize, MemoryConstants::pageSize);
+}
+
+void BlockedCommandsPool::release(void *buffer, size_t size) {
+    if (buffer == nullptr) {
+        return;
+    }
+    auto sizeClass = getSizeClass(size);
+    if (sizeClass >= numSizeClasses || getClassSize(sizeClass) != size || size > maxCachedBytes) {
+        alignedFree(buffer);
+        return;
+    }
+
+    std::vector<void *> buffersToFree;
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        auto &freeBuffers = cachedBuffers[sizeClass];
+        if (freeBuffers.size() >= maxCachedBuffersPerClass) {
+            buffersToFree.push_back(buffer);
+        } else {
+            freeBuffers.push_back(buffer);
+            cachedBytes += size;
+            for (auto evictedClass = numSizeClasses; cachedBytes > maxCachedBytes && evictedClass-- > 0;) {
+                auto &evictedBuffers = cachedBuffers[evictedClass];
+                while (!evictedBuffers.empty() && cachedBytes > maxCachedBytes) {
+                    buffersToFree.push_back(evictedBuffers.back());
+                    evictedBuffers.pop_back();
+                    cachedBytes -= getClassSize(evictedClass);
+                }
+            }
+        }
+    }
+    for (auto bufferToFree : buffersToFree) {
+        alignedFree(bufferToFree);
+    }
+}
+
+size_t BlockedCommandsPool::peekCachedBytes() {
+    std::unique_lock<std::mutex> lock(mtx);
+    return cachedBytes;
+}
+
+size_t BlockedCommandsPool::peekCachedBuffersCount() {
+    std::unique_lock<std::mutex> lock(mtx);
+    size_t count = 0;
+    for (auto &sizeClass : cachedBuffers) {
+        count += sizeClass.size();
+    }
+    return count;
+}
+} // namespace OCLRT
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace OCLRT {
+
+// Recycles CPU buffers backing command streams and indirect heaps of blocked enqueues.
+// Buffers are grouped in power-of-two page classes, a released buffer is handed out again
+// for the next blocked enqueue instead of going back to the system allocator.
+// Cached bytes are capped, the largest cached buffers are freed first when over budget.
+class BlockedCommandsPool {
+  public:
+    static const uint32_t numSizeClasses = 12;
+    static const size_t maxCachedBuffersPerClass = 16;
+    static const size_t defaultMaxCachedBytes = 32 * 1024 * 1024;
+
+    explicit BlockedCommandsPool(size_t maxCachedBytes = defaultMaxCachedBytes) : maxCachedBytes(maxCachedBytes) {}
+    ~BlockedCommandsPool();
+
+    BlockedCommandsPool(const BlockedCommandsPool &) = delete;
+    BlockedCommandsPool &operator=(const BlockedCommandsPool &) = delete;
+
+    // size is rounded up to the size class, returned buffer may be used up to obtainedSize
+    void *obtain(size_t size, size_t &obtainedSize);
+    void release(void *buffer, size_t size);
+
+    size_t peekCachedBuffersCount();
+    size_t peekCachedBytes();
+    uint64_t peekSystemAllocationsCount() const { return systemAllocationsCount; }
+
+  protected:
+    static uint32_t getSizeClass(size_t size);
+    static size_t getClassSize(uint32_t sizeClass);
+
+    std::mutex mtx;
+    std::vector<void *> cachedBuffers[numSizeClasses];
+    size_t cachedBytes = 0;
+    const size_t maxCachedBytes;
+    uint64_t systemAllocationsCount = 0;
+};
+} // namespace OCLRT
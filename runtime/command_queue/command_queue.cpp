@@ -23,6 +23,7 @@
 #include "runtime/command_queue/command_queue.h"
 #include "runtime/command_queue/command_queue_hw.h"
 #include "runtime/command_stream/command_stream_receiver.h"
+#include "runtime/command_stream/command_stream_ring.h"
 #include "runtime/context/context.h"
 #include "runtime/device/device.h"
 #include "runtime/device_queue/device_queue.h"
@@ -41,6 +42,7 @@
 #include "runtime/helpers/string.h"
 #include "CL/cl_ext.h"
 #include "runtime/utilities/api_intercept.h"
+#include "runtime/utilities/binary_tracer.h"
 #include "runtime/helpers/convert_color.h"
 #include "runtime/helpers/queue_helpers.h"
 #include <map>
@@ -102,6 +104,11 @@ CommandQueue::~CommandQueue() {
         auto memoryManager = device->getMemoryManager();
         DEBUG_BREAK_IF(nullptr == memoryManager);
 
+        if (commandStreamRing) {
+            //ring passes its segments to reusable list
+            commandStreamRing.reset();
+            commandStream->replaceGraphicsAllocation(nullptr);
+        }
         if (commandStream && commandStream->getGraphicsAllocation()) {
             memoryManager->storeAllocation(std::unique_ptr<GraphicsAllocation>(commandStream->getGraphicsAllocation()), REUSABLE_ALLOCATION);
             commandStream->replaceGraphicsAllocation(nullptr);
@@ -153,6 +160,7 @@ bool CommandQueue::isCompleted(uint32_t taskCount) const {
 
 void CommandQueue::waitUntilComplete(uint32_t taskCountToWait, FlushStamp flushStampToWait) {
     WAIT_ENTER()
+    TraceScope traceWait(TraceCategory::Wait, "waitUntilComplete", taskCountToWait);
 
     DBG_LOG(LogTaskCounts, __FUNCTION__, "Waiting for taskCount:", taskCountToWait);
     DBG_LOG(LogTaskCounts, __FUNCTION__, "Line: ", __LINE__, "Current taskCount:", getHwTag());
@@ -198,6 +206,33 @@ bool CommandQueue::isQueueBlocked() {
     return false;
 }
 
+void CommandQueue::waitWhileQueueBlocked() {
+    while (true) {
+        Event *blockingEvent = nullptr;
+        uint64_t observedStatusChangeCount = 0;
+        {
+            TakeOwnershipWrapper<CommandQueue> takeOwnershipWrapper(*this);
+            if (this->virtualEvent) {
+                blockingEvent = this->virtualEvent;
+                blockingEvent->incRefInternal();
+                observedStatusChangeCount = blockingEvent->peekStatusChangeCount();
+            }
+        }
+
+        bool blocked = isQueueBlocked();
+        // queue may be blocked by virtual event replaced in the meantime, completed one will not signal anymore
+        if (blocked && blockingEvent && blockingEvent->peekExecutionStatus() > CL_COMPLETE) {
+            blockingEvent->waitForStatusChange(observedStatusChangeCount);
+        }
+        if (blockingEvent) {
+            blockingEvent->decRefInternal();
+        }
+        if (!blocked) {
+            return;
+        }
+    }
+}
+
 cl_int CommandQueue::getCommandQueueInfo(cl_command_queue_info paramName,
                                          size_t paramValueSize,
                                          void *paramValue,
@@ -228,6 +263,11 @@ IndirectHeap &CommandQueue::getIndirectHeap(IndirectHeap::Type heapType,
     GraphicsAllocation *heapMemory = nullptr;
 
     DEBUG_BREAK_IF(nullptr == device);
+    auto &commandStreamReceiver = device->getCommandStreamReceiver();
+    if (commandStreamReceiver.isSharedIndirectHeapsEnabled()) {
+        return commandStreamReceiver.getIndirectHeap(heapType, minRequiredSize);
+    }
+
     auto memoryManager = device->getMemoryManager();
     DEBUG_BREAK_IF(nullptr == memoryManager);
 
@@ -254,7 +294,7 @@ IndirectHeap &CommandQueue::getIndirectHeap(IndirectHeap::Type heapType,
         heapMemory = memoryManager->obtainReusableAllocation(finalHeapSize).release();
 
         if (!heapMemory) {
-            heapMemory = memoryManager->allocateGraphicsMemory(finalHeapSize, MemoryConstants::pageSize);
+            heapMemory = memoryManager->allocateDriverInternalGraphicsMemory(finalHeapSize, MemoryConstants::pageSize);
         } else {
             finalHeapSize = std::max(heapMemory->getUnderlyingBufferSize(), finalHeapSize);
         }
@@ -286,6 +326,12 @@ void CommandQueue::releaseIndirectHeap(IndirectHeap::Type heapType) {
     auto &heap = indirectHeap[heapType];
 
     DEBUG_BREAK_IF(nullptr == device);
+    auto &commandStreamReceiver = device->getCommandStreamReceiver();
+    if (commandStreamReceiver.isSharedIndirectHeapsEnabled()) {
+        commandStreamReceiver.releaseIndirectHeap(heapType);
+        return;
+    }
+
     auto memoryManager = device->getMemoryManager();
     DEBUG_BREAK_IF(nullptr == memoryManager);
 
@@ -312,6 +358,14 @@ LinearStream &CommandQueue::getCS(size_t minRequiredSize) {
     minRequiredSize += CSRequirements::minCommandQueueCommandStreamSize;
 
     if (commandStream->getAvailableSpace() < minRequiredSize) {
+        if (commandStreamReceiver.isCommandStreamRingEnabled()) {
+            if (!commandStreamRing) {
+                commandStreamRing.reset(new CommandStreamRing(*memoryManager));
+            }
+            commandStreamReceiver.moveToNextCommandStreamSegment(*commandStream, *commandStreamRing, minRequiredSize, CSRequirements::minCommandQueueCommandStreamSize);
+            return *commandStream;
+        }
+
         // If not, allocate a new block. allocate full pages
         minRequiredSize = alignUp(minRequiredSize, MemoryConstants::pageSize);
 
@@ -320,7 +374,7 @@ LinearStream &CommandQueue::getCS(size_t minRequiredSize) {
         GraphicsAllocation *allocation = memoryManager->obtainReusableAllocation(requiredSize).release();
 
         if (!allocation) {
-            allocation = memoryManager->allocateGraphicsMemory(requiredSize, MemoryConstants::pageSize);
+            allocation = memoryManager->allocateDriverInternalGraphicsMemory(requiredSize, MemoryConstants::pageSize);
         }
 
         // Deallocate the old block, if not null
@@ -403,12 +457,9 @@ void CommandQueue::flushWaitList(
     const cl_event *eventWaitList,
     bool ndRangeKernel) {
 
-    bool isQBlocked = false;
-
     //as long as queue is blocked we need to stall.
     if (!isOOQEnabled()) {
-        while ((isQBlocked = isQueueBlocked()))
-            ;
+        waitWhileQueueBlocked();
     }
     device->getCommandStreamReceiver().flushBatchedSubmissions();
 }
@@ -22,6 +22,7 @@
 
 #pragma once
 #include "runtime/api/cl_types.h"
+#include "runtime/command_queue/blocked_commands_pool.h"
 #include "runtime/indirect_heap/indirect_heap.h"
 #include "runtime/helpers/base_object.h"
 #include "runtime/helpers/properties_helper.h"
@@ -32,6 +33,7 @@
 
 namespace OCLRT {
 class Buffer;
+class CommandStreamRing;
 class LinearStream;
 class Context;
 class Device;
@@ -318,6 +320,9 @@ class CommandQueue : public BaseObject<_cl_command_queue> {
 
     MOCKABLE_VIRTUAL bool isQueueBlocked();
 
+    // sleeps on virtual event instead of spinning while queue is blocked by user event
+    void waitWhileQueueBlocked();
+
     void waitUntilComplete(uint32_t taskCountToWait, FlushStamp flushStampToWait);
 
     void flushWaitList(cl_uint numEventsInWaitList,
@@ -403,6 +408,10 @@ class CommandQueue : public BaseObject<_cl_command_queue> {
     // virtual event that holds last Enqueue information
     Event *virtualEvent;
 
+    BlockedCommandsPool &getBlockedCommandsPool() {
+        return blockedCommandsPool;
+    }
+
   protected:
     void *enqueueReadMemObjForMap(TransferProperties &transferProperties, EventsRequest &eventsRequest, cl_int &errcodeRet);
     cl_int enqueueWriteMemObjForUnmap(MemObj *memObj, void *mappedPtr, EventsRequest &eventsRequest);
@@ -428,11 +437,14 @@ class CommandQueue : public BaseObject<_cl_command_queue> {
     bool perfCountersRegsCfgPending;
 
     LinearStream *commandStream;
+    std::unique_ptr<CommandStreamRing> commandStreamRing;
     IndirectHeap *indirectHeap[NUM_HEAPS];
 
     bool mapDcFlushRequired = false;
     bool isSpecialCommandQueue = false;
 
+    BlockedCommandsPool blockedCommandsPool;
+
   private:
     void providePerformanceHint(TransferProperties &transferProperties);
 };
@@ -25,6 +25,7 @@
 #include "runtime/context/context.h"
 #include "runtime/event/event_builder.h"
 #include "runtime/helpers/get_info.h"
+#include "runtime/helpers/rect_copy.h"
 #include "runtime/mem_obj/buffer.h"
 #include "runtime/mem_obj/image.h"
 
@@ -142,6 +143,19 @@ void *CommandQueue::cpuDataTransferHandler(TransferProperties &transferPropertie
             memcpy_s(ptrOffset(transferProperties.memObj->getCpuAddressForMemoryTransfer(), transferProperties.offset[0]), transferProperties.size[0], transferProperties.ptr, transferProperties.size[0]);
             eventCompleted = true;
             break;
+        case CL_COMMAND_READ_BUFFER_RECT:
+        case CL_COMMAND_COPY_BUFFER_RECT:
+            copyRect(transferProperties.ptr, transferProperties.hostOffset.data(), transferProperties.hostRowPitch, transferProperties.hostSlicePitch,
+                     transferProperties.memObj->getCpuAddressForMemoryTransfer(), transferProperties.offset.data(), transferProperties.rowPitch, transferProperties.slicePitch,
+                     transferProperties.size.data());
+            eventCompleted = true;
+            break;
+        case CL_COMMAND_WRITE_BUFFER_RECT:
+            copyRect(transferProperties.memObj->getCpuAddressForMemoryTransfer(), transferProperties.offset.data(), transferProperties.rowPitch, transferProperties.slicePitch,
+                     transferProperties.ptr, transferProperties.hostOffset.data(), transferProperties.hostRowPitch, transferProperties.hostSlicePitch,
+                     transferProperties.size.data());
+            eventCompleted = true;
+            break;
         case CL_COMMAND_MARKER:
             break;
         default:
@@ -139,10 +139,11 @@ inline cl_uint computeDimensions(const size_t workItems[3]) {
 void provideLocalWorkGroupSizeHints(Context *context, uint32_t maxWorkGroupSize, DispatchInfo dispatchInfo);
 
 template <typename SizeAndAllocCalcT, typename... CalcArgsT>
-IndirectHeap *allocateIndirectHeap(SizeAndAllocCalcT &&calc, CalcArgsT &&... args) {
-    size_t alignment = MemoryConstants::pageSize;
+IndirectHeap *allocateIndirectHeap(BlockedCommandsPool &pool, SizeAndAllocCalcT &&calc, CalcArgsT &&... args) {
     size_t size = calc(std::forward<CalcArgsT>(args)...);
-    return new IndirectHeap(alignedMalloc(size, alignment), size);
+    size_t obtainedSize = 0;
+    auto buffer = pool.obtain(size, obtainedSize);
+    return new IndirectHeap(buffer, obtainedSize);
 }
 
 template <typename GfxFamily>
@@ -441,6 +442,34 @@ void dispatchWalker(
     OCLRT::IndirectHeap *dsh = nullptr, *ish = nullptr, *ioh = nullptr, *ssh = nullptr;
     bool executionModelKernel = multiDispatchInfo.begin()->getKernel()->isParentKernel;
 
+    // Single dispatches of regular kernels replay geometry dependent state recorded for identical previous enqueue
+    DispatchTemplate *dispatchTemplate = nullptr;
+    bool recordDispatchTemplate = false;
+    if (DebugManager.flags.EnableDispatchTemplates.get() && !executionModelKernel && multiDispatchInfo.size() == 1) {
+        auto &dispatchInfo = *multiDispatchInfo.begin();
+        DispatchTemplateKey key;
+        key.dim = dispatchInfo.getDim();
+        key.gws = dispatchInfo.getGWS();
+        key.lws = dispatchInfo.getLocalWorkgroupSize();
+        key.offset = dispatchInfo.getOffset();
+        key.startOfWorkgroups = dispatchInfo.getStartOfWorkgroups();
+        key.numberOfWorkgroups = dispatchInfo.getNumberOfWorkgroups();
+        key.slmTotalSize = dispatchInfo.getKernel()->slmTotalSize;
+
+        auto &dispatchTemplates = dispatchInfo.getKernel()->getDispatchTemplates();
+        dispatchTemplate = dispatchTemplates.find(key);
+        if (dispatchTemplate) {
+            const_cast<DispatchInfo &>(dispatchInfo).setLWS(dispatchTemplate->getLocalWorkgroupSize());
+        } else {
+            if (dispatchInfo.getLocalWorkgroupSize().x == 0) {
+                const auto lws = generateWorkgroupSize(dispatchInfo);
+                const_cast<DispatchInfo &>(dispatchInfo).setLWS(lws);
+            }
+            dispatchTemplate = &dispatchTemplates.obtain(key, dispatchInfo.getLocalWorkgroupSize());
+            recordDispatchTemplate = true;
+        }
+    }
+
     for (auto &dispatchInfo : multiDispatchInfo) {
         // Compute local workgroup sizes
         if (dispatchInfo.getLocalWorkgroupSize().x == 0) {
@@ -453,31 +482,36 @@ void dispatchWalker(
     size_t cmdQInstructionHeapReservedBlockSize = 0;
     if (blockQueue) {
         using KCH = KernelCommandsHelper<GfxFamily>;
-        commandStream = new LinearStream(alignedMalloc(MemoryConstants::pageSize, MemoryConstants::pageSize), MemoryConstants::pageSize);
+        auto &pool = commandQueue.getBlockedCommandsPool();
+        size_t commandStreamSize = 0;
+        auto commandStreamBuffer = pool.obtain(MemoryConstants::pageSize, commandStreamSize);
+        commandStream = new LinearStream(commandStreamBuffer, commandStreamSize);
         if (executionModelKernel) {
             uint32_t offsetDsh = commandQueue.getContext().getDefaultDeviceQueue()->getDshOffset();
             uint32_t colorCalcSize = commandQueue.getContext().getDefaultDeviceQueue()->colorCalcStateSize;
 
-            dsh = allocateIndirectHeap([&multiDispatchInfo, offsetDsh] { return KCH::getTotalSizeRequiredDSH(multiDispatchInfo) + KCH::getTotalSizeRequiredIOH(multiDispatchInfo) + offsetDsh; });
+            dsh = allocateIndirectHeap(pool, [&multiDispatchInfo, offsetDsh] { return KCH::getTotalSizeRequiredDSH(multiDispatchInfo) + KCH::getTotalSizeRequiredIOH(multiDispatchInfo) + offsetDsh; });
             dsh->getSpace(colorCalcSize);
             ioh = dsh;
         } else {
-            dsh = allocateIndirectHeap([&multiDispatchInfo] { return KCH::getTotalSizeRequiredDSH(multiDispatchInfo); });
-            ioh = allocateIndirectHeap([&multiDispatchInfo] { return KCH::getTotalSizeRequiredIOH(multiDispatchInfo); });
+            dsh = allocateIndirectHeap(pool, [&multiDispatchInfo] { return KCH::getTotalSizeRequiredDSH(multiDispatchInfo); });
+            ioh = allocateIndirectHeap(pool, [&multiDispatchInfo] { return KCH::getTotalSizeRequiredIOH(multiDispatchInfo); });
         }
-        ish = allocateIndirectHeap([&multiDispatchInfo] { return KCH::getTotalSizeRequiredIH(multiDispatchInfo); });
+        ish = allocateIndirectHeap(pool, [&multiDispatchInfo] { return KCH::getTotalSizeRequiredIH(multiDispatchInfo); });
         cmdQInstructionHeapReservedBlockSize = commandQueue.getInstructionHeapReservedBlockSize();
 
-        ssh = allocateIndirectHeap([&multiDispatchInfo] { return KCH::getTotalSizeRequiredSSH(multiDispatchInfo); });
+        ssh = allocateIndirectHeap(pool, [&multiDispatchInfo] { return KCH::getTotalSizeRequiredSSH(multiDispatchInfo); });
         using UniqueIH = std::unique_ptr<IndirectHeap>;
         *blockedCommandsData = new KernelOperation(std::unique_ptr<LinearStream>(commandStream), UniqueIH(dsh),
                                                    UniqueIH(ish), UniqueIH(ioh), UniqueIH(ssh));
+        (*blockedCommandsData)->storagePool = &pool;
         if (executionModelKernel) {
             (*blockedCommandsData)->doNotFreeISH = true;
         }
     } else {
         commandStream = &commandQueue.getCS(0);
-        if (executionModelKernel && (commandQueue.getIndirectHeap(IndirectHeap::SURFACE_STATE, 0).getUsed() > 0)) {
+        bool sharedIndirectHeaps = commandQueue.getDevice().getCommandStreamReceiver().isSharedIndirectHeapsEnabled();
+        if (executionModelKernel && !sharedIndirectHeaps && (commandQueue.getIndirectHeap(IndirectHeap::SURFACE_STATE, 0).getUsed() > 0)) {
             commandQueue.releaseIndirectHeap(IndirectHeap::SURFACE_STATE);
         }
         dsh = &getIndirectHeap<GfxFamily, IndirectHeap::DYNAMIC_STATE>(commandQueue, multiDispatchInfo);
@@ -588,7 +622,8 @@ void dispatchWalker(
             localWorkSizes,
             offsetInterfaceDescriptorTable,
             interfaceDescriptorIndex,
-            preemptionMode);
+            preemptionMode,
+            dispatchTemplate);
 
         if (&dispatchInfo == &*multiDispatchInfo.begin()) {
             // If hwTimeStampAlloc is passed (not nullptr), then we know that profiling is enabled
@@ -608,30 +643,39 @@ void dispatchWalker(
         // Program the walker.  Invokes execution so all state should already be programmed
         typedef typename GfxFamily::GPGPU_WALKER GPGPU_WALKER;
         auto pGpGpuWalkerCmd = (GPGPU_WALKER *)commandStream->getSpace(sizeof(GPGPU_WALKER));
-        *pGpGpuWalkerCmd = GfxFamily::cmdInitGpgpuWalker;
+        if (dispatchTemplate && !recordDispatchTemplate) {
+            dispatchTemplate->replayWalker(pGpGpuWalkerCmd, sizeof(GPGPU_WALKER));
+        } else {
+            *pGpGpuWalkerCmd = GfxFamily::cmdInitGpgpuWalker;
 
-        size_t globalOffsets[3] = {offset.x, offset.y, offset.z};
-        size_t startWorkGroups[3] = {swgs.x, swgs.y, swgs.z};
-        size_t numWorkGroups[3] = {nwgs.x, nwgs.y, nwgs.z};
-        auto localWorkSize = setGpgpuWalkerThreadData<GfxFamily>(pGpGpuWalkerCmd, globalOffsets, startWorkGroups, numWorkGroups, localWorkSizes, simd);
+            size_t globalOffsets[3] = {offset.x, offset.y, offset.z};
+            size_t startWorkGroups[3] = {swgs.x, swgs.y, swgs.z};
+            size_t numWorkGroups[3] = {nwgs.x, nwgs.y, nwgs.z};
+            auto localWorkSize = setGpgpuWalkerThreadData<GfxFamily>(pGpGpuWalkerCmd, globalOffsets, startWorkGroups, numWorkGroups, localWorkSizes, simd);
 
-        pGpGpuWalkerCmd->setIndirectDataStartAddress((uint32_t)offsetCrossThreadData);
-        DEBUG_BREAK_IF(offsetCrossThreadData % 64 != 0);
-        pGpGpuWalkerCmd->setInterfaceDescriptorOffset(interfaceDescriptorIndex++);
+            auto threadPayload = kernel.getKernelInfo().patchInfo.threadPayload;
+            DEBUG_BREAK_IF(nullptr == threadPayload);
 
-        auto threadPayload = kernel.getKernelInfo().patchInfo.threadPayload;
-        DEBUG_BREAK_IF(nullptr == threadPayload);
+            auto numChannels = PerThreadDataHelper::getNumLocalIdChannels(*threadPayload);
+            auto localIdSizePerThread = PerThreadDataHelper::getLocalIdSizePerThread(simd, numChannels);
+            localIdSizePerThread = std::max(localIdSizePerThread, sizeof(GRF));
 
-        auto numChannels = PerThreadDataHelper::getNumLocalIdChannels(*threadPayload);
-        auto localIdSizePerThread = PerThreadDataHelper::getLocalIdSizePerThread(simd, numChannels);
-        localIdSizePerThread = std::max(localIdSizePerThread, sizeof(GRF));
+            auto sizePerThreadDataTotal = getThreadsPerWG(simd, localWorkSize) * localIdSizePerThread;
+            DEBUG_BREAK_IF(sizePerThreadDataTotal == 0); // Hardware requires at least 1 GRF of perThreadData for each thread in thread group
 
-        auto sizePerThreadDataTotal = getThreadsPerWG(simd, localWorkSize) * localIdSizePerThread;
-        DEBUG_BREAK_IF(sizePerThreadDataTotal == 0); // Hardware requires at least 1 GRF of perThreadData for each thread in thread group
+            auto sizeCrossThreadData = kernel.getCrossThreadDataSize();
+            auto IndirectDataLength = alignUp((uint32_t)(sizeCrossThreadData + sizePerThreadDataTotal), GPGPU_WALKER::INDIRECTDATASTARTADDRESS_ALIGN_SIZE);
+            pGpGpuWalkerCmd->setIndirectDataLength(IndirectDataLength);
+        }
 
-        auto sizeCrossThreadData = kernel.getCrossThreadDataSize();
-        auto IndirectDataLength = alignUp((uint32_t)(sizeCrossThreadData + sizePerThreadDataTotal), GPGPU_WALKER::INDIRECTDATASTARTADDRESS_ALIGN_SIZE);
-        pGpGpuWalkerCmd->setIndirectDataLength(IndirectDataLength);
+        // relocate heap offsets, the only walker fields that differ between identical dispatches
+        pGpGpuWalkerCmd->setIndirectDataStartAddress((uint32_t)offsetCrossThreadData);
+        DEBUG_BREAK_IF(offsetCrossThreadData % 64 != 0);
+        pGpGpuWalkerCmd->setInterfaceDescriptorOffset(interfaceDescriptorIndex++);
+
+        if (recordDispatchTemplate) {
+            dispatchTemplate->recordWalker(pGpGpuWalkerCmd, sizeof(GPGPU_WALKER));
+        }
 
         // Implement disabling special WA DisableLSQCROPERFforOCL if needed
         applyWADisableLSQCROPERFforOCL<GfxFamily>(commandStream, kernel, false);
@@ -41,6 +41,7 @@
 #include "runtime/program/printf_handler.h"
 #include "runtime/program/block_kernel_manager.h"
 #include "runtime/utilities/range.h"
+#include <algorithm>
 #include <new>
 #include <memory>
 
@@ -249,7 +250,11 @@ void CommandQueueHw<GfxFamily>::enqueueHandler(Surface **surfacesForResidency,
             blockQueue,
             commandType);
 
-        commandStreamReceiver.setRequiredScratchSize(multiDispatchInfo.getRequiredScratchSize());
+        if (blockQueue) {
+            blockedCommandsData->requiredScratchSize = multiDispatchInfo.getRequiredScratchSize();
+        } else {
+            commandStreamReceiver.setRequiredScratchSize(multiDispatchInfo.getRequiredScratchSize());
+        }
 
         slmUsed = multiDispatchInfo.usesSlm();
     }
@@ -402,8 +407,7 @@ void CommandQueueHw<GfxFamily>::enqueueHandler(Surface **surfacesForResidency,
 
     if (blocking) {
         if (blockQueue) {
-            while (isQueueBlocked())
-                ;
+            waitWhileQueueBlocked();
             waitUntilComplete(taskCount, flushStamp->peekStamp());
         } else {
             waitUntilComplete(taskCount, flushStamp->peekStamp());
@@ -412,7 +416,7 @@ void CommandQueueHw<GfxFamily>::enqueueHandler(Surface **surfacesForResidency,
                 (*sIt)->setCompletionStamp(completionStamp, nullptr, nullptr);
             }
             if (printfHandler) {
-                printfHandler->printEnqueueOutput();
+                PrintfHandler::flushEnqueueOutput(std::move(printfHandler));
             }
             commandStreamReceiver.waitForTaskCountAndCleanAllocationList(taskCount, TEMPORARY_ALLOCATION);
         }
@@ -551,6 +555,24 @@ CompletionStamp CommandQueueHw<GfxFamily>::enqueueNonBlocked(
     dispatchFlags.preemptionMode = PreemptionHelper::taskPreemptionMode(*device, multiDispatchInfo);
     dispatchFlags.outOfOrderExecutionAllowed = !eventBuilder.getEvent() || this->isOOQEnabled();
 
+    std::vector<GraphicsAllocation *> readOnlyAllocations;
+    if (commandStreamReceiver.isResourceDependencyTrackingEnabled()) {
+        std::vector<GraphicsAllocation *> writtenAllocations;
+        kernel = nullptr;
+        for (auto &dispatchInfo : multiDispatchInfo) {
+            if (kernel != dispatchInfo.getKernel()) {
+                kernel = dispatchInfo.getKernel();
+                kernel->getAllocationsAccess(readOnlyAllocations, writtenAllocations);
+            }
+        }
+        //allocation written by any kernel of the dispatch is not read only
+        readOnlyAllocations.erase(std::remove_if(readOnlyAllocations.begin(), readOnlyAllocations.end(), [&writtenAllocations](GraphicsAllocation *allocation) {
+                                      return std::find(writtenAllocations.begin(), writtenAllocations.end(), allocation) != writtenAllocations.end();
+                                  }),
+                                  readOnlyAllocations.end());
+        dispatchFlags.readOnlyAllocations = &readOnlyAllocations;
+    }
+
     DEBUG_BREAK_IF(taskLevel >= Event::eventNotReady);
 
     gtpinNotifyPreFlushTask(this);
@@ -48,6 +48,22 @@ cl_int CommandQueueHw<GfxFamily>::enqueueCopyBufferRect(
 
     MultiDispatchInfo dispatchInfo;
 
+    // Nothing to overlap with on an idle queue, so small copies between zero-copy buffers are done on the CPU in place.
+    // A queue blocked on user events is not idle - its pending commands have not been submitted yet.
+    auto dstStorage = dstBuffer->getCpuAddressForMemoryTransfer();
+    auto copySize = region[0] * region[1] * region[2];
+    if (copySize != 0 && srcBuffer->isMemObjZeroCopy() && dstBuffer->isMemObjZeroCopy() && !isQueueBlocked() && isCompleted(taskCount) &&
+        srcBuffer->isReadWriteOnCpuAllowed(CL_TRUE, numEventsInWaitList, dstStorage, copySize) &&
+        dstBuffer->isReadWriteOnCpuAllowed(CL_TRUE, numEventsInWaitList, dstStorage, copySize) &&
+        context->getDevice(0)->getDeviceInfo().cpuCopyAllowed) {
+        cl_int retVal = CL_SUCCESS;
+        TransferProperties transferProperties(srcBuffer, CL_COMMAND_COPY_BUFFER_RECT, true, srcOrigin, dstOrigin, region,
+                                              srcRowPitch, srcSlicePitch, dstRowPitch, dstSlicePitch, dstStorage);
+        EventsRequest eventsRequest(numEventsInWaitList, eventWaitList, event);
+        cpuDataTransferHandler(transferProperties, eventsRequest, retVal);
+        return retVal;
+    }
+
     auto &builder = BuiltIns::getInstance().getBuiltinDispatchInfoBuilder(EBuiltInOps::CopyBufferRect,
                                                                           this->getContext(), this->getDevice());
     builder.takeOwnership(this->context);
@@ -27,7 +27,10 @@
 #include "runtime/command_queue/dispatch_walker.h"
 #include "runtime/device/device.h"
 #include "runtime/event/event.h"
+#include "runtime/mem_obj/buffer.h"
+#include "runtime/memory_manager/memory_manager.h"
 #include "runtime/memory_manager/surface.h"
+#include "runtime/utilities/stackvec.h"
 
 namespace OCLRT {
 
@@ -50,20 +53,63 @@ cl_int CommandQueueHw<GfxFamily>::enqueueMigrateMemObjects(cl_uint numMemObjects
                                                            cl_uint numEventsInWaitList,
                                                            const cl_event *eventWaitList,
                                                            cl_event *event) {
-    NullSurface s;
-    Surface *surfaces[] = {&s};
-    cl_uint dimensions = 1;
+    StackVec<cl_event, 16> markerWaitList(eventWaitList, eventWaitList + numEventsInWaitList);
+    cl_int retVal = CL_SUCCESS;
 
-    enqueueHandler<CL_COMMAND_MIGRATE_MEM_OBJECTS>(surfaces,
-                                                   false,
-                                                   nullptr,
-                                                   dimensions,
-                                                   nullptr,
-                                                   nullptr,
-                                                   nullptr,
-                                                   numEventsInWaitList,
-                                                   eventWaitList,
-                                                   event);
-    return CL_SUCCESS;
+    if (flags & CL_MIGRATE_MEM_OBJECT_HOST) {
+        // host pointer of non zero copy buffer is refreshed with device content, unless app does not need it
+        // only CL_MEM_USE_HOST_PTR buffers own their host pointer, CL_MEM_COPY_HOST_PTR one may already be freed
+        if ((flags & CL_MIGRATE_MEM_OBJECT_CONTENT_UNDEFINED) == 0) {
+            for (cl_uint i = 0; i < numMemObjects; i++) {
+                auto buffer = castToObject<Buffer>(memObjects[i]);
+                if (buffer == nullptr || (buffer->getFlags() & CL_MEM_USE_HOST_PTR) == 0 || buffer->isMemObjZeroCopy() || buffer->getHostPtr() == nullptr) {
+                    continue;
+                }
+                cl_event readEvent = nullptr;
+                retVal = enqueueReadBuffer(buffer, CL_FALSE, 0, buffer->getSize(), buffer->getHostPtr(),
+                                           numEventsInWaitList, eventWaitList, &readEvent);
+                if (retVal != CL_SUCCESS) {
+                    break;
+                }
+                markerWaitList.push_back(readEvent);
+            }
+        }
+    } else {
+        ResidencyContainer allocationsToPrefetch;
+        for (cl_uint i = 0; i < numMemObjects; i++) {
+            auto memObj = castToObject<MemObj>(memObjects[i]);
+            if (memObj == nullptr) {
+                continue;
+            }
+            allocationsToPrefetch.push_back(memObj->getGraphicsAllocation());
+            if (memObj->getMcsAllocation()) {
+                allocationsToPrefetch.push_back(memObj->getMcsAllocation());
+            }
+        }
+        TakeOwnershipWrapper<Device> deviceOwnership(*device);
+        device->getMemoryManager()->prefetchAllocations(allocationsToPrefetch);
+    }
+
+    if (retVal == CL_SUCCESS) {
+        NullSurface s;
+        Surface *surfaces[] = {&s};
+        cl_uint dimensions = 1;
+
+        enqueueHandler<CL_COMMAND_MIGRATE_MEM_OBJECTS>(surfaces,
+                                                       false,
+                                                       nullptr,
+                                                       dimensions,
+                                                       nullptr,
+                                                       nullptr,
+                                                       nullptr,
+                                                       static_cast<cl_uint>(markerWaitList.size()),
+                                                       markerWaitList.size() ? markerWaitList.begin() : nullptr,
+                                                       event);
+    }
+
+    for (auto it = markerWaitList.begin() + numEventsInWaitList; it != markerWaitList.end(); ++it) {
+        castToObjectOrAbort<Event>(*it)->release();
+    }
+    return retVal;
 }
 } // namespace OCLRT
@@ -77,11 +77,30 @@ cl_int CommandQueueHw<GfxFamily>::enqueueReadBufferRect(
 
         return CL_SUCCESS;
     }
+
+    size_t hostPtrSize = Buffer::calculateHostPtrSize(hostOrigin, region, hostRowPitch, hostSlicePitch);
+    auto transferSize = region[0] * region[1] * region[2];
+    if (transferSize != 0 && buffer->isReadWriteOnCpuAllowed(blockingRead, numEventsInWaitList, ptr, transferSize) &&
+        context->getDevice(0)->getDeviceInfo().cpuCopyAllowed) {
+        cl_int retVal = CL_SUCCESS;
+        TransferProperties transferProperties(buffer, CL_COMMAND_READ_BUFFER_RECT, true, bufferOrigin, hostOrigin, region,
+                                              bufferRowPitch, bufferSlicePitch, hostRowPitch, hostSlicePitch, ptr);
+        EventsRequest eventsRequest(numEventsInWaitList, eventWaitList, event);
+        cpuDataTransferHandler(transferProperties, eventsRequest, retVal);
+
+        if (context->isProvidingPerformanceHints()) {
+            context->providePerformanceHint(CL_CONTEXT_DIAGNOSTICS_LEVEL_BAD_INTEL, CL_ENQUEUE_READ_BUFFER_RECT_REQUIRES_COPY_DATA, static_cast<cl_mem>(buffer), ptr);
+            if (!isL3Capable(ptr, hostPtrSize)) {
+                context->providePerformanceHint(CL_CONTEXT_DIAGNOSTICS_LEVEL_BAD_INTEL, CL_ENQUEUE_READ_BUFFER_RECT_DOESNT_MEET_ALIGNMENT_RESTRICTIONS, ptr, hostPtrSize, MemoryConstants::pageSize, MemoryConstants::pageSize);
+            }
+        }
+        return retVal;
+    }
+
     auto &builder = BuiltIns::getInstance().getBuiltinDispatchInfoBuilder(EBuiltInOps::CopyBufferRect,
                                                                           this->getContext(), this->getDevice());
     builder.takeOwnership(this->context);
 
-    size_t hostPtrSize = Buffer::calculateHostPtrSize(hostOrigin, region, hostRowPitch, hostSlicePitch);
     void *dstPtr = ptr;
 
     MemObjSurface bufferSurf(buffer);
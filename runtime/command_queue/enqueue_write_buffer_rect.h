@@ -76,12 +76,28 @@ cl_int CommandQueueHw<GfxFamily>::enqueueWriteBufferRect(
 
         return CL_SUCCESS;
     }
+
+    void *srcPtr = const_cast<void *>(ptr);
+    auto transferSize = region[0] * region[1] * region[2];
+    if (transferSize != 0 && buffer->isReadWriteOnCpuAllowed(blockingWrite, numEventsInWaitList, srcPtr, transferSize) &&
+        context->getDevice(0)->getDeviceInfo().cpuCopyAllowed) {
+        cl_int retVal = CL_SUCCESS;
+        TransferProperties transferProperties(buffer, CL_COMMAND_WRITE_BUFFER_RECT, true, bufferOrigin, hostOrigin, region,
+                                              bufferRowPitch, bufferSlicePitch, hostRowPitch, hostSlicePitch, srcPtr);
+        EventsRequest eventsRequest(numEventsInWaitList, eventWaitList, event);
+        cpuDataTransferHandler(transferProperties, eventsRequest, retVal);
+
+        if (context->isProvidingPerformanceHints()) {
+            context->providePerformanceHint(CL_CONTEXT_DIAGNOSTICS_LEVEL_NEUTRAL_INTEL, CL_ENQUEUE_WRITE_BUFFER_RECT_REQUIRES_COPY_DATA, static_cast<cl_mem>(buffer));
+        }
+        return retVal;
+    }
+
     auto &builder = BuiltIns::getInstance().getBuiltinDispatchInfoBuilder(EBuiltInOps::CopyBufferRect,
                                                                           this->getContext(), this->getDevice());
     builder.takeOwnership(this->context);
 
     size_t hostPtrSize = Buffer::calculateHostPtrSize(hostOrigin, region, hostRowPitch, hostSlicePitch);
-    void *srcPtr = const_cast<void *>(ptr);
 
     MemObjSurface dstBufferSurf(buffer);
     HostPtrSurface hostPtrSurf(srcPtr, hostPtrSize, true);
@@ -34,8 +34,7 @@ cl_int CommandQueueHw<GfxFamily>::finish(bool dcFlush) {
     commandStreamReceiver.flushBatchedSubmissions();
 
     //as long as queue is blocked we need to stall.
-    while (isQueueBlocked())
-        ;
+    waitWhileQueueBlocked();
 
     auto taskCountToWaitFor = this->taskCount;
     auto flushStampToWaitFor = this->flushStamp->peekStamp();
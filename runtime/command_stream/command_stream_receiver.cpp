@@ -22,15 +22,19 @@
 
 #include "runtime/built_ins/built_ins.h"
 #include "runtime/command_stream/command_stream_receiver.h"
+#include "runtime/command_stream/command_stream_ring.h"
 #include "runtime/command_stream/preemption.h"
 #include "runtime/device/device.h"
 #include "runtime/gtpin/gtpin_notify.h"
 #include "runtime/memory_manager/memory_manager.h"
+#include "runtime/helpers/basic_math.h"
 #include "runtime/helpers/cache_policy.h"
 #include "runtime/os_interface/os_interface.h"
 #include "runtime/event/event.h"
 #include "runtime/event/event_builder.h"
 
+#include <algorithm>
+
 namespace OCLRT {
 // Global table of CommandStreamReceiver factories for HW and tests
 CommandStreamReceiverCreateFunc commandStreamReceiverFactory[2 * IGFX_MAX_CORE] = {};
@@ -41,6 +45,12 @@ CommandStreamReceiver::CommandStreamReceiver() {
     if (DebugManager.flags.CsrDispatchMode.get()) {
         this->dispatchMode = (DispatchMode)DebugManager.flags.CsrDispatchMode.get();
     }
+    pipeControlEliminationEnabled = DebugManager.flags.EnableBatchedPipeControlElimination.get();
+    resourceDependencyTrackingEnabled = DebugManager.flags.EnableResourceDependencyTracking.get();
+    commandStreamRingEnabled = DebugManager.flags.EnableCommandStreamRing.get();
+    sharedIndirectHeapsEnabled = DebugManager.flags.EnableSharedIndirectHeaps.get();
+    scratchSpaceManagementEnabled = DebugManager.flags.EnableScratchSpaceManagement.get();
+    scratchSpaceShrinkPeriod = static_cast<uint32_t>(std::max(DebugManager.flags.ScratchSpaceShrinkPeriod.get(), 0));
     flushStamp.reset(new FlushStampTracker(true));
 }
 
@@ -60,6 +70,40 @@ void CommandStreamReceiver::makeResident(GraphicsAllocation &gfxAllocation) {
     gfxAllocation.residencyTaskCount = submissionTaskCount;
 }
 
+bool CommandStreamReceiver::resolveTaskDependencies(uint32_t taskLevel, const DispatchFlags &dispatchFlags) {
+    auto dependsOnPreviousTasks = taskLevel > this->taskLevel;
+    if (!resourceDependencyTrackingEnabled) {
+        return dependsOnPreviousTasks;
+    }
+
+    auto &allocations = getMemoryManager()->getResidencyAllocations();
+    auto isWritten = [&dispatchFlags](GraphicsAllocation *allocation) {
+        auto readOnlyAllocations = dispatchFlags.readOnlyAllocations;
+        return !readOnlyAllocations || std::find(readOnlyAllocations->begin(), readOnlyAllocations->end(), allocation) == readOnlyAllocations->end();
+    };
+
+    auto isCsrOwned = [this](GraphicsAllocation *allocation) {
+        return allocation == tagAllocation || allocation == preemptionCsrAllocation;
+    };
+
+    uint32_t hazardTaskCount = 0;
+    for (auto &allocation : allocations) {
+        if (!isCsrOwned(allocation)) {
+            hazardTaskCount = std::max(hazardTaskCount, allocation->getHazardTaskCount(isWritten(allocation)));
+        }
+    }
+
+    auto submissionTaskCount = this->taskCount + 1;
+    for (auto &allocation : allocations) {
+        if (!isCsrOwned(allocation)) {
+            allocation->updateAccessTaskCount(submissionTaskCount, isWritten(allocation));
+        }
+    }
+
+    //task may only skip the stall if none of its allocations is hazarded by a task not yet covered by a stall
+    return dependsOnPreviousTasks && hazardTaskCount > lastStalledTaskCount;
+}
+
 void CommandStreamReceiver::processEviction() {
     getMemoryManager()->clearEvictionAllocations();
 }
@@ -134,6 +178,15 @@ LinearStream &CommandStreamReceiver::getCS(size_t minRequiredSize) {
         // Currently reserving 64bytes (cacheline) which should be more than enough.
         static const size_t sizeForSubmission = MemoryConstants::cacheLineSize;
         minRequiredSize += sizeForSubmission;
+
+        if (commandStreamRingEnabled) {
+            if (!commandStreamRing) {
+                commandStreamRing.reset(new CommandStreamRing(*memoryManager));
+            }
+            moveToNextCommandStreamSegment(commandStream, *commandStreamRing, minRequiredSize, sizeForSubmission);
+            return commandStream;
+        }
+
         // If not, allocate a new block. allocate full pages
         minRequiredSize = alignUp(minRequiredSize, MemoryConstants::pageSize);
 
@@ -141,7 +194,7 @@ LinearStream &CommandStreamReceiver::getCS(size_t minRequiredSize) {
 
         auto allocation = memoryManager->obtainReusableAllocation(requiredSize).release();
         if (!allocation) {
-            allocation = memoryManager->allocateGraphicsMemory(requiredSize, MemoryConstants::pageSize);
+            allocation = memoryManager->allocateDriverInternalGraphicsMemory(requiredSize, MemoryConstants::pageSize);
         }
 
         //pass current allocation to reusable list
@@ -156,18 +209,154 @@ LinearStream &CommandStreamReceiver::getCS(size_t minRequiredSize) {
     return commandStream;
 }
 
+IndirectHeap &CommandStreamReceiver::getIndirectHeap(IndirectHeap::Type heapType, size_t minRequiredSize) {
+    DEBUG_BREAK_IF(static_cast<uint32_t>(heapType) >= IndirectHeap::NUM_TYPES);
+    auto &heap = sharedHeaps[heapType];
+    GraphicsAllocation *heapMemory = nullptr;
+
+    auto memoryManager = this->getMemoryManager();
+    DEBUG_BREAK_IF(nullptr == memoryManager);
+
+    if (heap)
+        heapMemory = heap->getGraphicsAllocation();
+
+    if (heap && heap->getAvailableSpace() < minRequiredSize && heapMemory) {
+        //every task that used this heap is already assigned current task count
+        memoryManager->storeAllocation(std::unique_ptr<GraphicsAllocation>(heapMemory), REUSABLE_ALLOCATION);
+        heapMemory = nullptr;
+    }
+
+    if (!heapMemory) {
+        size_t reservedSize = 0;
+        auto finalHeapSize = sharedIndirectHeapSize;
+        if (heapType == IndirectHeap::INSTRUCTION) {
+            reservedSize = alignUp(getInstructionHeapCmdStreamReceiverReservedSize(), MemoryConstants::cacheLineSize);
+        } else if (heapType == IndirectHeap::SURFACE_STATE) {
+            finalHeapSize = defaultHeapSize;
+        }
+
+        minRequiredSize += reservedSize;
+
+        finalHeapSize = alignUp(std::max(finalHeapSize, minRequiredSize), MemoryConstants::pageSize);
+
+        heapMemory = memoryManager->obtainReusableAllocation(finalHeapSize).release();
+
+        if (!heapMemory) {
+            heapMemory = memoryManager->allocateDriverInternalGraphicsMemory(finalHeapSize, MemoryConstants::pageSize);
+        } else {
+            finalHeapSize = std::max(heapMemory->getUnderlyingBufferSize(), finalHeapSize);
+        }
+
+        if (IndirectHeap::SURFACE_STATE == heapType) {
+            DEBUG_BREAK_IF(minRequiredSize > maxSshSize);
+            finalHeapSize = maxSshSize;
+        }
+
+        if (heap) {
+            heap->replaceBuffer(heapMemory->getUnderlyingBuffer(), finalHeapSize);
+            heap->replaceGraphicsAllocation(heapMemory);
+        } else {
+            heap.reset(new IndirectHeap(heapMemory));
+            heap->overrideMaxSize(finalHeapSize);
+        }
+
+        if (heapType == IndirectHeap::INSTRUCTION) {
+            initializeInstructionHeapCmdStreamReceiverReservedBlock(*heap);
+            heap->align(MemoryConstants::cacheLineSize);
+        }
+    }
+
+    return *heap;
+}
+
+void CommandStreamReceiver::releaseIndirectHeap(IndirectHeap::Type heapType) {
+    DEBUG_BREAK_IF(static_cast<uint32_t>(heapType) >= IndirectHeap::NUM_TYPES);
+    auto &heap = sharedHeaps[heapType];
+
+    auto memoryManager = this->getMemoryManager();
+    DEBUG_BREAK_IF(nullptr == memoryManager);
+
+    if (heap) {
+        auto heapMemory = heap->getGraphicsAllocation();
+        if (heapMemory != nullptr)
+            memoryManager->storeAllocation(std::unique_ptr<GraphicsAllocation>(heapMemory), REUSABLE_ALLOCATION);
+        heap->replaceBuffer(nullptr, 0);
+        heap->replaceGraphicsAllocation(nullptr);
+    }
+}
+
+std::unique_ptr<IndirectHeap> CommandStreamReceiver::obtainIndirectHeapRange(IndirectHeap::Type heapType, size_t minRequiredSize) {
+    size_t reservedSize = 0;
+    if (heapType == IndirectHeap::INSTRUCTION) {
+        reservedSize = alignUp(getInstructionHeapCmdStreamReceiverReservedSize(), MemoryConstants::cacheLineSize);
+    }
+    auto rangeSize = alignUp(minRequiredSize + reservedSize, MemoryConstants::pageSize);
+
+    //state base addresses are page aligned, reserve space for aligning the range start
+    auto &heap = getIndirectHeap(heapType, rangeSize + MemoryConstants::pageSize);
+    heap.align(MemoryConstants::pageSize);
+
+    std::unique_ptr<IndirectHeap> range(new IndirectHeap(heap.getSpace(rangeSize), rangeSize));
+    range->replaceGraphicsAllocation(heap.getGraphicsAllocation());
+
+    if (heapType == IndirectHeap::INSTRUCTION) {
+        initializeInstructionHeapCmdStreamReceiverReservedBlock(*range);
+        range->align(MemoryConstants::cacheLineSize);
+    }
+    return range;
+}
+
+void CommandStreamReceiver::moveToNextCommandStreamSegment(LinearStream &commandStream, CommandStreamRing &ring, size_t minRequiredSize, size_t reservedTailSize) {
+    auto currentSegment = commandStream.getGraphicsAllocation();
+    if (currentSegment) {
+        //all commands in current segment belong to already submitted tasks
+        currentSegment->taskCount = this->taskCount;
+    }
+
+    auto segment = ring.obtainSegment(minRequiredSize, getTagAddress());
+
+    if (currentSegment && !ring.isSegment(currentSegment)) {
+        getMemoryManager()->storeAllocation(std::unique_ptr<GraphicsAllocation>(currentSegment), REUSABLE_ALLOCATION);
+    }
+
+    commandStream.replaceBuffer(segment->getUnderlyingBuffer(), segment->getUnderlyingBufferSize() - CSRequirements::csOverfetchSize - reservedTailSize);
+    commandStream.replaceGraphicsAllocation(segment);
+}
+
 void CommandStreamReceiver::cleanupResources() {
     auto memoryManager = this->getMemoryManager();
     if (!memoryManager)
         return;
 
+    if (commandStreamRing) {
+        //ring passes its segments to reusable list
+        commandStreamRing.reset();
+        commandStream.replaceGraphicsAllocation(nullptr);
+        commandStream.replaceBuffer(nullptr, 0);
+    }
+
+    for (int i = 0; i < IndirectHeap::NUM_TYPES; ++i) {
+        if (sharedHeaps[i]) {
+            releaseIndirectHeap(static_cast<IndirectHeap::Type>(i));
+            sharedHeaps[i].reset();
+        }
+    }
+
     waitForTaskCountAndCleanAllocationList(this->latestFlushedTaskCount, TEMPORARY_ALLOCATION);
     waitForTaskCountAndCleanAllocationList(this->latestFlushedTaskCount, REUSABLE_ALLOCATION);
 
+    auto scratchSpacePool = memoryManager->peekScratchSpacePool();
     if (scratchAllocation) {
-        memoryManager->freeGraphicsMemory(scratchAllocation);
+        if (scratchSpacePool) {
+            scratchSpacePool->retire(scratchAllocation, 0, nullptr);
+        } else {
+            memoryManager->freeGraphicsMemory(scratchAllocation);
+        }
         scratchAllocation = nullptr;
     }
+    if (scratchSpacePool) {
+        scratchSpacePool->releaseTagAddress(tagAddress);
+    }
 
     if (commandStream.getCpuBase()) {
         memoryManager->freeGraphicsMemory(commandStream.getGraphicsAllocation());
@@ -208,6 +397,45 @@ void CommandStreamReceiver::setRequiredScratchSize(uint32_t newRequiredScratchSi
     if (newRequiredScratchSize > requiredScratchSize) {
         requiredScratchSize = newRequiredScratchSize;
     }
+    if (newRequiredScratchSize > taskRequiredScratchSize) {
+        taskRequiredScratchSize = newRequiredScratchSize;
+    }
+}
+
+bool CommandStreamReceiver::shrinkScratchSpaceIfIdle() {
+    scratchShrinkWindowMaxSize = std::max(scratchShrinkWindowMaxSize, taskRequiredScratchSize);
+    taskRequiredScratchSize = 0;
+    if (scratchSpaceShrinkPeriod == 0 || ++scratchShrinkWindowTaskCount < scratchSpaceShrinkPeriod) {
+        return false;
+    }
+    auto windowMaxSize = scratchShrinkWindowMaxSize;
+    scratchShrinkWindowMaxSize = 0;
+    scratchShrinkWindowTaskCount = 0;
+
+    // shrink only across a whole size class, smaller drops would just bounce between two allocations
+    if (!scratchAllocation || (windowMaxSize && Math::nextPowerOfTwo(windowMaxSize) >= Math::nextPowerOfTwo(requiredScratchSize))) {
+        return false;
+    }
+    requiredScratchSize = windowMaxSize;
+    retireScratchAllocation();
+    return true;
+}
+
+GraphicsAllocation *CommandStreamReceiver::obtainScratchAllocation(size_t requiredSizeInBytes) {
+    if (scratchSpaceManagementEnabled) {
+        return getMemoryManager()->getScratchSpacePool()->obtain(requiredSizeInBytes);
+    }
+    return getMemoryManager()->createGraphicsAllocationWithRequiredBitness(requiredSizeInBytes, nullptr);
+}
+
+void CommandStreamReceiver::retireScratchAllocation() {
+    if (scratchSpaceManagementEnabled) {
+        getMemoryManager()->getScratchSpacePool()->retire(scratchAllocation, this->taskCount, getTagAddress());
+    } else {
+        scratchAllocation->taskCount = this->taskCount;
+        getMemoryManager()->storeAllocation(std::unique_ptr<GraphicsAllocation>(scratchAllocation), TEMPORARY_ALLOCATION);
+    }
+    scratchAllocation = nullptr;
 }
 
 size_t CommandStreamReceiver::getInstructionHeapCmdStreamReceiverReservedSize() const {
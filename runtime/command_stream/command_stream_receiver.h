@@ -27,10 +27,12 @@
 #include "runtime/helpers/completion_stamp.h"
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/command_stream/csr_definitions.h"
+#include "runtime/indirect_heap/indirect_heap.h"
 #include <cstddef>
 #include <cstdint>
 
 namespace OCLRT {
+class CommandStreamRing;
 class Device;
 class EventBuilder;
 class LinearStream;
@@ -83,6 +85,13 @@ class CommandStreamReceiver {
     void waitForTaskCountAndCleanAllocationList(uint32_t requiredTaskCount, uint32_t allocationType);
 
     LinearStream &getCS(size_t minRequiredSize = 1024u);
+    // heaps shared by all queues of the device, see EnableSharedIndirectHeaps
+    IndirectHeap &getIndirectHeap(IndirectHeap::Type heapType, size_t minRequiredSize);
+    void releaseIndirectHeap(IndirectHeap::Type heapType);
+    // page aligned range of shared heap addressed from its own base, for commands recorded before their heap offsets were known
+    std::unique_ptr<IndirectHeap> obtainIndirectHeapRange(IndirectHeap::Type heapType, size_t minRequiredSize);
+    // moves command stream to next ring segment, minRequiredSize includes reservedTailSize
+    void moveToNextCommandStreamSegment(LinearStream &commandStream, CommandStreamRing &ring, size_t minRequiredSize, size_t reservedTailSize);
     OSInterface *getOSInterface() { return osInterface.get(); };
 
     MOCKABLE_VIRTUAL void setTagAllocation(GraphicsAllocation *allocation);
@@ -100,10 +109,28 @@ class CommandStreamReceiver {
 
     void overrideDispatchPolicy(CommandStreamReceiver::DispatchMode overrideValue) { this->dispatchMode = overrideValue; }
 
+    void overridePipeControlElimination(bool enabled) { this->pipeControlEliminationEnabled = enabled; }
+
+    void overrideResourceDependencyTracking(bool enabled) { this->resourceDependencyTrackingEnabled = enabled; }
+    bool isResourceDependencyTrackingEnabled() const { return resourceDependencyTrackingEnabled; }
+    uint32_t peekLastStalledTaskCount() const { return lastStalledTaskCount; }
+
+    void overrideCommandStreamRing(bool enabled) { this->commandStreamRingEnabled = enabled; }
+    bool isCommandStreamRingEnabled() const { return commandStreamRingEnabled; }
+    CommandStreamRing *peekCommandStreamRing() const { return commandStreamRing.get(); }
+
+    void overrideSharedIndirectHeaps(bool enabled) { this->sharedIndirectHeapsEnabled = enabled; }
+    bool isSharedIndirectHeapsEnabled() const { return sharedIndirectHeapsEnabled; }
+
     virtual void overrideMediaVFEStateDirty(bool dirty) { mediaVfeStateDirty = dirty; }
 
     void setRequiredScratchSize(uint32_t newRequiredScratchSize);
     GraphicsAllocation *getScratchAllocation() { return scratchAllocation; }
+    uint32_t peekRequiredScratchSize() const { return requiredScratchSize; }
+
+    void overrideScratchSpaceManagement(bool enabled) { this->scratchSpaceManagementEnabled = enabled; }
+    bool isScratchSpaceManagementEnabled() const { return scratchSpaceManagementEnabled; }
+    void setScratchSpaceShrinkPeriod(uint32_t taskCount) { this->scratchSpaceShrinkPeriod = taskCount; }
 
     void setPreemptionCsrAllocation(GraphicsAllocation *allocation) { preemptionCsrAllocation = allocation; }
 
@@ -127,6 +154,14 @@ class CommandStreamReceiver {
         disableL3Cache = val;
     }
 
+    // decides if task needs a stall before its walkers and records its accesses in resident allocations
+    bool resolveTaskDependencies(uint32_t taskLevel, const DispatchFlags &dispatchFlags);
+
+    // closes the scratch usage window of a task, lowers requiredScratchSize when the window shows it is oversized
+    bool shrinkScratchSpaceIfIdle();
+    GraphicsAllocation *obtainScratchAllocation(size_t requiredSizeInBytes);
+    void retireScratchAllocation();
+
     // taskCount - # of tasks submitted
     uint32_t taskCount = 0;
     // current taskLevel.  Used for determining if a PIPE_CONTROL is needed.
@@ -152,6 +187,8 @@ class CommandStreamReceiver {
     uint32_t latestSentStatelessMocsConfig;
 
     LinearStream commandStream;
+    std::unique_ptr<CommandStreamRing> commandStreamRing;
+    std::unique_ptr<IndirectHeap> sharedHeaps[IndirectHeap::NUM_TYPES];
 
     uint32_t requiredThreadArbitrationPolicy = ThreadArbitrationPolicy::RoundRobin;
     uint32_t lastSentThreadArbitrationPolicy = ThreadArbitrationPolicy::NotPresent;
@@ -164,8 +201,19 @@ class CommandStreamReceiver {
     std::unique_ptr<SubmissionAggregator> submissionAggregator;
 
     DispatchMode dispatchMode = ImmediateDispatch;
+    bool pipeControlEliminationEnabled = false;
+    bool resourceDependencyTrackingEnabled = false;
+    // all tasks up to this task count are completed before walkers of the next task start
+    uint32_t lastStalledTaskCount = 0;
+    bool commandStreamRingEnabled = false;
+    bool sharedIndirectHeapsEnabled = false;
     bool disableL3Cache = false;
     uint32_t requiredScratchSize = 0;
+    bool scratchSpaceManagementEnabled = false;
+    uint32_t scratchSpaceShrinkPeriod = 0;
+    uint32_t taskRequiredScratchSize = 0;
+    uint32_t scratchShrinkWindowMaxSize = 0;
+    uint32_t scratchShrinkWindowTaskCount = 0;
     uint64_t totalMemoryUsed = 0u;
     SamplerCacheFlushState samplerCacheFlushRequired = SamplerCacheFlushState::samplerCacheFlushNotRequired;
 };
@@ -33,8 +33,11 @@
 #include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/command_stream/preemption.h"
 #include "runtime/command_queue/dispatch_walker.h"
+#include "runtime/utilities/binary_tracer.h"
 #include "command_stream_receiver_hw.h"
 
+#include <algorithm>
+
 namespace OCLRT {
 
 template <typename GfxFamily>
@@ -115,6 +118,7 @@ CompletionStamp CommandStreamReceiverHw<GfxFamily>::flushTask(
     typedef typename GfxFamily::MI_BATCH_BUFFER_END MI_BATCH_BUFFER_END;
     typedef typename GfxFamily::PIPE_CONTROL PIPE_CONTROL;
     typedef typename GfxFamily::STATE_BASE_ADDRESS STATE_BASE_ADDRESS;
+    TraceScope traceFlushTask(TraceCategory::Csr, "flushTask", taskLevel);
 
     DEBUG_BREAK_IF(&commandStreamTask == &commandStream);
     DEBUG_BREAK_IF(!(dispatchFlags.preemptionMode == PreemptionMode::Disabled ? getMemoryManager()->device->getPreemptionMode() == PreemptionMode::Disabled : true));
@@ -125,6 +129,7 @@ CompletionStamp CommandStreamReceiverHw<GfxFamily>::flushTask(
     auto levelClosed = false;
     void *currentPipeControlForNooping = nullptr;
     void *epiloguePipeControlLocation = nullptr;
+    void *dependencyPipeControlLocation = nullptr;
     Device *device = this->getMemoryManager()->device;
 
     if (dispatchFlags.blocking || dispatchFlags.dcFlush || dispatchFlags.guardCommandBufferWithPipeControl) {
@@ -198,18 +203,24 @@ CompletionStamp CommandStreamReceiverHw<GfxFamily>::flushTask(
     programPreamble(commandStreamCSR, dispatchFlags, newL3Config);
     programMediaSampler(commandStreamCSR, dispatchFlags);
 
-    size_t requiredScratchSizeInBytes = requiredScratchSize * (hwInfo.pSysInfo->MaxSubSlicesSupported * hwInfo.pSysInfo->MaxEuPerSubSlice * hwInfo.pSysInfo->ThreadCount / hwInfo.pSysInfo->EUCount);
-
     auto force32BitAllocations = getMemoryManager()->peekForce32BitAllocations();
 
     bool stateBaseAddressDirty = false;
 
+    if (scratchSpaceManagementEnabled && shrinkScratchSpaceIfIdle()) {
+        overrideMediaVFEStateDirty(true);
+        if (is64bit && !force32BitAllocations) {
+            stateBaseAddressDirty = true;
+        }
+    }
+
+    size_t requiredScratchSizeInBytes = requiredScratchSize * (hwInfo.pSysInfo->MaxSubSlicesSupported * hwInfo.pSysInfo->MaxEuPerSubSlice * hwInfo.pSysInfo->ThreadCount / hwInfo.pSysInfo->EUCount);
+
     if (requiredScratchSize && (!scratchAllocation || scratchAllocation->getUnderlyingBufferSize() < requiredScratchSizeInBytes)) {
         if (scratchAllocation) {
-            scratchAllocation->taskCount = this->taskCount;
-            getMemoryManager()->storeAllocation(std::unique_ptr<GraphicsAllocation>(scratchAllocation), TEMPORARY_ALLOCATION);
+            retireScratchAllocation();
         }
-        scratchAllocation = getMemoryManager()->createGraphicsAllocationWithRequiredBitness(requiredScratchSizeInBytes, nullptr);
+        scratchAllocation = obtainScratchAllocation(requiredScratchSizeInBytes);
         overrideMediaVFEStateDirty(true);
         if (is64bit && !force32BitAllocations) {
             stateBaseAddressDirty = true;
@@ -282,8 +293,12 @@ CompletionStamp CommandStreamReceiverHw<GfxFamily>::flushTask(
         }
     }
     // Add a PC if we have a dependency on a previous walker to avoid concurrency issues.
-    if (taskLevel > this->taskLevel) {
+    if (resolveTaskDependencies(taskLevel, dispatchFlags)) {
+        dependencyPipeControlLocation = ptrOffset(commandStreamCSR.getCpuBase(), commandStreamCSR.getUsed());
         addPipeControl(commandStreamCSR, false);
+        this->lastStalledTaskCount = this->taskCount;
+    }
+    if (taskLevel > this->taskLevel) {
         this->taskLevel = taskLevel;
         DBG_LOG(LogTaskCounts, __FUNCTION__, "Line: ", __LINE__, "this->taskCount", this->taskCount);
     }
@@ -365,6 +380,17 @@ CompletionStamp CommandStreamReceiverHw<GfxFamily>::flushTask(
             commandBuffer->flushStamp->replaceStampObject(dispatchFlags.flushStampReference);
             commandBuffer->pipeControlThatMayBeErasedLocation = currentPipeControlForNooping;
             commandBuffer->epiloguePipeControlLocation = epiloguePipeControlLocation;
+            commandBuffer->epilogueDcFlush = epiloguePipeControlLocation && dispatchFlags.dcFlush;
+            if (this->pipeControlEliminationEnabled) {
+                commandBuffer->dependencyPipeControlLocation = dependencyPipeControlLocation;
+                GraphicsAllocation *csrOwnedAllocations[] = {dshAllocation, ihAllocation, iohAllocation, sshAllocation, tagAllocation, preemptionCsrAllocation,
+                                                             commandStreamTask.getGraphicsAllocation(), commandStreamCSR.getGraphicsAllocation()};
+                for (auto &allocation : commandBuffer->surfaces) {
+                    if (std::find(std::begin(csrOwnedAllocations), std::end(csrOwnedAllocations), allocation) == std::end(csrOwnedAllocations)) {
+                        commandBuffer->trackedAllocations.push_back(allocation);
+                    }
+                }
+            }
             this->submissionAggregator->recordCommandBuffer(commandBuffer);
         }
     } else {
@@ -382,6 +408,11 @@ CompletionStamp CommandStreamReceiverHw<GfxFamily>::flushTask(
         this->flushBatchedSubmissions();
     }
 
+    if (epiloguePipeControlLocation && !currentPipeControlForNooping) {
+        //epilogue pipe control stalls until this task is completed
+        this->lastStalledTaskCount = taskCount + 1;
+    }
+
     ++taskCount;
     DBG_LOG(LogTaskCounts, __FUNCTION__, "Line: ", __LINE__, "taskCount", taskCount);
     DBG_LOG(LogTaskCounts, __FUNCTION__, "Line: ", __LINE__, "Current taskCount:", tagAddress ? *tagAddress : 0);
@@ -418,10 +449,14 @@ inline void CommandStreamReceiverHw<GfxFamily>::flushBatchedSubmissions() {
         auto pipeControlLocationSize = getRequiredPipeControlSize();
         void *currentPipeControlForNooping = nullptr;
         void *epiloguePipeControlLocation = nullptr;
+        bool epilogueDcFlush = false;
 
         while (!commandBufferList.peekIsEmpty()) {
             size_t totalUsedSize = 0u;
             this->submissionAggregator->aggregateCommandBuffers(resourcePackage, totalUsedSize, (size_t)device->getDeviceInfo().globalMemSize * 5 / 10);
+            if (this->pipeControlEliminationEnabled) {
+                this->submissionAggregator->analyzeDependencies(*commandBufferList.peekHead());
+            }
             auto primaryCmdBuffer = commandBufferList.removeFrontOne();
             auto nextCommandBuffer = commandBufferList.peekHead();
             auto currentBBendLocation = primaryCmdBuffer->batchBufferEndLocation;
@@ -432,16 +467,25 @@ inline void CommandStreamReceiverHw<GfxFamily>::flushBatchedSubmissions() {
 
             currentPipeControlForNooping = primaryCmdBuffer->pipeControlThatMayBeErasedLocation;
             epiloguePipeControlLocation = primaryCmdBuffer->epiloguePipeControlLocation;
+            epilogueDcFlush = primaryCmdBuffer->epilogueDcFlush;
 
             while (nextCommandBuffer && nextCommandBuffer->inspectionId == primaryCmdBuffer->inspectionId) {
                 //noop pipe control
                 if (currentPipeControlForNooping) {
                     memset(currentPipeControlForNooping, 0, pipeControlLocationSize);
+                } else if (epiloguePipeControlLocation && !epilogueDcFlush && !nextCommandBuffer->stallRequired && this->pipeControlEliminationEnabled) {
+                    //next command buffer does not touch allocations in flight, last epilogue still writes the tag
+                    //epilogues flushing DC are kept, the host may read their results as soon as their tag passes
+                    memset(epiloguePipeControlLocation, 0, pipeControlLocationSize);
+                }
+                if (nextCommandBuffer->dependencyPipeControlLocation && !nextCommandBuffer->stallRequired) {
+                    memset(nextCommandBuffer->dependencyPipeControlLocation, 0, pipeControlLocationSize);
                 }
                 //obtain next candidate for nooping
                 currentPipeControlForNooping = nextCommandBuffer->pipeControlThatMayBeErasedLocation;
                 //track epilogue pipe control
                 epiloguePipeControlLocation = nextCommandBuffer->epiloguePipeControlLocation;
+                epilogueDcFlush = nextCommandBuffer->epilogueDcFlush;
 
                 flushStampUpdateHelper.insert(nextCommandBuffer->flushStamp->getStampReference());
                 auto nextCommandBufferAddress = nextCommandBuffer->batchBuffer.commandBufferAllocation->getUnderlyingBuffer();
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_stream/command_stream_ring.h"
+#include "runtime/command_stream/csr_definitions.h"
+#include "runtime/helpers/aligned_memory.h"
+#include "runtime/memory_manager/memory_manager.h"
+
+#include <algorithm>
+
+namespace OCLRT {
+const size_t CommandStreamRing::defaultSegmentSize;
+
+CommandStreamRing::CommandStreamRing(MemoryManager &memoryManager, size_t segmentSize) : memoryManager(memoryManager),
+                                                                                           segmentSize(alignUp(segmentSize, MemoryConstants::pageSize)) {
+}
+
+CommandStreamRing::~CommandStreamRing() {
+    //segments may still be in use by GPU, release them through reusable list
+    for (auto &segment : segments) {
+        memoryManager.storeAllocation(std::unique_ptr<GraphicsAllocation>(segment), REUSABLE_ALLOCATION);
+    }
+    segments.clear();
+}
+
+GraphicsAllocation *CommandStreamRing::obtainSegment(size_t minRequiredSize, volatile uint32_t *tagAddress) {
+    auto requiredSize = std::max(segmentSize, alignUp(minRequiredSize, MemoryConstants::pageSize)) + CSRequirements::csOverfetchSize;
+
+    //last segment is the one currently used by command stream
+    if (segments.size() > 1) {
+        auto oldestSegment = segments.front();
+        if (oldestSegment->getUnderlyingBufferSize() >= requiredSize && isSegmentCompleted(*oldestSegment, tagAddress)) {
+            segments.pop_front();
+            segments.push_back(oldestSegment);
+            return oldestSegment;
+        }
+    }
+
+    auto segment = memoryManager.allocateDriverInternalGraphicsMemory(requiredSize, MemoryConstants::pageSize);
+    segments.push_back(segment);
+    return segment;
+}
+
+bool CommandStreamRing::isSegment(const GraphicsAllocation *allocation) const {
+    return std::find(segments.begin(), segments.end(), allocation) != segments.end();
+}
+
+bool CommandStreamRing::isSegmentCompleted(const GraphicsAllocation &segment, volatile uint32_t *tagAddress) const {
+    uint32_t currentTagValue = tagAddress ? *tagAddress : ObjectNotUsed;
+    return currentTagValue >= segment.taskCount;
+}
+} // namespace OCLRT
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include "runtime/memory_manager/memory_constants.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+namespace OCLRT {
+class GraphicsAllocation;
+class MemoryManager;
+
+// Fixed size command buffer segments reused in ring order once GPU completes the task that last used them.
+// Stream moves to the next segment only between tasks, every task is submitted from a single segment.
+class CommandStreamRing {
+  public:
+    static const size_t defaultSegmentSize = 64 * MemoryConstants::kiloByte;
+
+    CommandStreamRing(MemoryManager &memoryManager, size_t segmentSize = defaultSegmentSize);
+    ~CommandStreamRing();
+
+    // returns oldest segment if GPU is done with it, otherwise appends new segment to the ring
+    // taskCount of retired segment has to be set to the last task that used it
+    GraphicsAllocation *obtainSegment(size_t minRequiredSize, volatile uint32_t *tagAddress);
+
+    bool isSegment(const GraphicsAllocation *allocation) const;
+    size_t getSegmentCount() const { return segments.size(); }
+    size_t getSegmentSize() const { return segmentSize; }
+
+  protected:
+    bool isSegmentCompleted(const GraphicsAllocation &segment, volatile uint32_t *tagAddress) const;
+
+    MemoryManager &memoryManager;
+    size_t segmentSize;
+    std::deque<GraphicsAllocation *> segments;
+};
+} // namespace OCLRT
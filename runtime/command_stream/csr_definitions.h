@@ -25,9 +25,11 @@
 #include "runtime/helpers/hw_info.h"
 #include "runtime/helpers/properties_helper.h"
 #include <limits>
+#include <vector>
 
 namespace OCLRT {
 struct FlushStampTrackingObj;
+class GraphicsAllocation;
 
 namespace CSRequirements {
 //cleanup section usually contains 1-2 pipeControls BB end and place for BB start
@@ -57,6 +59,8 @@ struct DispatchFlags {
     bool outOfOrderExecutionAllowed = false;
     FlushStampTrackingObj *flushStampReference = nullptr;
     PreemptionMode preemptionMode = PreemptionMode::Disabled;
+    //allocations only read by the task, every other resident allocation is treated as written
+    const std::vector<GraphicsAllocation *> *readOnlyAllocations = nullptr;
 };
 
 struct CsrSizeRequestFlags {
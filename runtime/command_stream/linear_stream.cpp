@@ -24,13 +24,14 @@
 #include "runtime/memory_manager/graphics_allocation.h"
 
 namespace OCLRT {
+std::atomic<uint32_t> LinearStream::bufferGenerationCounter{0};
 
 LinearStream::LinearStream(void *buffer, size_t bufferSize)
-    : sizeUsed(0), maxAvailableSpace(bufferSize), buffer(buffer), graphicsAllocation(nullptr) {
+    : sizeUsed(0), maxAvailableSpace(bufferSize), buffer(buffer), graphicsAllocation(nullptr), bufferGeneration(++bufferGenerationCounter) {
 }
 
 LinearStream::LinearStream(GraphicsAllocation *gfxAllocation)
-    : sizeUsed(0), graphicsAllocation(gfxAllocation) {
+    : sizeUsed(0), graphicsAllocation(gfxAllocation), bufferGeneration(++bufferGenerationCounter) {
     if (gfxAllocation) {
         maxAvailableSpace = gfxAllocation->getUnderlyingBufferSize();
         buffer = gfxAllocation->getUnderlyingBuffer();
@@ -49,6 +49,8 @@ class LinearStream {
     void replaceBuffer(void *buffer, size_t bufferSize);
     GraphicsAllocation *getGraphicsAllocation() const;
     void replaceGraphicsAllocation(GraphicsAllocation *gfxAllocation);
+    // unique among all streams, changes whenever stream starts over in new buffer
+    uint32_t getBufferGeneration() const { return bufferGeneration; }
 
     template <typename Cmd>
     Cmd *getSpaceForCmd() {
@@ -61,6 +63,9 @@ class LinearStream {
     size_t maxAvailableSpace;
     void *buffer;
     GraphicsAllocation *graphicsAllocation;
+    uint32_t bufferGeneration;
+
+    static std::atomic<uint32_t> bufferGenerationCounter;
 };
 
 inline void *LinearStream::getCpuBase() const {
@@ -112,6 +117,7 @@ inline void LinearStream::replaceBuffer(void *buffer, size_t bufferSize) {
     this->buffer = buffer;
     maxAvailableSpace = bufferSize;
     sizeUsed = 0;
+    bufferGeneration = ++bufferGenerationCounter;
 }
 
 inline GraphicsAllocation *LinearStream::getGraphicsAllocation() const {
@@ -21,6 +21,7 @@
 */
 #include "submissions_aggregator.h"
 #include "runtime/helpers/flush_stamp.h"
+#include <unordered_set>
 
 void OCLRT::SubmissionAggregator::recordCommandBuffer(CommandBuffer *commandBuffer) {
     this->cmdBuffers.pushTailOne(*commandBuffer);
@@ -106,6 +107,35 @@ void OCLRT::SubmissionAggregator::aggregateCommandBuffers(ResourcePackage &resou
     }
 }
 
+void OCLRT::SubmissionAggregator::analyzeDependencies(CommandBuffer &primaryCommandBuffer) {
+    //csr does not know access direction, every tracked allocation is treated as written
+    std::unordered_set<GraphicsAllocation *> allocationsInFlight(primaryCommandBuffer.trackedAllocations.begin(), primaryCommandBuffer.trackedAllocations.end());
+    auto previousCommandBuffer = &primaryCommandBuffer;
+    auto commandBuffer = primaryCommandBuffer.next;
+
+    while (commandBuffer && commandBuffer->inspectionId == primaryCommandBuffer.inspectionId) {
+        bool separatedByStall = commandBuffer->dependencyPipeControlLocation ||
+                                (previousCommandBuffer->epiloguePipeControlLocation && !previousCommandBuffer->pipeControlThatMayBeErasedLocation);
+        bool conflict = false;
+        for (auto &allocation : commandBuffer->trackedAllocations) {
+            if (allocationsInFlight.find(allocation) != allocationsInFlight.end()) {
+                conflict = true;
+                break;
+            }
+        }
+
+        commandBuffer->stallRequired = separatedByStall && conflict;
+        if (commandBuffer->stallRequired) {
+            //everything before the stall is completed, start tracking from this command buffer
+            allocationsInFlight.clear();
+        }
+        allocationsInFlight.insert(commandBuffer->trackedAllocations.begin(), commandBuffer->trackedAllocations.end());
+
+        previousCommandBuffer = commandBuffer;
+        commandBuffer = commandBuffer->next;
+    }
+}
+
 OCLRT::BatchBuffer::BatchBuffer(GraphicsAllocation *commandBufferAllocation, size_t startOffset, size_t chainedBatchBufferStartOffset, GraphicsAllocation *chainedBatchBuffer, bool requiresCoherency, bool lowPriority, QueueThrottle throttle, size_t usedSize, LinearStream *stream) : commandBufferAllocation(commandBufferAllocation), startOffset(startOffset), chainedBatchBufferStartOffset(chainedBatchBufferStartOffset), chainedBatchBuffer(chainedBatchBuffer), requiresCoherency(requiresCoherency), low_priority(lowPriority), throttle(throttle), usedSize(usedSize), stream(stream) {
 }
 
@@ -63,6 +63,14 @@ struct CommandBuffer : public IDNode<CommandBuffer> {
     uint32_t taskCount = 0u;
     void *pipeControlThatMayBeErasedLocation = nullptr;
     void *epiloguePipeControlLocation = nullptr;
+    //epilogue flushes DC for this task, it may not be nooped even when no stall is required
+    bool epilogueDcFlush = false;
+    //stall emitted in csr stream when taskLevel of this command buffer was increased
+    void *dependencyPipeControlLocation = nullptr;
+    //allocations accessed by this command buffer, excluding csr owned heaps and streams
+    ResidencyContainer trackedAllocations;
+    //result of dependency analysis, false when stalls separating this buffer from preceding ones may be nooped
+    bool stallRequired = true;
     std::unique_ptr<FlushStampTracker> flushStamp;
 };
 
@@ -74,6 +82,7 @@ class SubmissionAggregator {
   public:
     void recordCommandBuffer(CommandBuffer *commandBuffer);
     void aggregateCommandBuffers(ResourcePackage &resourcePackage, size_t &totalUsedSize, size_t totalMemoryBudget);
+    void analyzeDependencies(CommandBuffer &primaryCommandBuffer);
     CommandBufferList &peekCmdBufferList() { return cmdBuffers; }
 
   protected:
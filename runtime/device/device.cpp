@@ -32,6 +32,8 @@
 #include "runtime/helpers/options.h"
 #include "runtime/memory_manager/memory_manager.h"
 #include "runtime/os_interface/os_time.h"
+#include "runtime/program/printf_output_worker.h"
+#include "runtime/program/printf_surface_pool.h"
 #include "runtime/device/driver_info.h"
 #include <cstring>
 #include <map>
@@ -76,7 +78,7 @@ Device::Device(const HardwareInfo &hwInfo,
                bool isRootDevice)
     : memoryManager(nullptr), enabledClVersion(false), hwInfo(hwInfo), isRoot(isRootDevice),
       commandStreamReceiver(nullptr), tagAddress(nullptr), tagAllocation(nullptr), preemptionAllocation(nullptr),
-      osTime(nullptr), slmWindowStartAddress(nullptr) {
+      osTime(nullptr), printfSurfacePool(new PrintfSurfacePool), printfOutputWorker(new PrintfOutputWorker), slmWindowStartAddress(nullptr) {
     memset(&deviceInfo, 0, sizeof(deviceInfo));
     deviceExtensions.reserve(1000);
     preemptionMode = PreemptionHelper::getDefaultPreemptionMode(hwInfo);
@@ -86,6 +88,8 @@ Device::Device(const HardwareInfo &hwInfo,
 }
 
 Device::~Device() {
+    //pending printf output still references device's surfaces and command stream receiver
+    printfOutputWorker.reset();
     BuiltIns::shutDown();
     CompilerInterface::shutdown();
     DEBUG_BREAK_IF(nullptr == memoryManager);
@@ -99,6 +103,7 @@ Device::~Device() {
     }
 
     if (memoryManager) {
+        printfSurfacePool->freeSurfaces(*memoryManager);
         if (preemptionAllocation) {
             memoryManager->freeGraphicsMemory(preemptionAllocation);
             preemptionAllocation = nullptr;
@@ -132,7 +137,7 @@ bool Device::createDeviceImpl(const HardwareInfo *pHwInfo,
 
     outDevice.memoryManager->csr = commandStreamReceiver;
 
-    auto pTagAllocation = outDevice.memoryManager->allocateGraphicsMemory(
+    auto pTagAllocation = outDevice.memoryManager->allocateDriverInternalGraphicsMemory(
         sizeof(uint32_t), sizeof(uint32_t));
     if (!pTagAllocation) {
         return false;
@@ -36,6 +36,8 @@ class GraphicsAllocation;
 class MemoryManager;
 class OSTime;
 class DriverInfo;
+class PrintfOutputWorker;
+class PrintfSurfacePool;
 struct HardwareInfo;
 
 template <>
@@ -133,6 +135,8 @@ class Device : public BaseObject<_cl_device_id> {
     std::vector<unsigned int> simultaneousInterops;
     std::string deviceExtensions;
     bool getEnabled64kbPages();
+    PrintfSurfacePool &getPrintfSurfacePool() { return *printfSurfacePool; }
+    PrintfOutputWorker &getPrintfOutputWorker() { return *printfOutputWorker; }
 
   protected:
     Device() = delete;
@@ -159,6 +163,8 @@ class Device : public BaseObject<_cl_device_id> {
     std::unique_ptr<OSTime> osTime;
     std::unique_ptr<DriverInfo> driverInfo;
     std::unique_ptr<PerformanceCounters> performanceCounters;
+    std::unique_ptr<PrintfSurfacePool> printfSurfacePool;
+    std::unique_ptr<PrintfOutputWorker> printfOutputWorker;
     uint64_t programCount = 0u;
 
     void *slmWindowStartAddress;
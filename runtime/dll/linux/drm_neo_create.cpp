@@ -205,6 +205,11 @@ Drm *Drm::create(int32_t deviceOrdinal) {
         return nullptr;
     }
 
+    int hasExecFence = 0;
+    if (drmObject->getExecFence(hasExecFence) == 0) {
+        drmObject->execFenceSupported = hasExecFence != 0;
+    }
+
     // Activate the Turbo Boost Frequency feature
     ret = drmObject->enableTurboBoost();
     if (ret != 0) {
@@ -36,6 +36,9 @@
 #include "runtime/utilities/tag_allocator.h"
 #include "runtime/platform/platform.h"
 #include "runtime/event/async_events_handler.h"
+#include "runtime/os_interface/os_time_correlation.h"
+
+#include <cmath>
 
 namespace OCLRT {
 
@@ -60,6 +63,8 @@ Event::Event(
       perfConfigurationData(nullptr),
       taskCount(taskCount) {
     parentCount = 0;
+    statusChangeCount = 0;
+    statusChangeWaiters = 0;
     executionStatus = CL_QUEUED;
     flushStamp.reset(new FlushStampTracker(true));
 
@@ -127,6 +132,12 @@ Event::~Event() {
         std::unique_ptr<Command> submittedCommand(submittedCmd.exchange(nullptr));
     }
 
+    // tags of a submitted task are handed back for reuse only after the GPU is done writing them
+    volatile uint32_t *completionTagAddress = nullptr;
+    if (cmdQueue != nullptr && taskCount != Event::eventNotReady) {
+        completionTagAddress = cmdQueue->getDevice().getCommandStreamReceiver().getTagAddress();
+    }
+
     if (cmdQueue != nullptr) {
         cmdQueue->decRefInternal();
     }
@@ -134,11 +145,11 @@ Event::~Event() {
     if (ctx != nullptr) {
         if (timeStampNode != nullptr) {
             TagAllocator<HwTimeStamps> *allocator = ctx->getDevice(0)->getMemoryManager()->getEventTsAllocator();
-            allocator->returnTag(timeStampNode);
+            allocator->returnTagWhenCompleted(timeStampNode, taskCount, completionTagAddress);
         }
         if (perfCounterNode != nullptr) {
             TagAllocator<HwPerfCounter> *allocator = ctx->getDevice(0)->getMemoryManager()->getEventPerfCountAllocator();
-            allocator->returnTag(perfCounterNode);
+            allocator->returnTagWhenCompleted(perfCounterNode, taskCount, completionTagAddress);
         }
         ctx->decRefInternal();
     }
@@ -260,6 +271,14 @@ bool Event::calcProfilingData() {
     int64_t c0 = 0;
     if (!dataCalculated && timeStampNode && !profilingCpuPath) {
         double frequency = cmdQueue->getDevice().getProfilingTimerResolution();
+        auto timeCorrelation = cmdQueue->getDevice().getOSTime()->getTimeCorrelation();
+        if (timeCorrelation && timeCorrelation->isCalibrated()) {
+            // queue and submit timestamps may be interpolated, convert GPU ticks with the same slope
+            auto calibratedFrequency = timeCorrelation->getGpuTimerResolution();
+            if (std::abs(calibratedFrequency - frequency) < frequency * CpuGpuTimeCorrelation::maxResolutionDeviation) {
+                frequency = calibratedFrequency;
+            }
+        }
         /* calculation based on equation
            CpuTime = GpuTime * scalar + const( == c0)
            scalar = DeltaCpu( == dCpu) / DeltaGpu( == dGpu)
@@ -289,10 +308,13 @@ bool Event::calcProfilingData() {
 }
 
 inline bool Event::wait(bool blocking) {
+    auto observedStatusChangeCount = peekStatusChangeCount();
     while (this->taskCount == Event::eventNotReady) {
         if (blocking == false) {
             return false;
         }
+        waitForStatusChange(observedStatusChangeCount);
+        observedStatusChangeCount = peekStatusChangeCount();
     }
 
     cmdQueue->waitUntilComplete(taskCount.load(), flushStamp->peekStamp());
@@ -420,11 +442,27 @@ bool Event::setStatus(cl_int status) {
     if (isStatusCompleted(&status) || (status == CL_SUBMITTED)) {
         unblockEventsBlockedByThis(status);
     }
+    signalStatusChange();
     executeCallbacks(status);
     this->decRefInternal();
     return true;
 }
 
+void Event::signalStatusChange() {
+    statusChangeCount++;
+    if (statusChangeWaiters > 0) {
+        std::lock_guard<std::mutex> lock(statusChangeMutex);
+        statusChangeCondition.notify_all();
+    }
+}
+
+void Event::waitForStatusChange(uint64_t observedStatusChangeCount) {
+    std::unique_lock<std::mutex> lock(statusChangeMutex);
+    statusChangeWaiters++;
+    statusChangeCondition.wait(lock, [&] { return statusChangeCount != observedStatusChangeCount; });
+    statusChangeWaiters--;
+}
+
 void Event::submitCommand(bool abortTasks) {
     std::unique_ptr<Command> cmdToProcess(cmdToSubmit.exchange(nullptr));
     if (cmdToProcess.get() != nullptr) {
@@ -489,17 +527,30 @@ cl_int Event::waitForEvents(cl_uint numEvents,
     WorkerListT *pendingEventsLeft = &workerList2;
 
     while (currentlyPendingEvents->size() > 0) {
+        Event *firstPendingEvent = nullptr;
+        uint64_t observedStatusChangeCount = 0;
+
         for (auto &e : *currentlyPendingEvents) {
             Event *event = castToObjectOrAbort<Event>(e);
             if (event->peekExecutionStatus() < CL_COMPLETE) {
                 return CL_EXEC_STATUS_ERROR_FOR_EVENTS_IN_WAIT_LIST;
             }
 
+            auto statusChangeCount = event->peekStatusChangeCount();
             if (event->wait(false) == false) {
                 pendingEventsLeft->push_back(event);
+                if (firstPendingEvent == nullptr) {
+                    firstPendingEvent = event;
+                    observedStatusChangeCount = statusChangeCount;
+                }
             }
         }
 
+        // events left are blocked on host side, all of them must complete, so sleep until first one moves
+        if (firstPendingEvent != nullptr) {
+            firstPendingEvent->waitForStatusChange(observedStatusChangeCount);
+        }
+
         std::swap(currentlyPendingEvents, pendingEventsLeft);
         pendingEventsLeft->clear();
     }
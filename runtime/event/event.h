@@ -25,6 +25,8 @@
 #include "runtime/helpers/base_object.h"
 #include <cstdint>
 #include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <vector>
 #include "runtime/helpers/task_information.h"
 #include "runtime/utilities/idlist.h"
@@ -271,6 +273,7 @@ class Event : public BaseObject<_cl_event>, public IDNode<Event> {
             this->taskCount = prevTaskCount;
             DEBUG_BREAK_IF(true);
         }
+        signalStatusChange();
     }
 
     bool isCurrentCmdQVirtualEvent() {
@@ -288,6 +291,15 @@ class Event : public BaseObject<_cl_event>, public IDNode<Event> {
         return this->taskCount;
     }
 
+    // incremented whenever status or task count is changed on host side,
+    // waiters snapshot it before checking event state, so change done in between is not missed
+    uint64_t peekStatusChangeCount() const {
+        return statusChangeCount;
+    }
+
+    // sleeps until status change count differs from observed one
+    void waitForStatusChange(uint64_t observedStatusChangeCount);
+
     void setQueueTimeStamp(TimeStampData *queueTimeStamp) {
         this->queueTimeStamp = *queueTimeStamp;
     };
@@ -352,6 +364,7 @@ class Event : public BaseObject<_cl_event>, public IDNode<Event> {
     IFRefList<Event, true, true> childEventsToNotify;
     void unblockEventsBlockedByThis(int32_t transitionStatus);
     void submitCommand(bool abortBlockedTasks);
+    void signalStatusChange();
 
     bool currentCmdQVirtualEvent;
     std::atomic<Command *> cmdToSubmit;
@@ -387,6 +400,12 @@ class Event : public BaseObject<_cl_event>, public IDNode<Event> {
     //event parents
     std::vector<Event *> parentEvents;
 
+    // threads sleeping in waitForStatusChange, signalling skips the lock when there are none
+    std::atomic<uint64_t> statusChangeCount;
+    std::atomic<uint32_t> statusChangeWaiters;
+    std::mutex statusChangeMutex;
+    std::condition_variable statusChangeCondition;
+
   private:
     // can be accessed only with updateTaskCount
     std::atomic<uint32_t> taskCount;
@@ -38,10 +38,13 @@ void UserEvent::updateExecutionStatus() {
 }
 
 bool UserEvent::wait(bool blocking) {
+    auto observedStatusChangeCount = peekStatusChangeCount();
     while (updateStatusAndCheckCompletion() == false) {
         if (blocking == false) {
             return false;
         }
+        waitForStatusChange(observedStatusChangeCount);
+        observedStatusChangeCount = peekStatusChangeCount();
     }
     return true;
 }
@@ -73,10 +76,13 @@ void VirtualEvent::updateExecutionStatus() {
 }
 
 bool VirtualEvent::wait(bool blocking) {
+    auto observedStatusChangeCount = peekStatusChangeCount();
     while (updateStatusAndCheckCompletion() == false) {
         if (blocking == false) {
             return false;
         }
+        waitForStatusChange(observedStatusChangeCount);
+        observedStatusChangeCount = peekStatusChangeCount();
     }
     return true;
 }
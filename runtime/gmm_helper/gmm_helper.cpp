@@ -29,8 +29,14 @@
 #include "runtime/memory_manager/graphics_allocation.h"
 #include "runtime/helpers/surface_formats.h"
 #include "runtime/helpers/hw_info.h"
+#include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/sku_info/operations/sku_info_transfer.h"
 
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
 extern "C" {
 
 void GMMDebugBreak(const char *file, const char *function, const int line) {
@@ -54,6 +60,105 @@ PGFX_DEBUG_CONTROL pDebugControl;
 }
 
 namespace OCLRT {
+namespace {
+struct ImageLayoutKey {
+    GMM_RESCREATE_PARAMS resourceParams;
+    GMM_YUV_PLANE_ENUM plane;
+    GFXCORE_FAMILY gfxFamily;
+};
+
+struct ImageLayout {
+    size_t size;
+    size_t rowPitch;
+    size_t slicePitch;
+    uint32_t qPitch;
+    uint32_t offset;
+    uint32_t xOffset;
+    uint32_t yOffset;
+    uint32_t yOffsetForUVPlane;
+    std::unique_ptr<GmmResourceInfo> resourceInfo;
+};
+
+// Whole key is compared bytewise, padding is zeroed so equal descriptors always map to the same key
+std::string getImageLayoutKey(const GMM_RESCREATE_PARAMS &resourceParams, GMM_YUV_PLANE_ENUM plane, GFXCORE_FAMILY gfxFamily) {
+    ImageLayoutKey key;
+    memset(&key, 0, sizeof(key));
+    memcpy(&key.resourceParams, &resourceParams, sizeof(resourceParams));
+    key.plane = plane;
+    key.gfxFamily = gfxFamily;
+    return std::string(reinterpret_cast<const char *>(&key), sizeof(key));
+}
+
+class ImageLayoutCache {
+  public:
+    bool restore(const std::string &key, Gmm &gmm, ImageInfo &imgInfo) {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = layouts.find(key);
+        if (it == layouts.end()) {
+            return false;
+        }
+        auto &layout = it->second;
+        gmm.gmmResourceInfo.reset(GmmResourceInfo::create(layout.resourceInfo->peekHandle()));
+        imgInfo.size = layout.size;
+        imgInfo.rowPitch = layout.rowPitch;
+        imgInfo.slicePitch = layout.slicePitch;
+        imgInfo.qPitch = layout.qPitch;
+        if (imgInfo.plane != GMM_NO_PLANE) {
+            imgInfo.offset = layout.offset;
+            imgInfo.xOffset = layout.xOffset;
+            imgInfo.yOffset = layout.yOffset;
+        }
+        if (imgInfo.surfaceFormat->GMMSurfaceFormat == GMM_FORMAT_NV12) {
+            imgInfo.yOffsetForUVPlane = layout.yOffsetForUVPlane;
+        }
+        return true;
+    }
+
+    void store(const std::string &key, const Gmm &gmm, const ImageInfo &imgInfo) {
+        std::unique_ptr<GmmResourceInfo> resourceInfo(GmmResourceInfo::create(gmm.gmmResourceInfo->peekHandle()));
+
+        std::lock_guard<std::mutex> lock(mtx);
+        if (layouts.size() >= Gmm::maxImageLayoutCacheSize) {
+            layouts.erase(layouts.begin());
+        }
+        auto &layout = layouts[key];
+        layout.size = imgInfo.size;
+        layout.rowPitch = imgInfo.rowPitch;
+        layout.slicePitch = imgInfo.slicePitch;
+        layout.qPitch = imgInfo.qPitch;
+        layout.offset = imgInfo.offset;
+        layout.xOffset = imgInfo.xOffset;
+        layout.yOffset = imgInfo.yOffset;
+        layout.yOffsetForUVPlane = imgInfo.yOffsetForUVPlane;
+        layout.resourceInfo = std::move(resourceInfo);
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mtx);
+        layouts.clear();
+    }
+
+    size_t size() {
+        std::lock_guard<std::mutex> lock(mtx);
+        return layouts.size();
+    }
+
+  protected:
+    std::mutex mtx;
+    std::unordered_map<std::string, ImageLayout> layouts;
+};
+
+ImageLayoutCache imageLayoutCache;
+} // namespace
+
+void Gmm::clearImageLayoutCache() {
+    imageLayoutCache.clear();
+}
+
+size_t Gmm::getImageLayoutCacheSize() {
+    return imageLayoutCache.size();
+}
+
 void Gmm::create() {
     if (resourceParams.BaseWidth >= maxPossiblePitch) {
         resourceParams.Flags.Gpu.NoRestriction = 1;
@@ -186,6 +291,15 @@ void Gmm::queryImageParams(ImageInfo &imgInfo, const HardwareInfo &hwInfo) {
 
     applyAuxFlags(imgInfo, hwInfo);
 
+    std::string layoutKey;
+    bool layoutCacheEnabled = DebugManager.flags.EnableImageLayoutCache.get();
+    if (layoutCacheEnabled) {
+        layoutKey = getImageLayoutKey(this->resourceParams, imgInfo.plane, hwInfo.pPlatform->eRenderCoreFamily);
+        if (imageLayoutCache.restore(layoutKey, *this, imgInfo)) {
+            return;
+        }
+    }
+
     this->gmmResourceInfo.reset(GmmResourceInfo::create(&this->resourceParams));
 
     imgInfo.size = this->gmmResourceInfo->getSizeAllocation();
@@ -238,6 +352,10 @@ void Gmm::queryImageParams(ImageInfo &imgInfo, const HardwareInfo &hwInfo) {
     }
 
     imgInfo.qPitch = queryQPitch(hwInfo.pPlatform->eRenderCoreFamily, this->resourceParams.Type);
+
+    if (layoutCacheEnabled) {
+        imageLayoutCache.store(layoutKey, *this, imgInfo);
+    }
     return;
 }
 
@@ -63,7 +63,10 @@ class Gmm {
     static Gmm *create(GMM_RESOURCE_INFO *inputGmm);
 
     static bool initContext(const PLATFORM *pPlatform, const FeatureTable *pSkuTable, const WorkaroundTable *pWaTable, const GT_SYSTEM_INFO *pGtSysInfo);
-    static void destroyContext() { GmmDestroyGlobalContext(); }
+    static void destroyContext() {
+        clearImageLayoutCache();
+        GmmDestroyGlobalContext();
+    }
 
     static uint32_t getMOCS(uint32_t type);
 
@@ -71,6 +74,10 @@ class Gmm {
 
     static Gmm *createGmmAndQueryImgParams(ImageInfo &imgInfo, const HardwareInfo &hwInfo);
 
+    static void clearImageLayoutCache();
+    static size_t getImageLayoutCacheSize();
+    static const size_t maxImageLayoutCacheSize = 256;
+
     static void queryImgFromBufferParams(ImageInfo &imgInfo, GraphicsAllocation *gfxAlloc);
 
     static bool allowTiling(const cl_image_desc &imageDesc);
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/dispatch_template.h"
+#include "runtime/command_stream/linear_stream.h"
+#include "runtime/helpers/debug_helpers.h"
+#include "runtime/helpers/string.h"
+
+namespace OCLRT {
+
+void DispatchTemplate::reset(const DispatchTemplateKey &newKey, const Vec3<size_t> &newLws) {
+    key = newKey;
+    lws = newLws;
+    perThreadData.clear();
+    walker.clear();
+    recorded = false;
+}
+
+void DispatchTemplate::recordPerThreadData(const void *src, size_t size) {
+    auto bytes = static_cast<const char *>(src);
+    perThreadData.assign(bytes, bytes + size);
+}
+
+void DispatchTemplate::replayPerThreadData(LinearStream &ioh) const {
+    DEBUG_BREAK_IF(!recorded);
+    if (perThreadData.empty()) {
+        return;
+    }
+    auto pDest = ioh.getSpace(perThreadData.size());
+    memcpy_s(pDest, perThreadData.size(), perThreadData.data(), perThreadData.size());
+}
+
+void DispatchTemplate::recordWalker(const void *src, size_t size) {
+    auto bytes = static_cast<const char *>(src);
+    walker.assign(bytes, bytes + size);
+    recorded = true;
+}
+
+void DispatchTemplate::replayWalker(void *dst, size_t size) const {
+    DEBUG_BREAK_IF(!recorded || size != walker.size());
+    memcpy_s(dst, size, walker.data(), walker.size());
+}
+
+DispatchTemplate *DispatchTemplateCache::find(const DispatchTemplateKey &key) {
+    for (size_t i = 0; i < templateCount; i++) {
+        if (templates[i].getKey() == key) {
+            return &templates[i];
+        }
+    }
+    return nullptr;
+}
+
+DispatchTemplate &DispatchTemplateCache::obtain(const DispatchTemplateKey &key, const Vec3<size_t> &lws) {
+    DispatchTemplate *dispatchTemplate = nullptr;
+    if (templateCount < maxTemplates) {
+        dispatchTemplate = &templates[templateCount++];
+    } else {
+        dispatchTemplate = &templates[nextToEvict];
+        nextToEvict = (nextToEvict + 1) % maxTemplates;
+    }
+    dispatchTemplate->reset(key, lws);
+    return *dispatchTemplate;
+}
+} // namespace OCLRT
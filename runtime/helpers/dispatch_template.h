@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include "runtime/utilities/vec.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace OCLRT {
+class LinearStream;
+
+struct DispatchTemplateKey {
+    uint32_t dim = 0;
+    Vec3<size_t> gws = {0, 0, 0};
+    Vec3<size_t> lws = {0, 0, 0};
+    Vec3<size_t> offset = {0, 0, 0};
+    Vec3<size_t> startOfWorkgroups = {0, 0, 0};
+    Vec3<size_t> numberOfWorkgroups = {0, 0, 0};
+    // work group size selection depends on SLM, which local memory arguments change
+    uint32_t slmTotalSize = 0;
+
+    bool operator==(const DispatchTemplateKey &other) const {
+        return dim == other.dim && gws == other.gws && lws == other.lws && offset == other.offset &&
+               startOfWorkgroups == other.startOfWorkgroups && numberOfWorkgroups == other.numberOfWorkgroups &&
+               slmTotalSize == other.slmTotalSize;
+    }
+};
+
+// Geometry dependent part of a single kernel dispatch (work group size, local IDs and walker),
+// recorded on first enqueue and replayed with relocated heap offsets on subsequent identical ones
+class DispatchTemplate {
+  public:
+    const DispatchTemplateKey &getKey() const { return key; }
+    const Vec3<size_t> &getLocalWorkgroupSize() const { return lws; }
+    bool isRecorded() const { return recorded; }
+
+    void reset(const DispatchTemplateKey &newKey, const Vec3<size_t> &newLws);
+    void recordPerThreadData(const void *src, size_t size);
+    void replayPerThreadData(LinearStream &ioh) const;
+    void recordWalker(const void *src, size_t size);
+    void replayWalker(void *dst, size_t size) const;
+
+  protected:
+    DispatchTemplateKey key;
+    Vec3<size_t> lws = {0, 0, 0};
+    std::vector<char> perThreadData;
+    std::vector<char> walker;
+    bool recorded = false;
+};
+
+class DispatchTemplateCache {
+  public:
+    static const size_t maxTemplates = 4;
+
+    DispatchTemplate *find(const DispatchTemplateKey &key);
+    DispatchTemplate &obtain(const DispatchTemplateKey &key, const Vec3<size_t> &lws);
+    size_t getTemplateCount() const { return templateCount; }
+
+  protected:
+    std::array<DispatchTemplate, maxTemplates> templates;
+    size_t templateCount = 0;
+    size_t nextToEvict = 0;
+};
+} // namespace OCLRT
@@ -88,9 +88,15 @@ struct KernelCommandsHelper : public PerThreadDataHelper {
     }
 
     static size_t pushBindingTableAndSurfaceStates(IndirectHeap &dstHeap, const Kernel &srcKernel) {
-        return pushBindingTableAndSurfaceStates(dstHeap, srcKernel.getKernelInfo(),
-                                                srcKernel.getSurfaceStateHeap(), srcKernel.getSurfaceStateHeapSize(),
-                                                srcKernel.getNumberOfBindingTableStates(), srcKernel.getBindingTableOffset());
+        size_t bindingTableOffset = 0;
+        if (srcKernel.getCachedBindingTableOffset(dstHeap, bindingTableOffset)) {
+            return bindingTableOffset;
+        }
+        bindingTableOffset = pushBindingTableAndSurfaceStates(dstHeap, srcKernel.getKernelInfo(),
+                                                              srcKernel.getSurfaceStateHeap(), srcKernel.getSurfaceStateHeapSize(),
+                                                              srcKernel.getNumberOfBindingTableStates(), srcKernel.getBindingTableOffset());
+        srcKernel.cacheBindingTableOffset(dstHeap, bindingTableOffset);
+        return bindingTableOffset;
     }
 
     static size_t sendIndirectState(
@@ -105,7 +111,8 @@ struct KernelCommandsHelper : public PerThreadDataHelper {
         const size_t localWorkSize[3],
         const uint64_t offsetInterfaceDescriptorTable,
         const uint32_t interfaceDescriptorIndex,
-        PreemptionMode preemptionMode);
+        PreemptionMode preemptionMode,
+        DispatchTemplate *dispatchTemplate = nullptr);
 
     static size_t getSizeRequiredCS();
     static bool isPipeControlWArequired();
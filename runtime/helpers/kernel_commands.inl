@@ -26,6 +26,7 @@
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/helpers/basic_math.h"
 #include "runtime/helpers/dispatch_info.h"
+#include "runtime/helpers/dispatch_template.h"
 #include "runtime/helpers/ptr_math.h"
 #include "runtime/helpers/string.h"
 #include "runtime/indirect_heap/indirect_heap.h"
@@ -332,7 +333,8 @@ size_t KernelCommandsHelper<GfxFamily>::sendIndirectState(
     const size_t localWorkSize[3],
     const uint64_t offsetInterfaceDescriptorTable,
     const uint32_t interfaceDescriptorIndex,
-    PreemptionMode preemptionMode) {
+    PreemptionMode preemptionMode,
+    DispatchTemplate *dispatchTemplate) {
 
     typedef typename GfxFamily::INTERFACE_DESCRIPTOR_DATA INTERFACE_DESCRIPTOR_DATA;
     typedef typename GfxFamily::RENDER_SURFACE_STATE RENDER_SURFACE_STATE;
@@ -391,11 +393,18 @@ size_t KernelCommandsHelper<GfxFamily>::sendIndirectState(
     DEBUG_BREAK_IF(nullptr == threadPayload);
 
     auto numChannels = PerThreadDataHelper::getNumLocalIdChannels(*threadPayload);
-    sendPerThreadData(
-        ioh,
-        simd,
-        numChannels,
-        localWorkSize);
+    if (dispatchTemplate && dispatchTemplate->isRecorded()) {
+        dispatchTemplate->replayPerThreadData(ioh);
+    } else {
+        auto offsetPerThreadData = sendPerThreadData(
+            ioh,
+            simd,
+            numChannels,
+            localWorkSize);
+        if (dispatchTemplate) {
+            dispatchTemplate->recordPerThreadData(ptrOffset(ioh.getCpuBase(), offsetPerThreadData), ioh.getUsed() - offsetPerThreadData);
+        }
+    }
 
     // send interface descriptor data
     auto localWorkItems = localWorkSize[0] * localWorkSize[1] * localWorkSize[2];
@@ -39,4 +39,13 @@ TransferProperties::TransferProperties(MemObj *memObj, cl_command_type cmdType,
         }
     }
 }
+
+TransferProperties::TransferProperties(MemObj *memObj, cl_command_type cmdType, bool blocking, const size_t *bufferOrigin, const size_t *hostOrigin, const size_t *region,
+                                       size_t bufferRowPitch, size_t bufferSlicePitch, size_t hostRowPitch, size_t hostSlicePitch, void *ptr)
+    : memObj(memObj), cmdType(cmdType), mapFlags(0), blocking(blocking), ptr(ptr),
+      rowPitch(bufferRowPitch), slicePitch(bufferSlicePitch), hostRowPitch(hostRowPitch), hostSlicePitch(hostSlicePitch) {
+    offset = {{bufferOrigin[0], bufferOrigin[1], bufferOrigin[2]}};
+    hostOffset = {{hostOrigin[0], hostOrigin[1], hostOrigin[2]}};
+    size = {{region[0], region[1], region[2]}};
+}
 } // namespace OCLRT
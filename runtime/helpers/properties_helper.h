@@ -54,6 +54,9 @@ struct TransferProperties {
     TransferProperties(MemObj *memObj, cl_command_type cmdType, cl_map_flags mapFlags, bool blocking, size_t *offsetPtr, size_t *sizePtr,
                        void *ptr);
 
+    TransferProperties(MemObj *memObj, cl_command_type cmdType, bool blocking, const size_t *bufferOrigin, const size_t *hostOrigin, const size_t *region,
+                       size_t bufferRowPitch, size_t bufferSlicePitch, size_t hostRowPitch, size_t hostSlicePitch, void *ptr);
+
     MemObj *memObj;
     cl_command_type cmdType;
     cl_map_flags mapFlags;
@@ -61,6 +64,13 @@ struct TransferProperties {
     MemObjOffsetArray offset = {{0, 0, 0}};
     MemObjSizeArray size = {{0, 0, 0}};
     void *ptr;
+
+    // rect transfers only, offset holds the buffer origin and size the region
+    MemObjOffsetArray hostOffset = {{0, 0, 0}};
+    size_t rowPitch = 0;
+    size_t slicePitch = 0;
+    size_t hostRowPitch = 0;
+    size_t hostSlicePitch = 0;
 };
 
 struct MapInfo {
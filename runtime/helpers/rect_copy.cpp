@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/rect_copy.h"
+#include "runtime/helpers/ptr_math.h"
+#include "runtime/helpers/string.h"
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace OCLRT {
+namespace {
+struct RectView {
+    const size_t *origin;
+    size_t rowPitch;
+    size_t slicePitch;
+
+    size_t getRowOffset(size_t row, size_t rowsInSlice) const {
+        return (origin[2] + row / rowsInSlice) * slicePitch + (origin[1] + row % rowsInSlice) * rowPitch + origin[0];
+    }
+};
+
+void copyRows(void *dst, const RectView &dstView, const void *src, const RectView &srcView,
+              const size_t *region, size_t firstRow, size_t lastRow) {
+    for (auto row = firstRow; row < lastRow; row++) {
+        memcpy_s(ptrOffset(dst, dstView.getRowOffset(row, region[1])), region[0],
+                 ptrOffset(src, srcView.getRowOffset(row, region[1])), region[0]);
+    }
+}
+} // namespace
+
+uint32_t getRectCopyThreadCount(const size_t *region, uint32_t maxThreads) {
+    auto rowCount = region[1] * region[2];
+    if (rowCount < 2 || region[0] * rowCount < rectCopyParallelThreshold) {
+        return 1u;
+    }
+    auto hwThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    return static_cast<uint32_t>(std::min<size_t>({static_cast<size_t>(std::max(maxThreads, 1u)), static_cast<size_t>(hwThreads), rowCount}));
+}
+
+void copyRect(void *dst, const size_t *dstOrigin, size_t dstRowPitch, size_t dstSlicePitch,
+              const void *src, const size_t *srcOrigin, size_t srcRowPitch, size_t srcSlicePitch,
+              const size_t *region, uint32_t maxThreads) {
+    auto rowCount = region[0] ? region[1] * region[2] : 0;
+    if (rowCount == 0) {
+        return;
+    }
+    RectView dstView = {dstOrigin, dstRowPitch, dstSlicePitch};
+    RectView srcView = {srcOrigin, srcRowPitch, srcSlicePitch};
+
+    auto threadCount = getRectCopyThreadCount(region, maxThreads);
+    if (threadCount == 1) {
+        copyRows(dst, dstView, src, srcView, region, 0, rowCount);
+        return;
+    }
+
+    auto rowsPerThread = (rowCount + threadCount - 1) / threadCount;
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount - 1);
+    for (uint32_t i = 1; i < threadCount; i++) {
+        auto firstRow = std::min(rowCount, i * rowsPerThread);
+        auto lastRow = std::min(rowCount, firstRow + rowsPerThread);
+        workers.emplace_back(copyRows, dst, std::cref(dstView), src, std::cref(srcView), region, firstRow, lastRow);
+    }
+    copyRows(dst, dstView, src, srcView, region, 0, std::min(rowCount, rowsPerThread));
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
+} // namespace OCLRT
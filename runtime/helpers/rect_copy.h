@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace OCLRT {
+constexpr size_t rectCopyParallelThreshold = 1024 * 1024;
+constexpr uint32_t rectCopyMaxThreads = 4;
+
+// Number of workers copyRect splits the rows of region between, never more than maxThreads.
+uint32_t getRectCopyThreadCount(const size_t *region, uint32_t maxThreads);
+
+// Host side equivalent of the CopyBufferRect builtin: copies region[0] bytes from each of the
+// region[1] * region[2] rows of src into dst, addressing both views with their own origin and pitches.
+void copyRect(void *dst, const size_t *dstOrigin, size_t dstRowPitch, size_t dstSlicePitch,
+              const void *src, const size_t *srcOrigin, size_t srcRowPitch, size_t srcSlicePitch,
+              const size_t *region, uint32_t maxThreads = rectCopyMaxThreads);
+} // namespace OCLRT
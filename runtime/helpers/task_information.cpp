@@ -22,6 +22,7 @@
 
 #include "runtime/command_stream/linear_stream.h"
 #include "runtime/command_stream/command_stream_receiver.h"
+#include "runtime/command_queue/blocked_commands_pool.h"
 #include "runtime/command_queue/command_queue.h"
 #include "runtime/command_queue/enqueue_common.h"
 #include "runtime/device/device.h"
@@ -35,15 +36,23 @@
 
 namespace OCLRT {
 KernelOperation::~KernelOperation() {
-    alignedFree(dsh->getCpuBase());
-    alignedFree(ish->getCpuBase());
+    releaseStorage(dsh->getCpuBase(), dsh->getMaxAvailableSpace());
+    releaseStorage(ish->getCpuBase(), ish->getMaxAvailableSpace());
     if (doNotFreeISH) {
         ioh.release();
     } else {
-        alignedFree(ioh->getCpuBase());
+        releaseStorage(ioh->getCpuBase(), ioh->getMaxAvailableSpace());
+    }
+    releaseStorage(ssh->getCpuBase(), ssh->getMaxAvailableSpace());
+    releaseStorage(commandStream->getCpuBase(), commandStream->getMaxAvailableSpace());
+}
+
+void KernelOperation::releaseStorage(void *buffer, size_t size) {
+    if (storagePool) {
+        storagePool->release(buffer, size);
+    } else {
+        alignedFree(buffer);
     }
-    alignedFree(ssh->getCpuBase());
-    alignedFree(commandStream->getCpuBase());
 }
 
 CommandMapUnmap::CommandMapUnmap(MapOperationType op, MemObj &memObj, MemObjSizeArray &copySize, MemObjOffsetArray &copyOffset, bool readOnly,
@@ -132,7 +141,7 @@ CommandComputeKernel::~CommandComputeKernel() {
         delete surface;
     }
     surfaces.clear();
-    if (kernelOperation->ioh.get() == kernelOperation->dsh.get()) {
+    if (kernelOperation && kernelOperation->ioh.get() == kernelOperation->dsh.get()) {
         kernelOperation->doNotFreeISH = true;
     }
     if (kernel) {
@@ -173,16 +182,29 @@ CompletionStamp &CommandComputeKernel::submit(uint32_t taskLevel, bool terminate
     IndirectHeap *dsh = nullptr;
     IndirectHeap *ioh = nullptr;
 
-    IndirectHeap::Type trackedHeaps[] = {IndirectHeap::SURFACE_STATE, IndirectHeap::INDIRECT_OBJECT, IndirectHeap::DYNAMIC_STATE};
+    // blocked commands address heaps from offset 0, shared heaps give them ranges with own base instead of being released
+    bool sharedIndirectHeaps = commandStreamReceiver.isSharedIndirectHeapsEnabled();
+    std::unique_ptr<IndirectHeap> heapRanges[IndirectHeap::NUM_TYPES];
+    auto getHeap = [&](IndirectHeap::Type heapType, size_t requestedSize) -> IndirectHeap & {
+        if (sharedIndirectHeaps) {
+            heapRanges[heapType] = commandStreamReceiver.obtainIndirectHeapRange(heapType, requestedSize);
+            return *heapRanges[heapType];
+        }
+        return commandQueue.getIndirectHeap(heapType, requestedSize);
+    };
+
+    if (!sharedIndirectHeaps) {
+        IndirectHeap::Type trackedHeaps[] = {IndirectHeap::SURFACE_STATE, IndirectHeap::INDIRECT_OBJECT, IndirectHeap::DYNAMIC_STATE};
 
-    for (auto trackedHeap = 0u; trackedHeap < ARRAY_COUNT(trackedHeaps); trackedHeap++) {
-        if (commandQueue.getIndirectHeap(trackedHeaps[trackedHeap], 0).getUsed() > 0) {
-            commandQueue.releaseIndirectHeap(trackedHeaps[trackedHeap]);
+        for (auto trackedHeap = 0u; trackedHeap < ARRAY_COUNT(trackedHeaps); trackedHeap++) {
+            if (commandQueue.getIndirectHeap(trackedHeaps[trackedHeap], 0).getUsed() > 0) {
+                commandQueue.releaseIndirectHeap(trackedHeaps[trackedHeap]);
+            }
         }
-    }
 
-    if (commandQueue.getIndirectHeap(IndirectHeap::INSTRUCTION, 0).getUsed() > commandQueue.getInstructionHeapReservedBlockSize()) {
-        commandQueue.releaseIndirectHeap(IndirectHeap::INSTRUCTION);
+        if (commandQueue.getIndirectHeap(IndirectHeap::INSTRUCTION, 0).getUsed() > commandQueue.getInstructionHeapReservedBlockSize()) {
+            commandQueue.releaseIndirectHeap(IndirectHeap::INSTRUCTION);
+        }
     }
 
     if (executionModelKernel) {
@@ -193,8 +215,8 @@ CompletionStamp &CommandComputeKernel::submit(uint32_t taskLevel, bool terminate
         memcpy_s(dsh->getSpace(0), dsh->getAvailableSpace(), ptrOffset(kernelOperation->dsh->getCpuBase(), devQueue->colorCalcStateSize), kernelOperation->dsh->getUsed() - devQueue->colorCalcStateSize);
         dsh->getSpace(kernelOperation->dsh->getUsed() - devQueue->colorCalcStateSize);
     } else {
-        dsh = &commandQueue.getIndirectHeap(IndirectHeap::DYNAMIC_STATE, requestedDshSize);
-        ioh = &commandQueue.getIndirectHeap(IndirectHeap::INDIRECT_OBJECT, requestedIohSize);
+        dsh = &getHeap(IndirectHeap::DYNAMIC_STATE, requestedDshSize);
+        ioh = &getHeap(IndirectHeap::INDIRECT_OBJECT, requestedIohSize);
 
         memcpy_s(dsh->getCpuBase(), requestedDshSize, kernelOperation->dsh->getCpuBase(), kernelOperation->dsh->getUsed());
         dsh->getSpace(requestedDshSize);
@@ -203,8 +225,8 @@ CompletionStamp &CommandComputeKernel::submit(uint32_t taskLevel, bool terminate
         ioh->getSpace(requestedIohSize);
     }
 
-    IndirectHeap &ish = commandQueue.getIndirectHeap(IndirectHeap::INSTRUCTION, requestedIshSize);
-    IndirectHeap &ssh = commandQueue.getIndirectHeap(IndirectHeap::SURFACE_STATE, requestedSshSize);
+    IndirectHeap &ish = getHeap(IndirectHeap::INSTRUCTION, requestedIshSize);
+    IndirectHeap &ssh = getHeap(IndirectHeap::SURFACE_STATE, requestedSshSize);
 
     memcpy_s(ptrOffset(ish.getCpuBase(), commandQueue.getInstructionHeapReservedBlockSize()), requestedIshSize, kernelOperation->ish->getCpuBase(), kernelOperation->ish->getUsed());
     ish.getSpace(kernelOperation->ish->getUsed());
@@ -264,6 +286,8 @@ CompletionStamp &CommandComputeKernel::submit(uint32_t taskLevel, bool terminate
 
     DEBUG_BREAK_IF(taskLevel >= Event::eventNotReady);
 
+    commandStreamReceiver.setRequiredScratchSize(kernelOperation->requiredScratchSize);
+
     gtpinNotifyPreFlushTask(&commandQueue);
 
     completionStamp = commandStreamReceiver.flushTask(queueCommandStream,
@@ -279,8 +303,14 @@ CompletionStamp &CommandComputeKernel::submit(uint32_t taskLevel, bool terminate
     }
     commandQueue.waitUntilComplete(completionStamp.taskCount, completionStamp.flushStamp);
 
+    // blocked storage has been copied to the queue's heaps, hand it back to the pool right away
+    if (kernelOperation->ioh.get() == kernelOperation->dsh.get()) {
+        kernelOperation->doNotFreeISH = true;
+    }
+    kernelOperation.reset();
+
     if (printfHandler) {
-        printfHandler.get()->printEnqueueOutput();
+        PrintfHandler::flushEnqueueOutput(std::move(printfHandler));
     }
 
     return completionStamp;
@@ -32,6 +32,7 @@
 #include <vector>
 
 namespace OCLRT {
+class BlockedCommandsPool;
 class CommandQueue;
 class CommandStreamReceiver;
 class Kernel;
@@ -86,6 +87,8 @@ struct KernelOperation {
 
     ~KernelOperation();
 
+    void releaseStorage(void *buffer, size_t size);
+
     std::unique_ptr<LinearStream> commandStream;
     std::unique_ptr<IndirectHeap> dsh;
     std::unique_ptr<IndirectHeap> ish;
@@ -95,6 +98,10 @@ struct KernelOperation {
     size_t instructionHeapSizeEM;
     size_t surfaceStateHeapSizeEM;
     bool doNotFreeISH;
+    // recorded on the CSR at submission, so scratch shrinking only sees blocked kernels once they are flushed
+    uint32_t requiredScratchSize = 0;
+    // when set, heap and command stream storage is returned to the queue's pool instead of being freed
+    BlockedCommandsPool *storagePool = nullptr;
 };
 
 class CommandComputeKernel : public Command {
@@ -109,7 +116,7 @@ class CommandComputeKernel : public Command {
     CompletionStamp &submit(uint32_t taskLevel, bool terminated) override;
 
     LinearStream *getCommandStream() override {
-        return kernelOperation->commandStream.get();
+        return kernelOperation ? kernelOperation->commandStream.get() : nullptr;
     }
 
   private:
@@ -32,6 +32,7 @@ class GraphicsAllocation;
 constexpr size_t defaultHeapSize = 64 * KB;
 constexpr size_t optimalInstructionHeapSize = 512 * KB;
 constexpr size_t maxSshSize = defaultHeapSize - MemoryConstants::pageSize;
+constexpr size_t sharedIndirectHeapSize = 4 * MB;
 
 class IndirectHeap : public LinearStream {
     typedef LinearStream BaseClass;
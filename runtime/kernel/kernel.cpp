@@ -38,6 +38,7 @@
 #include "runtime/helpers/per_thread_data.h"
 #include "runtime/helpers/ptr_math.h"
 #include "runtime/helpers/sampler_helpers.h"
+#include "runtime/indirect_heap/indirect_heap.h"
 #include "runtime/mem_obj/buffer.h"
 #include "runtime/mem_obj/image.h"
 #include "runtime/mem_obj/pipe.h"
@@ -717,6 +718,8 @@ const void *Kernel::getSurfaceStateHeap() const {
 }
 
 void *Kernel::getSurfaceStateHeap() {
+    //caller may modify surface states, binding tables pushed so far are outdated
+    ++sshGeneration;
     return const_cast<void *>(const_cast<const Kernel *>(this)->getSurfaceStateHeap());
 }
 
@@ -744,6 +747,27 @@ void Kernel::resizeSurfaceStateHeap(void *pNewSsh, size_t newSshSize, size_t new
     sshLocalSize = static_cast<uint32_t>(newSshSize);
     numberOfBindingTableStates = newBindingTableCount;
     localBindingTableOffset = newBindingTableOffset;
+    ++sshGeneration;
+}
+
+bool Kernel::getCachedBindingTableOffset(const IndirectHeap &ssh, size_t &bindingTableOffset) const {
+    if (bindingTableCache.ssh != &ssh ||
+        bindingTableCache.sshBufferGeneration != ssh.getBufferGeneration() ||
+        bindingTableCache.sshGeneration != sshGeneration) {
+        return false;
+    }
+    bindingTableOffset = bindingTableCache.bindingTableOffset;
+    return true;
+}
+
+void Kernel::cacheBindingTableOffset(const IndirectHeap &ssh, size_t bindingTableOffset) const {
+    if (!DebugManager.flags.EnableBindingTableCache.get()) {
+        return;
+    }
+    bindingTableCache.ssh = &ssh;
+    bindingTableCache.sshBufferGeneration = ssh.getBufferGeneration();
+    bindingTableCache.sshGeneration = sshGeneration;
+    bindingTableCache.bindingTableOffset = bindingTableOffset;
 }
 
 uint32_t Kernel::getScratchSizeValueToProgramMediaVfeState(int scratchSize) {
@@ -922,6 +946,46 @@ void Kernel::updateWithCompletionStamp(CommandStreamReceiver &commandStreamRecei
     }
 }
 
+void Kernel::getAllocationsAccess(std::vector<GraphicsAllocation *> &readOnlyAllocations, std::vector<GraphicsAllocation *> &writtenAllocations) const {
+    if (privateSurface) {
+        writtenAllocations.push_back(privateSurface);
+    }
+    if (program->getConstantSurface()) {
+        readOnlyAllocations.push_back(program->getConstantSurface());
+    }
+    if (program->getGlobalSurface()) {
+        writtenAllocations.push_back(program->getGlobalSurface());
+    }
+    for (auto gfxAlloc : kernelSvmGfxAllocations) {
+        writtenAllocations.push_back(gfxAlloc);
+    }
+    if (kernelInfo.kernelAllocation) {
+        readOnlyAllocations.push_back(kernelInfo.kernelAllocation);
+    }
+
+    auto numArgs = kernelInfo.kernelArgInfo.size();
+    for (decltype(numArgs) argIndex = 0; argIndex < numArgs; argIndex++) {
+        if (!kernelArguments[argIndex].object) {
+            continue;
+        }
+        const auto &argInfo = kernelInfo.kernelArgInfo[argIndex];
+        bool readOnly = (argInfo.isImage && argInfo.accessQualifier == CL_KERNEL_ARG_ACCESS_READ_ONLY) ||
+                        (!argInfo.isImage && argInfo.typeQualifierStr.find("const") != std::string::npos);
+        auto &dst = readOnly ? readOnlyAllocations : writtenAllocations;
+
+        if (kernelArguments[argIndex].type == SVM_ALLOC_OBJ) {
+            dst.push_back((GraphicsAllocation *)kernelArguments[argIndex].object);
+        } else if (Kernel::isMemObj(kernelArguments[argIndex].type)) {
+            auto clMem = (const cl_mem)kernelArguments[argIndex].object;
+            auto memObj = castToObjectOrAbort<MemObj>(clMem);
+            dst.push_back(memObj->getGraphicsAllocation());
+            if (memObj->getMcsAllocation()) {
+                dst.push_back(memObj->getMcsAllocation());
+            }
+        }
+    }
+}
+
 void Kernel::makeResident(CommandStreamReceiver &commandStreamReceiver) {
     if (privateSurface) {
         commandStreamReceiver.makeResident(*privateSurface);
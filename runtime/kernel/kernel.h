@@ -25,6 +25,7 @@
 #include "runtime/command_stream/thread_arbitration_policy.h"
 #include "runtime/device_queue/device_queue.h"
 #include "runtime/helpers/base_object.h"
+#include "runtime/helpers/dispatch_template.h"
 #include "runtime/helpers/preamble.h"
 #include "runtime/program/program.h"
 #include "runtime/program/kernel_info.h"
@@ -34,6 +35,7 @@
 namespace OCLRT {
 struct CompletionStamp;
 class GraphicsAllocation;
+class IndirectHeap;
 class Surface;
 class PrintfHandler;
 
@@ -164,6 +166,13 @@ class Kernel : public BaseObject<_cl_kernel> {
 
     void resizeSurfaceStateHeap(void *pNewSsh, size_t newSshSize, size_t newBindingTableCount, size_t newBindingTableOffset);
 
+    // binding table pushed to heap stays valid until kernel's SSH is modified or heap starts over in new buffer
+    bool getCachedBindingTableOffset(const IndirectHeap &ssh, size_t &bindingTableOffset) const;
+    void cacheBindingTableOffset(const IndirectHeap &ssh, size_t bindingTableOffset) const;
+    uint32_t getSurfaceStateHeapGeneration() const { return sshGeneration; }
+
+    DispatchTemplateCache &getDispatchTemplates() { return dispatchTemplates; }
+
     void substituteKernelHeap(void *newKernelHeap, size_t newKernelHeapSize);
     bool isKernelHeapSubstituted() const;
     uint64_t getKernelId() const;
@@ -284,6 +293,8 @@ class Kernel : public BaseObject<_cl_kernel> {
     MOCKABLE_VIRTUAL void makeResident(CommandStreamReceiver &commandStreamReceiver);
     void updateWithCompletionStamp(CommandStreamReceiver &commandStreamReceiver, CompletionStamp *completionStamp);
     MOCKABLE_VIRTUAL void getResidency(std::vector<Surface *> &dst);
+    //splits kernel surfaces into read only and written ones, allocations of unknown access are reported as written
+    void getAllocationsAccess(std::vector<GraphicsAllocation *> &readOnlyAllocations, std::vector<GraphicsAllocation *> &writtenAllocations) const;
     bool requiresCoherency();
     void resetSharedObjectsPatchAddresses();
     bool isUsingSharedObjArgs() { return usingSharedObjArgs; }
@@ -457,5 +468,17 @@ class Kernel : public BaseObject<_cl_kernel> {
 
     bool usingSharedObjArgs;
     uint32_t patchedArgumentsNum = 0;
+
+    struct BindingTableCache {
+        const IndirectHeap *ssh = nullptr;
+        uint32_t sshBufferGeneration = 0;
+        uint32_t sshGeneration = 0;
+        size_t bindingTableOffset = 0;
+    };
+    // incremented on every non-const access to local SSH
+    uint32_t sshGeneration = 0;
+    mutable BindingTableCache bindingTableCache;
+
+    DispatchTemplateCache dispatchTemplates;
 };
 } // namespace OCLRT
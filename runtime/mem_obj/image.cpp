@@ -111,7 +111,11 @@ void Image::transferData(void *dest, size_t destRowPitch, size_t destSlicePitch,
     }
 }
 
-Image::~Image() = default;
+Image::~Image() {
+    for (auto &view : redescribedViews) {
+        view.image->release();
+    }
+}
 
 Image *Image::create(Context *context,
                      cl_mem_flags flags,
@@ -773,46 +777,21 @@ cl_int Image::getImageInfo(cl_image_info paramName,
     return retVal;
 }
 
-Image *Image::redescribeFillImage() {
+const SurfaceFormatInfo *Image::getRedescribedFillSurfaceFormat() const {
     const uint32_t redescribeTable[3][3] = {
         {17, 27, 5}, // {CL_R, CL_UNSIGNED_INT8},  {CL_RG, CL_UNSIGNED_INT8},  {CL_RGBA, CL_UNSIGNED_INT8}
         {18, 28, 6}, // {CL_R, CL_UNSIGNED_INT16}, {CL_RG, CL_UNSIGNED_INT16}, {CL_RGBA, CL_UNSIGNED_INT16}
         {19, 29, 7}  // {CL_R, CL_UNSIGNED_INT32}, {CL_RG, CL_UNSIGNED_INT32}, {CL_RGBA, CL_UNSIGNED_INT32}
     };
 
-    auto imageFormatNew = this->imageFormat;
-    auto imageDescNew = this->imageDesc;
-    const SurfaceFormatInfo *surfaceFormat = nullptr;
     uint32_t redescribeTableCol = this->surfaceFormatInfo.NumChannels / 2;
     uint32_t redescribeTableRow = this->surfaceFormatInfo.PerChannelSizeInBytes / 2;
 
     uint32_t surfaceFormatIdx = redescribeTable[redescribeTableRow][redescribeTableCol];
-    surfaceFormat = &readWriteSurfaceFormats[surfaceFormatIdx];
-
-    imageFormatNew.image_channel_order = surfaceFormat->OCLImageFormat.image_channel_order;
-    imageFormatNew.image_channel_data_type = surfaceFormat->OCLImageFormat.image_channel_data_type;
-
-    DEBUG_BREAK_IF(nullptr == createFunction);
-    auto image = createFunction(context,
-                                flags | CL_MEM_USE_HOST_PTR,
-                                this->getSize(),
-                                this->getCpuAddress(),
-                                imageFormatNew,
-                                imageDescNew,
-                                this->isMemObjZeroCopy(),
-                                this->getGraphicsAllocation(),
-                                true,
-                                isTiledImage,
-                                this->mipLevel,
-                                surfaceFormat,
-                                &this->surfaceOffsets);
-    image->setQPitch(this->getQPitch());
-    image->setCubeFaceIndex(this->getCubeFaceIndex());
-    return image;
+    return &readWriteSurfaceFormats[surfaceFormatIdx];
 }
 
-Image *Image::redescribe() {
-
+const SurfaceFormatInfo *Image::getRedescribedSurfaceFormat() const {
     const uint32_t redescribeTableBytes[] = {
         17, // {CL_R, CL_UNSIGNED_INT8}        1 byte
         18, // {CL_R, CL_UNSIGNED_INT16}       2 byte
@@ -821,9 +800,6 @@ Image *Image::redescribe() {
         7   // {CL_RGBA, CL_UNSIGNED_INT32}    16 byte
     };
 
-    auto imageFormatNew = this->imageFormat;
-    auto imageDescNew = this->imageDesc;
-    const SurfaceFormatInfo *surfaceFormat = nullptr;
     auto bytesPerPixel = this->surfaceFormatInfo.NumChannels * surfaceFormatInfo.PerChannelSizeInBytes;
     uint32_t exponent = 0;
 
@@ -831,7 +807,12 @@ Image *Image::redescribe() {
     DEBUG_BREAK_IF(exponent >= 32);
 
     uint32_t surfaceFormatIdx = redescribeTableBytes[exponent % 5];
-    surfaceFormat = &readWriteSurfaceFormats[surfaceFormatIdx];
+    return &readWriteSurfaceFormats[surfaceFormatIdx];
+}
+
+Image *Image::createRedescribedImage(const SurfaceFormatInfo *surfaceFormat) {
+    auto imageFormatNew = this->imageFormat;
+    auto imageDescNew = this->imageDesc;
 
     imageFormatNew.image_channel_order = surfaceFormat->OCLImageFormat.image_channel_order;
     imageFormatNew.image_channel_data_type = surfaceFormat->OCLImageFormat.image_channel_data_type;
@@ -855,6 +836,59 @@ Image *Image::redescribe() {
     return image;
 }
 
+bool Image::isRedescribedViewValid(Image *view) const {
+    const auto &viewDesc = view->getImageDesc();
+    return view->getGraphicsAllocation() == this->graphicsAllocation &&
+           view->getCubeFaceIndex() == this->cubeFaceIndex &&
+           view->getQPitch() == this->qPitch &&
+           view->peekMipLevel() == this->mipLevel &&
+           viewDesc.image_row_pitch == this->imageDesc.image_row_pitch &&
+           viewDesc.image_slice_pitch == this->imageDesc.image_slice_pitch;
+}
+
+Image *Image::getCachedRedescribedImage(const SurfaceFormatInfo *surfaceFormat) {
+    std::lock_guard<std::mutex> lock(redescribedViewsMtx);
+
+    Image *view = nullptr;
+    for (auto &cachedView : redescribedViews) {
+        if (cachedView.surfaceFormat != surfaceFormat) {
+            continue;
+        }
+        if (!isRedescribedViewValid(cachedView.image)) {
+            //parent changed since the view was created, replace it with a fresh one
+            cachedView.image->release();
+            cachedView.image = createRedescribedImage(surfaceFormat);
+        }
+        view = cachedView.image;
+        break;
+    }
+
+    if (!view) {
+        view = createRedescribedImage(surfaceFormat);
+        redescribedViews.push_back({surfaceFormat, view});
+    }
+
+    //cache keeps its own reference, caller gets another one
+    view->retain();
+    return view;
+}
+
+Image *Image::redescribeFillImage() {
+    return createRedescribedImage(getRedescribedFillSurfaceFormat());
+}
+
+Image *Image::redescribe() {
+    return createRedescribedImage(getRedescribedSurfaceFormat());
+}
+
+Image *Image::getRedescribedFillView() {
+    return getCachedRedescribedImage(getRedescribedFillSurfaceFormat());
+}
+
+Image *Image::getRedescribedView() {
+    return getCachedRedescribedImage(getRedescribedSurfaceFormat());
+}
+
 void Image::transferDataToHostPtr(MemObjSizeArray &copySize, MemObjOffsetArray &copyOffset) {
     transferData(hostPtr, hostPtrRowPitch, hostPtrSlicePitch,
                  graphicsAllocation->getUnderlyingBuffer(), imageDesc.image_row_pitch, imageDesc.image_slice_pitch,
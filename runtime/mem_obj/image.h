@@ -25,6 +25,8 @@
 #include "runtime/helpers/string.h"
 #include "runtime/helpers/surface_formats.h"
 #include "runtime/helpers/validators.h"
+#include "runtime/utilities/stackvec.h"
+#include <mutex>
 
 namespace OCLRT {
 class Image;
@@ -138,6 +140,9 @@ class Image : public MemObj {
 
     Image *redescribe();
     Image *redescribeFillImage();
+    // Views cached on this image, released together with it. Caller owns one reference to the returned view.
+    Image *getRedescribedView();
+    Image *getRedescribedFillView();
     ImageCreatFunc createFunction;
 
     uint32_t getQPitch() { return qPitch; }
@@ -197,6 +202,17 @@ class Image : public MemObj {
                       void *src, size_t srcRowPitch, size_t srcSlicePitch,
                       std::array<size_t, 3> copyRegion, std::array<size_t, 3> copyOrigin);
 
+    const SurfaceFormatInfo *getRedescribedSurfaceFormat() const;
+    const SurfaceFormatInfo *getRedescribedFillSurfaceFormat() const;
+    Image *createRedescribedImage(const SurfaceFormatInfo *surfaceFormat);
+    Image *getCachedRedescribedImage(const SurfaceFormatInfo *surfaceFormat);
+    bool isRedescribedViewValid(Image *view) const;
+
+    struct RedescribedView {
+        const SurfaceFormatInfo *surfaceFormat;
+        Image *image;
+    };
+
     cl_image_format imageFormat;
     cl_image_desc imageDesc;
     SurfaceFormatInfo surfaceFormatInfo;
@@ -209,6 +225,8 @@ class Image : public MemObj {
     cl_uint mediaPlaneType;
     SurfaceOffsets surfaceOffsets;
     int mipLevel = 0;
+    StackVec<RedescribedView, 2> redescribedViews;
+    std::mutex redescribedViewsMtx;
 
     static bool isValidSingleChannelFormat(const cl_image_format *imageFormat);
     static bool isValidIntensityFormat(const cl_image_format *imageFormat);
@@ -21,6 +21,7 @@
  */
 
 #pragma once
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <vector>
@@ -124,12 +125,26 @@ class GraphicsAllocation : public IDNode<GraphicsAllocation> {
     void setLocked(bool locked) { this->locked = locked; }
     bool isLocked() const { return locked; }
 
+    // task counts of the latest tasks that read and wrote this allocation, used to detect hazards between tasks
+    uint32_t getHazardTaskCount(bool write) const { return write ? std::max(lastWriteTaskCount, lastReadTaskCount) : lastWriteTaskCount; }
+    void updateAccessTaskCount(uint32_t accessTaskCount, bool write) {
+        if (write) {
+            lastWriteTaskCount = accessTaskCount;
+        } else {
+            lastReadTaskCount = std::max(lastReadTaskCount, accessTaskCount);
+        }
+    }
+    uint32_t peekLastReadTaskCount() const { return lastReadTaskCount; }
+    uint32_t peekLastWriteTaskCount() const { return lastWriteTaskCount; }
+
     void incReuseCount() { reuseCount++; }
     void decReuseCount() { reuseCount--; }
     uint32_t peekReuseCount() const { return reuseCount; }
 
   private:
     int allocationType;
+    uint32_t lastReadTaskCount = 0;
+    uint32_t lastWriteTaskCount = 0;
 
     //this variable can only be modified from SubmissionAggregator
     friend class SubmissionAggregator;
@@ -31,6 +31,7 @@
 #include "runtime/command_stream/command_stream_receiver.h"
 #include "runtime/utilities/stackvec.h"
 #include "runtime/utilities/tag_allocator.h"
+#include "runtime/utilities/binary_tracer.h"
 #include "runtime/event/hw_timestamps.h"
 #include "runtime/event/perf_counter.h"
 
@@ -230,6 +231,8 @@ void MemoryManager::applyCommonCleanup() {
     if (perfCounterAllocator)
         perfCounterAllocator->cleanUpResources();
 
+    scratchSpacePool.reset();
+
     cleanAllocationList(-1, TEMPORARY_ALLOCATION);
     cleanAllocationList(-1, REUSABLE_ALLOCATION);
 }
@@ -273,6 +276,14 @@ TagAllocator<HwPerfCounter> *MemoryManager::getEventPerfCountAllocator() {
     return reinterpret_cast<TagAllocator<HwPerfCounter> *>(perfCounterAllocator.get());
 }
 
+ScratchSpacePool *MemoryManager::getScratchSpacePool() {
+    std::lock_guard<decltype(mtx)> lock(mtx);
+    if (scratchSpacePool.get() == nullptr) {
+        scratchSpacePool.reset(new ScratchSpacePool(this));
+    }
+    return scratchSpacePool.get();
+}
+
 void MemoryManager::pushAllocationForResidency(GraphicsAllocation *gfxAllocation) {
     residencyAllocations.push_back(gfxAllocation);
 }
@@ -290,6 +301,9 @@ void MemoryManager::clearEvictionAllocations() {
 }
 
 void MemoryManager::freeGraphicsMemory(GraphicsAllocation *gfxAllocation) {
+    if (gfxAllocation) {
+        globalTracer.record(TraceCategory::Memory, TracePhase::Instant, "freeGraphicsMemory", gfxAllocation->getUnderlyingBufferSize());
+    }
     freeGraphicsMemoryImpl(gfxAllocation);
 }
 //if not in use destroy in place
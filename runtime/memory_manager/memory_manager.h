@@ -24,6 +24,7 @@
 #include "runtime/memory_manager/host_ptr_defines.h"
 #include "runtime/memory_manager/host_ptr_manager.h"
 #include "runtime/memory_manager/graphics_allocation.h"
+#include "runtime/memory_manager/scratch_space_pool.h"
 #include "runtime/os_interface/32bit_memory.h"
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/utilities/tag_allocator_base.h"
@@ -103,6 +104,11 @@ class MemoryManager {
 
     virtual GraphicsAllocation *allocateGraphicsMemory64kb(size_t size, size_t alignment, bool forcePin) = 0;
 
+    // allocations created, CPU mapped and recycled by driver itself (command buffers, heaps, tags), never handed out to application
+    virtual GraphicsAllocation *allocateDriverInternalGraphicsMemory(size_t size, size_t alignment) {
+        return allocateGraphicsMemory(size, alignment);
+    }
+
     virtual GraphicsAllocation *allocateGraphicsMemory(size_t size, const void *ptr) {
         return MemoryManager::allocateGraphicsMemory(size, ptr, false);
     }
@@ -126,6 +132,9 @@ class MemoryManager {
 
     virtual bool mapAuxGpuVA(GraphicsAllocation *graphicsAllocation) { return false; };
 
+    // brings allocations to GPU accessible state ahead of first submission using them
+    virtual void prefetchAllocations(ResidencyContainer &allocations) {}
+
     virtual void *lockResource(GraphicsAllocation *graphicsAllocation) = 0;
     virtual void unlockResource(GraphicsAllocation *graphicsAllocation) = 0;
 
@@ -164,6 +173,9 @@ class MemoryManager {
     TagAllocator<HwTimeStamps> *getEventTsAllocator();
     TagAllocator<HwPerfCounter> *getEventPerfCountAllocator();
 
+    ScratchSpacePool *getScratchSpacePool();
+    ScratchSpacePool *peekScratchSpacePool() const { return scratchSpacePool.get(); }
+
     std::unique_ptr<GraphicsAllocation> obtainReusableAllocation(size_t requiredSize);
 
     //intrusive list of allocation
@@ -242,6 +254,7 @@ class MemoryManager {
     std::recursive_mutex mtx;
     std::unique_ptr<TagAllocatorBase> profilingTimeStampAllocator;
     std::unique_ptr<TagAllocatorBase> perfCounterAllocator;
+    std::unique_ptr<ScratchSpacePool> scratchSpacePool;
     bool force32bitAllocations = false;
     bool virtualPaddingAvailable = false;
     GraphicsAllocation *paddingAllocation = nullptr;
@@ -27,6 +27,7 @@
 #include "runtime/helpers/options.h"
 #include "runtime/helpers/ptr_math.h"
 #include "runtime/helpers/surface_formats.h"
+#include "runtime/utilities/binary_tracer.h"
 #include <cassert>
 
 namespace OCLRT {
@@ -39,6 +40,7 @@ struct OsHandle {
 };
 
 GraphicsAllocation *OsAgnosticMemoryManager::allocateGraphicsMemory(size_t size, size_t alignment, bool forcePin, bool uncacheable) {
+    globalTracer.record(TraceCategory::Memory, TracePhase::Instant, "allocateGraphicsMemory", size);
 
     auto sizeAligned = alignUp(size, MemoryConstants::pageSize);
     MemoryAllocation *memoryAllocation = nullptr;
@@ -70,6 +72,7 @@ GraphicsAllocation *OsAgnosticMemoryManager::allocateGraphicsMemory64kb(size_t s
 }
 
 GraphicsAllocation *OsAgnosticMemoryManager::allocate32BitGraphicsMemory(size_t size, void *ptr, MemoryType memoryType) {
+    globalTracer.record(TraceCategory::Memory, TracePhase::Instant, "allocate32BitGraphicsMemory", size);
     if (ptr) {
         auto allocationSize = alignSizeWholePage(reinterpret_cast<void *>(ptr), size);
         auto gpuVirtualAddress = allocator32Bit->allocate(allocationSize);
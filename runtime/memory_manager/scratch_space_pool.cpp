@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/memory_manager/scratch_space_pool.h"
+#include "runtime/memory_manager/graphics_allocation.h"
+#include "runtime/memory_manager/memory_constants.h"
+#include "runtime/memory_manager/memory_manager.h"
+
+namespace OCLRT {
+const size_t ScratchSpacePool::minSizeClass = MemoryConstants::pageSize64k;
+
+ScratchSpacePool::~ScratchSpacePool() {
+    for (auto &entry : pooled) {
+        memoryManager->freeGraphicsMemory(entry.allocation);
+    }
+    pooled.clear();
+}
+
+size_t ScratchSpacePool::getSizeClass(size_t requiredSize) {
+    size_t sizeClass = minSizeClass;
+    while (sizeClass < requiredSize) {
+        sizeClass <<= 1;
+    }
+    return sizeClass;
+}
+
+GraphicsAllocation *ScratchSpacePool::obtain(size_t requiredSize) {
+    auto sizeClass = getSizeClass(requiredSize);
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (auto it = pooled.begin(); it != pooled.end(); it++) {
+            if (it->allocation->getUnderlyingBufferSize() == sizeClass && it->isIdle()) {
+                auto allocation = it->allocation;
+                pooled.erase(it);
+                return allocation;
+            }
+        }
+        createdCount++;
+    }
+    return memoryManager->createGraphicsAllocationWithRequiredBitness(sizeClass, nullptr);
+}
+
+void ScratchSpacePool::retire(GraphicsAllocation *allocation, uint32_t taskCount, volatile uint32_t *tagAddress) {
+    std::unique_lock<std::mutex> lock(mtx);
+    if (pooled.size() >= maxPooledAllocations) {
+        // make room by dropping the oldest idle allocation, busy ones are left for the receiver to free
+        for (auto it = pooled.begin(); it != pooled.end(); it++) {
+            if (it->isIdle()) {
+                auto evicted = it->allocation;
+                pooled.erase(it);
+                lock.unlock();
+                memoryManager->freeGraphicsMemory(evicted);
+                lock.lock();
+                break;
+            }
+        }
+    }
+    if (pooled.size() >= maxPooledAllocations) {
+        lock.unlock();
+        allocation->taskCount = taskCount;
+        memoryManager->storeAllocation(std::unique_ptr<GraphicsAllocation>(allocation), TEMPORARY_ALLOCATION);
+        return;
+    }
+    pooled.push_back({allocation, taskCount, tagAddress});
+}
+
+void ScratchSpacePool::releaseTagAddress(volatile uint32_t *tagAddress) {
+    std::lock_guard<std::mutex> lock(mtx);
+    for (auto &entry : pooled) {
+        if (entry.tagAddress == tagAddress) {
+            entry.tagAddress = nullptr;
+        }
+    }
+}
+
+size_t ScratchSpacePool::peekPooledCount() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return pooled.size();
+}
+} // namespace OCLRT
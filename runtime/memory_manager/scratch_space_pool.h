@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace OCLRT {
+class GraphicsAllocation;
+class MemoryManager;
+
+// Scratch allocations of command stream receivers, sized in power-of-two classes.
+// Retired allocations are kept here until a receiver needs the same class again,
+// so alternating scratch requirements do not allocate and free on every switch.
+class ScratchSpacePool {
+  public:
+    static const size_t minSizeClass;
+    static const size_t defaultMaxPooledAllocations = 4;
+
+    ScratchSpacePool(MemoryManager *memoryManager) : memoryManager(memoryManager) {}
+    ~ScratchSpacePool();
+
+    static size_t getSizeClass(size_t requiredSize);
+
+    GraphicsAllocation *obtain(size_t requiredSize);
+    // allocation stays untouched until *tagAddress passes taskCount, no tagAddress means it is idle already
+    void retire(GraphicsAllocation *allocation, uint32_t taskCount, volatile uint32_t *tagAddress);
+    // called by a receiver that waited for all of its work, its retired allocations become idle
+    void releaseTagAddress(volatile uint32_t *tagAddress);
+
+    size_t peekPooledCount();
+    size_t peekCreatedCount() const { return createdCount; }
+    void setMaxPooledAllocations(size_t count) { maxPooledAllocations = count; }
+
+  protected:
+    struct PooledScratch {
+        GraphicsAllocation *allocation;
+        uint32_t taskCount;
+        volatile uint32_t *tagAddress;
+
+        bool isIdle() const { return tagAddress == nullptr || *tagAddress >= taskCount; }
+    };
+
+    MemoryManager *memoryManager;
+    std::mutex mtx;
+    std::vector<PooledScratch> pooled;
+    size_t maxPooledAllocations = defaultMaxPooledAllocations;
+    size_t createdCount = 0;
+};
+} // namespace OCLRT
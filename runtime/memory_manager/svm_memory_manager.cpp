@@ -23,10 +23,23 @@
 #include "runtime/memory_manager/memory_manager.h"
 #include "runtime/memory_manager/svm_memory_manager.h"
 #include "runtime/helpers/aligned_memory.h"
+#include "runtime/helpers/debug_helpers.h"
+#include "runtime/helpers/ptr_math.h"
 #include "runtime/command_stream/command_stream_receiver.h"
 
+#include <algorithm>
+#include <thread>
+
 namespace OCLRT {
 
+namespace {
+// slots are handed out round robin, thread ids may hash to the same slot when their stacks are equally aligned
+std::atomic<size_t> readerSlotCounter{0};
+thread_local size_t readerSlotIndex = readerSlotCounter++;
+} // namespace
+
+const size_t SVMAllocsManager::SortedArrayAllocationTracker::readerSlotCount;
+
 void SVMAllocsManager::MapBasedAllocationTracker::insert(GraphicsAllocation &ga) {
     allocs.insert(std::make_pair(ga.getUnderlyingBuffer(), &ga));
 }
@@ -61,6 +74,92 @@ GraphicsAllocation *SVMAllocsManager::MapBasedAllocationTracker::get(const void
     return nullptr;
 }
 
+SVMAllocsManager::SortedArrayAllocationTracker::SortedArrayAllocationTracker() : ranges(new AllocationRanges), numAllocs(0), epoch(0) {
+    for (auto &slot : readerSlots) {
+        slot.readers[0] = 0;
+        slot.readers[1] = 0;
+    }
+}
+
+SVMAllocsManager::SortedArrayAllocationTracker::~SortedArrayAllocationTracker() {
+    delete ranges.load();
+}
+
+void SVMAllocsManager::SortedArrayAllocationTracker::insert(GraphicsAllocation &ga) {
+    AllocationRange range = {ga.getUnderlyingBuffer(), ga.getUnderlyingBufferSize(), &ga};
+    auto newRanges = new AllocationRanges();
+    auto currentRanges = ranges.load();
+    newRanges->reserve(currentRanges->size() + 1);
+    *newRanges = *currentRanges;
+    auto position = std::upper_bound(newRanges->begin(), newRanges->end(), range.base, [](const void *address, const AllocationRange &r) { return address < r.base; });
+    newRanges->insert(position, range);
+    publish(newRanges);
+}
+
+void SVMAllocsManager::SortedArrayAllocationTracker::remove(GraphicsAllocation &ga) {
+    auto newRanges = new AllocationRanges(*ranges.load());
+    auto position = std::find_if(newRanges->begin(), newRanges->end(), [&ga](const AllocationRange &r) { return r.allocation == &ga; });
+    DEBUG_BREAK_IF(position == newRanges->end());
+    if (position != newRanges->end()) {
+        newRanges->erase(position);
+    }
+    publish(newRanges);
+}
+
+GraphicsAllocation *SVMAllocsManager::SortedArrayAllocationTracker::get(const void *ptr) {
+    if (ptr == nullptr)
+        return nullptr;
+
+    auto &slot = readerSlots[getReaderSlotIndex()];
+    uint32_t readerEpoch;
+    while (true) {
+        readerEpoch = epoch;
+        slot.readers[readerEpoch & 1]++;
+        if (epoch == readerEpoch) {
+            break;
+        }
+        slot.readers[readerEpoch & 1]--;
+    }
+
+    GraphicsAllocation *GA = nullptr;
+    auto currentRanges = ranges.load();
+    auto position = std::upper_bound(currentRanges->begin(), currentRanges->end(), ptr, [](const void *address, const AllocationRange &r) { return address < r.base; });
+    if (position != currentRanges->begin()) {
+        position--;
+        if (ptr < ptrOffset(position->base, position->size)) {
+            GA = position->allocation;
+        }
+    }
+
+    slot.readers[readerEpoch & 1]--;
+    return GA;
+}
+
+void SVMAllocsManager::SortedArrayAllocationTracker::publish(AllocationRanges *newRanges) {
+    auto oldRanges = ranges.exchange(newRanges);
+    numAllocs = newRanges->size();
+
+    // readers entering from now on see newRanges, only the ones of the closed epoch may still use oldRanges
+    auto closedEpoch = epoch++;
+    while (hasReaders(closedEpoch)) {
+        std::this_thread::yield();
+    }
+    delete oldRanges;
+}
+
+bool SVMAllocsManager::SortedArrayAllocationTracker::hasReaders(uint32_t closedEpoch) const {
+    for (auto &slot : readerSlots) {
+        if (slot.readers[closedEpoch & 1] != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t SVMAllocsManager::SortedArrayAllocationTracker::getReaderSlotIndex() {
+    return readerSlotIndex % readerSlotCount;
+}
+
 SVMAllocsManager::SVMAllocsManager(MemoryManager *memoryManager) : memoryManager(memoryManager) {
 }
 
@@ -79,14 +178,13 @@ void *SVMAllocsManager::createSVMAlloc(size_t size, bool coherent) {
 }
 
 GraphicsAllocation *SVMAllocsManager::getSVMAlloc(const void *ptr) {
-    std::unique_lock<std::mutex> lock(mtx);
     return SVMAllocs.get(ptr);
 }
 
 void SVMAllocsManager::freeSVMAlloc(void *ptr) {
-    GraphicsAllocation *GA = getSVMAlloc(ptr);
+    std::unique_lock<std::mutex> lock(mtx);
+    GraphicsAllocation *GA = SVMAllocs.get(ptr);
     if (GA) {
-        std::unique_lock<std::mutex> lock(mtx);
         SVMAllocs.remove(*GA);
         memoryManager->freeGraphicsMemory(GA);
     }
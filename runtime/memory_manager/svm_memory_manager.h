@@ -21,9 +21,11 @@
  */
 
 #pragma once
+#include <atomic>
 #include <cstdint>
 #include <map>
 #include <mutex>
+#include <vector>
 
 namespace OCLRT {
 class Device;
@@ -44,6 +46,43 @@ class SVMAllocsManager {
         std::map<const void *, GraphicsAllocation *> allocs;
     };
 
+    // Sorted array of allocation ranges republished as a new copy on every change. Readers look up
+    // without locking, they only announce themselves in the current epoch's counter of their own slot;
+    // a writer frees the replaced array once the readers of the epoch it closed are gone from all slots.
+    // insert and remove have to be serialized by the caller.
+    class SortedArrayAllocationTracker {
+      public:
+        SortedArrayAllocationTracker();
+        ~SortedArrayAllocationTracker();
+        void insert(GraphicsAllocation &);
+        void remove(GraphicsAllocation &);
+        GraphicsAllocation *get(const void *);
+        size_t getNumAllocs() const { return numAllocs; };
+
+      protected:
+        struct AllocationRange {
+            const void *base;
+            size_t size;
+            GraphicsAllocation *allocation;
+        };
+        using AllocationRanges = std::vector<AllocationRange>;
+
+        // each slot sits on its own cache line, so readers on different threads do not share a counter
+        struct alignas(64) ReaderSlot {
+            std::atomic<uint32_t> readers[2];
+        };
+        static const size_t readerSlotCount = 64;
+
+        void publish(AllocationRanges *newRanges);
+        bool hasReaders(uint32_t closedEpoch) const;
+        static size_t getReaderSlotIndex();
+
+        std::atomic<AllocationRanges *> ranges;
+        std::atomic<size_t> numAllocs;
+        std::atomic<uint32_t> epoch;
+        ReaderSlot readerSlots[readerSlotCount];
+    };
+
     SVMAllocsManager(MemoryManager *memoryManager);
     void *createSVMAlloc(size_t size, bool coherent = false);
     GraphicsAllocation *getSVMAlloc(const void *ptr);
@@ -51,7 +90,7 @@ class SVMAllocsManager {
     size_t getNumAllocs() const { return SVMAllocs.getNumAllocs(); }
 
   protected:
-    MapBasedAllocationTracker SVMAllocs;
+    SortedArrayAllocationTracker SVMAllocs;
     MemoryManager *memoryManager;
     std::mutex mtx;
 };
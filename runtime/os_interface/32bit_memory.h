@@ -21,7 +21,9 @@
  */
 
 #pragma once
+#include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/utilities/heap_allocator.h"
+#include "runtime/utilities/tlsf_heap_allocator.h"
 #include <stdint.h>
 #include <memory>
 
@@ -43,8 +45,27 @@ class Allocator32bit {
     int free(void *ptr, size_t size);
 
   protected:
+    void createHeapAllocator(void *heapBase, uint64_t heapSize) {
+        if (DebugManager.flags.UseTlsfHeapAllocator.get()) {
+            tlsfHeapAllocator = std::unique_ptr<TlsfHeapAllocator>(new TlsfHeapAllocator(heapBase, heapSize));
+        } else {
+            heapAllocator = std::unique_ptr<HeapAllocator>(new HeapAllocator(heapBase, heapSize));
+        }
+    }
+    void *allocateFromHeap(size_t &sizeToAllocate) {
+        return tlsfHeapAllocator ? tlsfHeapAllocator->allocate(sizeToAllocate) : heapAllocator->allocate(sizeToAllocate);
+    }
+    void freeToHeap(void *ptr, size_t sizeToFree) {
+        if (tlsfHeapAllocator) {
+            tlsfHeapAllocator->free(ptr, sizeToFree);
+        } else {
+            heapAllocator->free(ptr, sizeToFree);
+        }
+    }
+
     std::unique_ptr<OsInternals> osInternals;
     std::unique_ptr<HeapAllocator> heapAllocator;
+    std::unique_ptr<TlsfHeapAllocator> tlsfHeapAllocator;
     uint64_t base = 0;
     uint64_t size = 0;
 };
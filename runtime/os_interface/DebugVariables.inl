@@ -36,6 +36,7 @@ DECLARE_DEBUG_VARIABLE(bool, DumpKernels, false, "Enables dumping kernels' progr
 DECLARE_DEBUG_VARIABLE(bool, DumpKernelArgs, false, "Enables dumping kernels args to binary files")
 DECLARE_DEBUG_VARIABLE(bool, LogApiCalls, false, "Enables logging api function calls, inputs and outputs to file")
 DECLARE_DEBUG_VARIABLE(bool, LogPatchTokens, false, "Enables logging patch tokens, inputs and outputs to file")
+DECLARE_DEBUG_VARIABLE(std::string, BinaryTraceFileName, "unk", "Enables low overhead tracing of api calls, flushes, waits and allocations, written to given file in Chrome trace JSON format")
 DECLARE_DEBUG_VARIABLE(bool, LogTaskCounts, false, "Enables logging taskCounts and taskLevels to file")
 DECLARE_DEBUG_VARIABLE(bool, LogAlignedAllocations, false, "Logs alignedMalloc and alignedFree allocations")
 DECLARE_DEBUG_VARIABLE(bool, LogMemoryObject, false, "Logs memory object ptrs, sizes and operations")
@@ -52,6 +53,11 @@ DECLARE_DEBUG_VARIABLE(bool, Force32bitAddressing, false, "Forces 32 bit address
 DECLARE_DEBUG_VARIABLE(bool, DisableStatelessToStatefulOptimization, false, "Disables stateless to stateful optimization for buffers")
 DECLARE_DEBUG_VARIABLE(bool, DisableConcurrentBlockExecution, 0, "disables concurrent block kernel execution")
 DECLARE_DEBUG_VARIABLE(bool, UseNewHeapAllocator, true, "Custom 4GB heap allocator is used")
+DECLARE_DEBUG_VARIABLE(bool, UseTlsfHeapAllocator, false, "32 bit heap is managed by two-level segregated fit allocator with constant time allocate and free")
+DECLARE_DEBUG_VARIABLE(int32_t, OverrideGpuTimestampCalibrationIntervalMs, -1, "-1: default, 0: read GPU timestamp on every query, >0: interval in ms between GPU timestamp calibrations, queries in between are interpolated on CPU")
+DECLARE_DEBUG_VARIABLE(bool, EnableBindingTableCache, false, "Reuses binding table and surface states already pushed to surface state heap when kernel's SSH did not change since last enqueue")
+DECLARE_DEBUG_VARIABLE(bool, EnableDispatchTemplates, false, "Records work group size, local IDs and walker of single kernel dispatch and replays them with relocated heap offsets on identical enqueues")
+DECLARE_DEBUG_VARIABLE(bool, EnableImageLayoutCache, false, "Reuses GMM image layout queried for previously created image with identical descriptor, format and flags")
 DECLARE_DEBUG_VARIABLE(bool, UseNoRingFlushesKmdMode, true, "Windows only, passes flag to KMD that informs KMD to not emit any ring buffer flushes.")
 /*SIMULATION FLAGS*/
 DECLARE_DEBUG_VARIABLE(int32_t, SetCommandStreamReceiver, 0, "Set command stream receiver")
@@ -70,14 +76,25 @@ DECLARE_DEBUG_VARIABLE(bool, EnableStatelessToStatefulBufferOffsetOpt, false, "T
 DECLARE_DEBUG_VARIABLE(bool, EnableDeferredDeleter, true, "Enables async deleter")
 DECLARE_DEBUG_VARIABLE(bool, EnableAsyncDestroyAllocations, true, "Enables async destroying graphics allocations in mem obj destructor")
 DECLARE_DEBUG_VARIABLE(bool, EnableAsyncEventsHandler, true, "Enables async events handler")
+DECLARE_DEBUG_VARIABLE(bool, EnableAsyncPrintfOutput, false, "Formats printf output of blocking enqueues on background thread, output is printed in submission order after enqueue returns")
 DECLARE_DEBUG_VARIABLE(bool, EnableForcePin, true, "Enables early pinning for memory object")
 DECLARE_DEBUG_VARIABLE(int32_t, Enable64kbpages, -1, "-1: default behaviour, 0 Disables, 1 Enables support for 64KB pages for driver allocated fine grain svm buffers")
+DECLARE_DEBUG_VARIABLE(bool, EnableHugePageAllocations, false, "Linux only, backs 64KB page allocations of at least 2MB with 2MB aligned mappings advised for transparent huge pages, falls back to regular pages when not available")
+DECLARE_DEBUG_VARIABLE(bool, EnableGemCreateForInternalAllocations, false, "Linux only, backs command buffers, heaps and tags with GEM_CREATE objects mapped by GEM_MMAP instead of userptr objects")
+DECLARE_DEBUG_VARIABLE(bool, EnableExecOutFence, false, "Linux only, requests an out-fence for every execbuffer and sleeps on its sync file when waiting for a flush stamp instead of calling GEM_WAIT on the batch buffer")
+DECLARE_DEBUG_VARIABLE(bool, EnableGpuVirtualAddressHeap, false, "Linux only, soft pins images, imported and padded objects at addresses suballocated from one reserved virtual range instead of a separate mmap per object")
 DECLARE_DEBUG_VARIABLE(bool, EnableComputeWorkSizeND, true, "Enables diffrent algorithm to compute local work size")
 DECLARE_DEBUG_VARIABLE(bool, EnableComputeWorkSizeSquared, false, "Enables algorithm to compute the most squared work group as possible")
 DECLARE_DEBUG_VARIABLE(int32_t, OverrideEnableKmdNotify, -1, "-1: dont override, 0: disable, 1: enable")
 DECLARE_DEBUG_VARIABLE(int32_t, OverrideKmdNotifyDelayMicroseconds, -1, "-1: dont override, 0: infinite timeout, >0: timeout in microseconds")
 DECLARE_DEBUG_VARIABLE(bool, EnableVaLibCalls, true, "Enable cl-va sharing lib calls")
 DECLARE_DEBUG_VARIABLE(int32_t, CsrDispatchMode, 0, "Chooses DispatchMode for Csr")
+DECLARE_DEBUG_VARIABLE(bool, EnableBatchedPipeControlElimination, false, "In batched dispatch mode, noops stalling pipe controls between command buffers that do not share allocations")
+DECLARE_DEBUG_VARIABLE(bool, EnableResourceDependencyTracking, false, "Emits dependency pipe control only on read/write hazards between tasks instead of on every taskLevel increase")
+DECLARE_DEBUG_VARIABLE(bool, EnableSharedIndirectHeaps, false, "Command queues of a device suballocate indirect heaps from large heaps owned by command stream receiver, which keeps state base addresses constant across queues")
+DECLARE_DEBUG_VARIABLE(bool, EnableCommandStreamRing, false, "Full command streams move to fixed size segments recycled in ring order instead of reallocating")
+DECLARE_DEBUG_VARIABLE(bool, EnableScratchSpaceManagement, false, "Scratch allocations are sized in power-of-two classes, kept in a memory manager pool for reuse when replaced and shrunk when tasks stop needing them")
+DECLARE_DEBUG_VARIABLE(int32_t, ScratchSpaceShrinkPeriod, 64, "With EnableScratchSpaceManagement, number of flushed tasks without a kernel needing the current scratch size class before scratch is shrunk, 0: never shrink")
 /*DRIVER TOGGLES*/
 DECLARE_DEBUG_VARIABLE(int32_t, ForceOCLVersion, 0, "Force specific OpenCL API version")
 DECLARE_DEBUG_VARIABLE(int32_t, ForcePreemptionMode, -1, "Keep this variable in sync with PreemptionMode enum. -1 - devices default mode, 1 - disable, 2 - midBatch, 3 - threadGroup, 4 - midThread")
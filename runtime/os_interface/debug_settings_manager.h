@@ -265,16 +265,21 @@ class DebugSettingsManager {
 
 extern DebugSettingsManager<globalDebugFunctionalityLevel> DebugManager;
 
+// records API enter and leave in the binary tracer, defined with it to keep its header out of here
+void traceApiCall(const char *funcName, bool enter);
+
 template <bool Enabled>
 class DebugSettingsApiEnterWrapper {
   public:
     DebugSettingsApiEnterWrapper(const char *funcName, const int *errorCode)
         : funcName(funcName), errorCode(errorCode) {
+        traceApiCall(funcName, true);
         if (Enabled) {
             DebugManager.logApiCall(funcName, true, 0);
         }
     }
     ~DebugSettingsApiEnterWrapper() {
+        traceApiCall(funcName, false);
         if (Enabled) {
             DebugManager.logApiCall(funcName, false, (errorCode != nullptr) ? *errorCode : 0);
         }
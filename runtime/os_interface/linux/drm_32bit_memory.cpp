@@ -96,7 +96,7 @@ bool OCLRT::is32BitOsAllocatorAvailable = true;
 Allocator32bit::Allocator32bit(uint64_t base, uint64_t size) {
     this->base = base;
     this->size = size;
-    heapAllocator = std::unique_ptr<HeapAllocator>(new HeapAllocator((void *)base, size));
+    createHeapAllocator((void *)base, size);
 }
 
 OCLRT::Allocator32bit::Allocator32bit() : Allocator32bit(new OsInternals) {
@@ -133,7 +133,7 @@ OCLRT::Allocator32bit::Allocator32bit(Allocator32bit::OsInternals *osInternalsIn
         base = (uint64_t)ptr;
         size = sizeToMap;
 
-        heapAllocator = std::unique_ptr<HeapAllocator>(new HeapAllocator(ptr, sizeToMap));
+        createHeapAllocator(ptr, sizeToMap);
     } else {
         this->osInternals->drmAllocator = new Allocator32bit::OsInternals::Drm32BitAllocator(*this->osInternals);
     }
@@ -152,7 +152,7 @@ OCLRT::Allocator32bit::~Allocator32bit() {
 void *OCLRT::Allocator32bit::allocate(size_t &size) {
     void *ptr = nullptr;
     if (DebugManager.flags.UseNewHeapAllocator.get()) {
-        ptr = this->heapAllocator->allocate(size);
+        ptr = allocateFromHeap(size);
     } else {
         ptr = this->osInternals->drmAllocator->allocate(size);
     }
@@ -164,7 +164,7 @@ int Allocator32bit::free(void *ptr, size_t size) {
         return 0;
 
     if (DebugManager.flags.UseNewHeapAllocator.get()) {
-        this->heapAllocator->free(ptr, size);
+        freeToHeap(ptr, size);
     } else {
         return this->osInternals->drmAllocator->free(ptr, size);
     }
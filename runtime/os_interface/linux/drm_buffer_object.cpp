@@ -26,6 +26,7 @@
 #include "runtime/os_interface/linux/drm_memory_manager.h"
 #include "runtime/os_interface/linux/drm_neo.h"
 #include "runtime/os_interface/linux/os_time.h"
+#include "runtime/utilities/binary_tracer.h"
 #include "runtime/utilities/stackvec.h"
 
 #include <sys/syscall.h>
@@ -151,7 +152,7 @@ void BufferObject::processRelocs(int &idx) {
     }
 }
 
-int BufferObject::exec(uint32_t used, size_t startOffset, unsigned int flags, bool requiresCoherency, bool lowPriority) {
+int BufferObject::exec(uint32_t used, size_t startOffset, unsigned int flags, bool requiresCoherency, uint32_t drmContextId, int *outFenceFd) {
     drm_i915_gem_execbuffer2 execbuf;
 
     int idx = 0;
@@ -169,16 +170,35 @@ int BufferObject::exec(uint32_t used, size_t startOffset, unsigned int flags, bo
     if (drm->peekCoherencyDisablePatchActive() && !requiresCoherency) {
         execbuf.flags = execbuf.flags | I915_PRIVATE_EXEC_FORCE_NON_COHERENT;
     }
-    if (lowPriority) {
-        execbuf.rsvd1 = this->drm->lowPriorityContextId & I915_EXEC_CONTEXT_ID_MASK;
+    execbuf.rsvd1 = drmContextId & I915_EXEC_CONTEXT_ID_MASK;
+
+    unsigned long request = DRM_IOCTL_I915_GEM_EXECBUFFER2;
+    if (outFenceFd) {
+        // kernel returns the sync file fd in upper half of rsvd2, which requires the WR variant
+        execbuf.flags |= I915_EXEC_FENCE_OUT;
+        request = DRM_IOCTL_I915_GEM_EXECBUFFER2_WR;
     }
 
-    int ret = this->drm->ioctl(DRM_IOCTL_I915_GEM_EXECBUFFER2, &execbuf);
+    globalTracer.record(TraceCategory::Os, TracePhase::Begin, "execbuffer2", used);
+    int ret = this->drm->ioctl(request, &execbuf);
+    if (ret != 0 && outFenceFd) {
+        // e.g. out of file descriptors, submit without a fence and let the caller wait on the BO
+        int err = errno;
+        printDebugString(DebugManager.flags.PrintDebugMessages.get(), stderr, "ioctl(I915_GEM_EXECBUFFER2_WR) with out-fence failed with %d. errno=%d(%s)\n", ret, err, strerror(err));
+        execbuf.flags &= ~static_cast<__u64>(I915_EXEC_FENCE_OUT);
+        *outFenceFd = -1;
+        outFenceFd = nullptr;
+        ret = this->drm->ioctl(DRM_IOCTL_I915_GEM_EXECBUFFER2, &execbuf);
+    }
+    globalTracer.record(TraceCategory::Os, TracePhase::End, "execbuffer2", 0);
     if (ret != 0) {
         int err = errno;
         printDebugString(DebugManager.flags.PrintDebugMessages.get(), stderr, "ioctl(I915_GEM_EXECBUFFER2) failed with %d. errno=%d(%s)\n", ret, err, strerror(err));
         UNRECOVERABLE_IF(true);
     }
+    if (outFenceFd) {
+        *outFenceFd = static_cast<int>(execbuf.rsvd2 >> 32);
+    }
 
     return ret;
 }
@@ -42,6 +42,7 @@ enum StorageAllocatorType {
     MMAP_ALLOCATOR,
     BIT32_ALLOCATOR_EXTERNAL,
     BIT32_ALLOCATOR_INTERNAL,
+    GPU_VA_HEAP_ALLOCATOR,
     MALLOC_ALLOCATOR,
     EXTERNAL_ALLOCATOR,
     UNKNOWN_ALLOCATOR
@@ -60,7 +61,7 @@ class BufferObject {
 
     int pin(BufferObject *boToPin[], size_t numberOfBos);
 
-    int exec(uint32_t used, size_t startOffset, unsigned int flags, bool requiresCoherency = false, bool lowPriority = false);
+    int exec(uint32_t used, size_t startOffset, unsigned int flags, bool requiresCoherency = false, uint32_t drmContextId = 0, int *outFenceFd = nullptr);
 
     int wait(int64_t timeoutNs);
     bool close();
@@ -23,6 +23,8 @@
 #pragma once
 #include "runtime/command_stream/device_command_stream.h"
 #include "runtime/os_interface/linux/drm_gem_close_worker.h"
+#include <deque>
+#include <mutex>
 #include <vector>
 extern "C" {
 #include "drm/i915_drm.h"
@@ -49,6 +51,7 @@ class DrmCommandStreamReceiver : public DeviceCommandStreamReceiver<GfxFamily> {
     // When drm is null default implementation is used. In this case DrmCommandStreamReceiver is responsible to free drm.
     // When drm is passed, DCSR will not free it at destruction
     DrmCommandStreamReceiver(const HardwareInfo &hwInfoIn, Drm *drm, gemCloseWorkerMode mode = gemCloseWorkerMode::gemCloseWorkerInactive);
+    ~DrmCommandStreamReceiver() override;
 
     FlushStamp flush(BatchBuffer &batchBuffer, EngineType engineType, ResidencyContainer *allocationsForResidency) override;
     void makeResident(GraphicsAllocation &gfxAllocation) override;
@@ -57,6 +60,12 @@ class DrmCommandStreamReceiver : public DeviceCommandStreamReceiver<GfxFamily> {
     bool waitForFlushStamp(FlushStamp &flushStampToWait) override;
     void overrideMediaVFEStateDirty(bool dirty) override;
 
+    // flush stamps of execbuffers submitted with an out-fence, BO handles otherwise
+    static const FlushStamp outFenceFlushStampBit = 1ull << 63;
+    static const size_t maxOutstandingOutFences = 64;
+    static bool isOutFenceFlushStamp(FlushStamp flushStamp) { return (flushStamp & outFenceFlushStampBit) != 0; }
+    bool isOutFenceEnabled() const { return outFenceEnabled; }
+
     DrmMemoryManager *getMemoryManager();
     MemoryManager *createMemoryManager(bool enable64kbPages) override;
 
@@ -67,11 +76,22 @@ class DrmCommandStreamReceiver : public DeviceCommandStreamReceiver<GfxFamily> {
   protected:
     void makeResident(BufferObject *bo);
     void programVFEState(LinearStream &csr, DispatchFlags &dispatchFlags) override;
+    void retireOutFences();
+
+    struct OutFence {
+        FlushStamp flushStamp;
+        int fd;
+        uint32_t waiters;
+    };
 
     std::vector<BufferObject *> residency;
     std::vector<drm_i915_gem_exec_object2> execObjectsStorage;
     Drm *drm;
     gemCloseWorkerMode gemCloseWorkerOperationMode;
     bool mediaVfeStateLowPriorityDirty = true;
+    bool outFenceEnabled = false;
+    FlushStamp lastOutFenceFlushStamp = outFenceFlushStampBit;
+    std::deque<OutFence> outFences;
+    std::mutex outFencesMutex;
 };
 } // namespace OCLRT
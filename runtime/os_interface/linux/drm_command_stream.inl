@@ -31,6 +31,7 @@
 #include "runtime/os_interface/linux/drm_memory_manager.h"
 #include "runtime/os_interface/linux/drm_neo.h"
 #include "runtime/os_interface/linux/os_interface.h"
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 
@@ -43,8 +44,22 @@ DrmCommandStreamReceiver<GfxFamily>::DrmCommandStreamReceiver(const HardwareInfo
     this->drm = drm ? drm : Drm::get(0);
     residency.reserve(512);
     execObjectsStorage.reserve(512);
+    if (mode == gemCloseWorkerMode::gemCloseWorkerConsumingCommandBuffers) {
+        //consumed command buffers are released by gem close worker, they cannot be recycled in ring
+        this->commandStreamRingEnabled = false;
+    }
     CommandStreamReceiver::osInterface = std::unique_ptr<OSInterface>(new OSInterface());
     CommandStreamReceiver::osInterface.get()->get()->setDrm(this->drm);
+    // flush stamps are only slept on in the KMD notify fallback, without it waits poll the tag and a fence would go unused
+    outFenceEnabled = DebugManager.flags.EnableExecOutFence.get() && this->drm->isExecFenceSupported() && hwInfoIn.capabilityTable.enableKmdNotify;
+}
+
+template <typename GfxFamily>
+DrmCommandStreamReceiver<GfxFamily>::~DrmCommandStreamReceiver() {
+    for (auto &outFence : outFences) {
+        drm->closeOutFence(outFence.fd);
+    }
+    outFences.clear();
 }
 
 template <typename GfxFamily>
@@ -73,10 +88,29 @@ FlushStamp DrmCommandStreamReceiver<GfxFamily>::flush(BatchBuffer &batchBuffer,
         bb->setExecObjectsStorage(this->execObjectsStorage.data());
         this->residency.reserve(512);
 
+        // tag and taskLevel ordering is tracked per CSR, so queues share one context per priority
+        auto drmContextId = batchBuffer.low_priority ? drm->lowPriorityContextId : 0u;
+
+        int outFenceFd = -1;
+        bool requestOutFence = false;
+        if (outFenceEnabled) {
+            retireOutFences();
+            // past the cap the batch buffer handle is returned and waits fall back to GEM_WAIT
+            std::lock_guard<std::mutex> lock(outFencesMutex);
+            requestOutFence = outFences.size() < maxOutstandingOutFences;
+        }
+
         bb->exec(static_cast<uint32_t>(alignUp(batchBuffer.usedSize - batchBuffer.startOffset, 8)),
                  alignedStart, engineFlag | I915_EXEC_NO_RELOC,
                  batchBuffer.requiresCoherency,
-                 batchBuffer.low_priority);
+                 drmContextId,
+                 requestOutFence ? &outFenceFd : nullptr);
+
+        if (outFenceFd >= 0) {
+            std::lock_guard<std::mutex> lock(outFencesMutex);
+            flushStamp = ++lastOutFenceFlushStamp;
+            outFences.push_back({flushStamp, outFenceFd, 0u});
+        }
 
         if (this->gemCloseWorkerOperationMode == gemCloseWorkerMode::gemCloseWorkerConsumingCommandBuffers) {
             // Consume all space in CS to force new allocation
@@ -161,20 +195,60 @@ DrmMemoryManager *DrmCommandStreamReceiver<GfxFamily>::getMemoryManager() {
 
 template <typename GfxFamily>
 MemoryManager *DrmCommandStreamReceiver<GfxFamily>::createMemoryManager(bool enable64kbPages) {
-    memoryManager = new DrmMemoryManager(this->drm, this->gemCloseWorkerOperationMode, DebugManager.flags.EnableForcePin.get(), true);
+    memoryManager = new DrmMemoryManager(this->drm, this->gemCloseWorkerOperationMode, DebugManager.flags.EnableForcePin.get(), true, enable64kbPages);
     return memoryManager;
 }
 
 template <typename GfxFamily>
 bool DrmCommandStreamReceiver<GfxFamily>::waitForFlushStamp(FlushStamp &flushStamp) {
+    if (isOutFenceFlushStamp(flushStamp)) {
+        std::unique_lock<std::mutex> lock(outFencesMutex);
+        auto outFence = std::find_if(outFences.begin(), outFences.end(), [&](const OutFence &fence) { return fence.flushStamp == flushStamp; });
+        if (outFence == outFences.end()) {
+            // retired fences have already signaled
+            return true;
+        }
+        // waiters keep the fd open, retirement only closes fences nobody polls
+        outFence->waiters++;
+        auto fd = outFence->fd;
+        lock.unlock();
+
+        auto signaled = drm->waitOutFence(fd, -1);
+
+        lock.lock();
+        outFence = std::find_if(outFences.begin(), outFences.end(), [&](const OutFence &fence) { return fence.flushStamp == flushStamp; });
+        outFence->waiters--;
+        lock.unlock();
+
+        // a CSR that stops flushing after a wait would otherwise keep its fds open until destruction
+        retireOutFences();
+        return signaled;
+    }
+
     drm_i915_gem_wait wait = {};
     wait.bo_handle = static_cast<uint32_t>(flushStamp);
     wait.timeout_ns = -1;
 
     drm->ioctl(DRM_IOCTL_I915_GEM_WAIT, &wait);
+    if (outFenceEnabled) {
+        retireOutFences();
+    }
     return true;
 }
 
+template <typename GfxFamily>
+void DrmCommandStreamReceiver<GfxFamily>::retireOutFences() {
+    std::lock_guard<std::mutex> lock(outFencesMutex);
+    while (!outFences.empty()) {
+        auto &outFence = outFences.front();
+        if (outFence.waiters != 0 || !drm->waitOutFence(outFence.fd, 0)) {
+            break;
+        }
+        drm->closeOutFence(outFence.fd);
+        outFences.pop_front();
+    }
+}
+
 template <typename GfxFamily>
 inline void DrmCommandStreamReceiver<GfxFamily>::overrideMediaVFEStateDirty(bool dirty) {
     this->mediaVfeStateDirty = dirty;
@@ -27,7 +27,9 @@
 #include "runtime/os_interface/linux/drm_allocation.h"
 #include "runtime/os_interface/linux/drm_buffer_object.h"
 #include "runtime/os_interface/linux/drm_memory_manager.h"
+#include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/helpers/surface_formats.h"
+#include "runtime/utilities/binary_tracer.h"
 #include <cstring>
 #include <iostream>
 
@@ -41,7 +43,7 @@ extern "C" {
 
 namespace OCLRT {
 
-DrmMemoryManager::DrmMemoryManager(Drm *drm, gemCloseWorkerMode mode, bool forcePinAllowed, bool validateHostPtrMemory) : MemoryManager(false),
+DrmMemoryManager::DrmMemoryManager(Drm *drm, gemCloseWorkerMode mode, bool forcePinAllowed, bool validateHostPtrMemory, bool enable64kbPages) : MemoryManager(enable64kbPages),
                                                                                                                           drm(drm),
                                                                                                                           pinBB(nullptr),
                                                                                                                           forcePinEnabled(forcePinAllowed),
@@ -77,6 +79,11 @@ DrmMemoryManager::~DrmMemoryManager() {
         unreference(pinBB);
         pinBB = nullptr;
     }
+    if (gpuVirtualAddressHeapReservation) {
+        gpuVirtualAddressHeap.reset();
+        munmapFunction(gpuVirtualAddressHeapReservation, static_cast<size_t>(gpuVirtualAddressHeapSize));
+        gpuVirtualAddressHeapReservation = nullptr;
+    }
 }
 
 void DrmMemoryManager::push(DrmAllocation *alloc) {
@@ -129,6 +136,8 @@ uint32_t DrmMemoryManager::unreference(OCLRT::BufferObject *bo, bool synchronous
             if (unmapSize) {
                 if (allocatorType == MMAP_ALLOCATOR) {
                     munmapFunction(address, unmapSize);
+                } else if (allocatorType == GPU_VA_HEAP_ALLOCATOR) {
+                    gpuVirtualAddressHeap->free(address, static_cast<size_t>(unmapSize));
                 } else {
                     if (allocatorType == BIT32_ALLOCATOR_EXTERNAL) {
                         allocator32Bit->free(address, unmapSize);
@@ -146,6 +155,32 @@ uint32_t DrmMemoryManager::unreference(OCLRT::BufferObject *bo, bool synchronous
     return r;
 }
 
+// Soft pin address for objects without CPU address to mirror (tiled images, imported and padded objects).
+// Suballocated from one reserved range when enabled, instead of a separate mmap/munmap per object.
+void *DrmMemoryManager::reserveGpuVirtualAddress(size_t &size, StorageAllocatorType &storageType) {
+    if (DebugManager.flags.EnableGpuVirtualAddressHeap.get() && is64bit) {
+        std::lock_guard<decltype(mtx)> lock(mtx);
+        if (!gpuVirtualAddressHeapReservation) {
+            auto reservation = mmapFunction(nullptr, static_cast<size_t>(gpuVirtualAddressHeapSize), PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+            if (reservation != MAP_FAILED) {
+                gpuVirtualAddressHeapReservation = reservation;
+                gpuVirtualAddressHeap.reset(new HeapAllocator(reservation, gpuVirtualAddressHeapSize));
+            }
+        }
+        if (gpuVirtualAddressHeap) {
+            size_t sizeToAllocate = size;
+            auto gpuRange = gpuVirtualAddressHeap->allocate(sizeToAllocate);
+            if (gpuRange) {
+                size = sizeToAllocate;
+                storageType = GPU_VA_HEAP_ALLOCATOR;
+                return gpuRange;
+            }
+        }
+    }
+    storageType = MMAP_ALLOCATOR;
+    return mmapFunction(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+}
+
 OCLRT::BufferObject *DrmMemoryManager::allocUserptr(uintptr_t address, size_t size, uint64_t flags, bool softpin) {
     struct drm_i915_gem_userptr userptr;
 
@@ -178,6 +213,7 @@ DrmAllocation *DrmMemoryManager::createGraphicsAllocation(OsHandleStorage &handl
 }
 
 DrmAllocation *DrmMemoryManager::allocateGraphicsMemory(size_t size, size_t alignment, bool forcePin, bool uncacheable) {
+    globalTracer.record(TraceCategory::Memory, TracePhase::Instant, "allocateGraphicsMemory", size);
     const size_t minAlignment = MemoryConstants::allocationAlignment;
     size_t cAlignment = alignUp(std::max(alignment, minAlignment), minAlignment);
     // When size == 0 allocate allocationAlignment
@@ -216,7 +252,135 @@ DrmAllocation *DrmMemoryManager::allocateGraphicsMemory(size_t size, const void
 }
 
 DrmAllocation *DrmMemoryManager::allocateGraphicsMemory64kb(size_t size, size_t alignment, bool forcePin) {
-    return nullptr;
+    globalTracer.record(TraceCategory::Memory, TracePhase::Instant, "allocateGraphicsMemory64kb", size);
+    size_t cAlignment = alignUp(std::max(alignment, MemoryConstants::pageSize64k), MemoryConstants::pageSize64k);
+    size_t cSize = std::max(alignUp(size, MemoryConstants::pageSize64k), MemoryConstants::pageSize64k);
+
+    if (DebugManager.flags.EnableHugePageAllocations.get() && cSize >= MemoryConstants::pageSize2Mb) {
+        auto allocation = allocateGraphicsMemoryWithHugePages(cSize, forcePin);
+        if (allocation) {
+            return allocation;
+        }
+    }
+
+    auto res = alignedMallocWrapper(cSize, cAlignment);
+
+    if (!res)
+        return nullptr;
+
+    BufferObject *bo = allocUserptr(reinterpret_cast<uintptr_t>(res), cSize, 0, true);
+
+    if (!bo) {
+        alignedFreeWrapper(res);
+        return nullptr;
+    }
+
+    bo->isAllocated = true;
+    if (forcePinEnabled && pinBB != nullptr && forcePin && size >= this->pinThreshold) {
+        pinBB->pin(&bo, 1);
+    }
+
+    return new DrmAllocation(bo, res, cSize);
+}
+
+// Backs allocation with 2MB aligned anonymous mapping advised for transparent huge pages.
+// Returns nullptr when mapping or advice fails, so caller can fall back to regular pages.
+DrmAllocation *DrmMemoryManager::allocateGraphicsMemoryWithHugePages(size_t size, bool forcePin) {
+    auto alignedSize = alignUp(size, MemoryConstants::pageSize2Mb);
+    auto reservedSize = alignedSize + MemoryConstants::pageSize2Mb;
+
+    auto reserved = mmapFunction(nullptr, reservedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (reserved == MAP_FAILED) {
+        return nullptr;
+    }
+
+    // trim reservation to huge page boundaries
+    auto alignedPtr = alignUp(reserved, MemoryConstants::pageSize2Mb);
+    auto headSize = ptrDiff(alignedPtr, reserved);
+    auto tailSize = reservedSize - headSize - alignedSize;
+    if (headSize) {
+        munmapFunction(reserved, headSize);
+    }
+    if (tailSize) {
+        munmapFunction(ptrOffset(alignedPtr, alignedSize), tailSize);
+    }
+
+    if (madviseFunction(alignedPtr, alignedSize, MADV_HUGEPAGE) != 0) {
+        munmapFunction(alignedPtr, alignedSize);
+        return nullptr;
+    }
+
+    BufferObject *bo = allocUserptr(reinterpret_cast<uintptr_t>(alignedPtr), alignedSize, 0, true);
+    if (!bo) {
+        munmapFunction(alignedPtr, alignedSize);
+        return nullptr;
+    }
+
+    bo->setUnmapSize(alignedSize);
+    bo->setAllocationType(MMAP_ALLOCATOR);
+    if (forcePinEnabled && pinBB != nullptr && forcePin && alignedSize >= this->pinThreshold) {
+        pinBB->pin(&bo, 1);
+    }
+
+    return new DrmAllocation(bo, alignedPtr, alignedSize);
+}
+
+GraphicsAllocation *DrmMemoryManager::allocateDriverInternalGraphicsMemory(size_t size, size_t alignment) {
+    if (DebugManager.flags.EnableGemCreateForInternalAllocations.get() && alignment <= MemoryConstants::pageSize) {
+        auto allocation = allocateGraphicsMemoryWithGemCreate(size);
+        if (allocation) {
+            return allocation;
+        }
+    }
+    return allocateGraphicsMemory(size, alignment);
+}
+
+// Kernel allocated backing, mapped to CPU with GEM_MMAP and soft pinned at the same address,
+// avoids get_user_pages pinning done for userptr objects. Object is snooped, so the write-back
+// CPU mapping stays coherent with GPU also on parts without LLC.
+DrmAllocation *DrmMemoryManager::allocateGraphicsMemoryWithGemCreate(size_t size) {
+    globalTracer.record(TraceCategory::Memory, TracePhase::Instant, "allocateGraphicsMemoryWithGemCreate", size);
+    size_t cSize = std::max(alignUp(size, MemoryConstants::pageSize), MemoryConstants::pageSize);
+
+    drm_i915_gem_create create = {0, 0, 0};
+    create.size = cSize;
+    auto ret = this->drm->ioctl(DRM_IOCTL_I915_GEM_CREATE, &create);
+    if (ret != 0) {
+        return nullptr;
+    }
+
+    auto bo = new (std::nothrow) BufferObject(this->drm, create.handle, false);
+    if (!bo) {
+        return nullptr;
+    }
+    bo->size = cSize;
+
+    drm_i915_gem_caching caching = {0, 0};
+    caching.handle = create.handle;
+    caching.caching = I915_CACHING_CACHED;
+    ret = this->drm->ioctl(DRM_IOCTL_I915_GEM_SET_CACHING, &caching);
+    if (ret != 0) {
+        unreference(bo);
+        return nullptr;
+    }
+
+    drm_i915_gem_mmap mmapArg;
+    memset(&mmapArg, 0, sizeof(mmapArg));
+    mmapArg.handle = create.handle;
+    mmapArg.size = cSize;
+    ret = this->drm->ioctl(DRM_IOCTL_I915_GEM_MMAP, &mmapArg);
+    if (ret != 0) {
+        unreference(bo);
+        return nullptr;
+    }
+
+    auto cpuPtr = reinterpret_cast<void *>(mmapArg.addr_ptr);
+    bo->address = cpuPtr;
+    bo->softPin(mmapArg.addr_ptr);
+    bo->setUnmapSize(cSize);
+    bo->setAllocationType(MMAP_ALLOCATOR);
+
+    return new DrmAllocation(bo, cpuPtr, cSize);
 }
 
 GraphicsAllocation *DrmMemoryManager::allocateGraphicsMemoryForImage(ImageInfo &imgInfo, Gmm *gmm) {
@@ -227,8 +391,11 @@ GraphicsAllocation *DrmMemoryManager::allocateGraphicsMemoryForImage(ImageInfo &
         }
         return alloc;
     }
+    globalTracer.record(TraceCategory::Memory, TracePhase::Instant, "allocateGraphicsMemoryForImage", imgInfo.size);
 
-    auto gpuRange = mmapFunction(nullptr, imgInfo.size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    StorageAllocatorType storageType = UNKNOWN_ALLOCATOR;
+    size_t reservedSize = imgInfo.size;
+    auto gpuRange = reserveGpuVirtualAddress(reservedSize, storageType);
     DEBUG_BREAK_IF(gpuRange == MAP_FAILED);
 
     drm_i915_gem_create create = {0, 0, 0};
@@ -250,15 +417,16 @@ GraphicsAllocation *DrmMemoryManager::allocateGraphicsMemoryForImage(ImageInfo &
     DEBUG_BREAK_IF(ret2 != true);
     ((void)(ret2));
 
-    bo->setUnmapSize(imgInfo.size);
+    bo->setUnmapSize(reservedSize);
 
     auto allocation = new DrmAllocation(bo, nullptr, (uint64_t)gpuRange, imgInfo.size);
-    bo->setAllocationType(MMAP_ALLOCATOR);
+    bo->setAllocationType(storageType);
     allocation->gmm = gmm;
     return allocation;
 }
 
 DrmAllocation *DrmMemoryManager::allocate32BitGraphicsMemory(size_t size, void *ptr, MemoryType memoryType) {
+    globalTracer.record(TraceCategory::Memory, TracePhase::Instant, "allocate32BitGraphicsMemory", size);
     auto allocatorToUse = memoryType == MemoryType::EXTERNAL_ALLOCATION ? allocator32Bit.get() : internal32bitAllocator.get();
     auto allocationType = memoryType == MemoryType::EXTERNAL_ALLOCATION ? BIT32_ALLOCATOR_EXTERNAL : BIT32_ALLOCATOR_INTERNAL;
 
@@ -345,13 +513,13 @@ BufferObject *DrmMemoryManager::findAndReferenceSharedBufferObject(int boHandle)
 BufferObject *DrmMemoryManager::createSharedBufferObject(int boHandle, size_t size, bool requireSpecificBitness) {
     void *gpuRange = nullptr;
     StorageAllocatorType storageType = UNKNOWN_ALLOCATOR;
+    size_t reservedSize = size;
 
     if (requireSpecificBitness && this->force32bitAllocations) {
         gpuRange = this->allocator32Bit->allocate(size);
         storageType = BIT32_ALLOCATOR_EXTERNAL;
     } else {
-        gpuRange = mmapFunction(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
-        storageType = MMAP_ALLOCATOR;
+        gpuRange = reserveGpuVirtualAddress(reservedSize, storageType);
     }
 
     DEBUG_BREAK_IF(gpuRange == MAP_FAILED);
@@ -364,7 +532,7 @@ BufferObject *DrmMemoryManager::createSharedBufferObject(int boHandle, size_t si
     bo->size = size;
     bo->address = reinterpret_cast<void *>(gpuRange);
     bo->softPin(reinterpret_cast<uint64_t>(gpuRange));
-    bo->setUnmapSize(size);
+    bo->setUnmapSize(reservedSize);
     bo->setAllocationType(storageType);
     return bo;
 }
@@ -408,7 +576,9 @@ GraphicsAllocation *DrmMemoryManager::createGraphicsAllocationFromSharedHandle(o
 }
 
 GraphicsAllocation *DrmMemoryManager::createPaddedAllocation(GraphicsAllocation *inputGraphicsAllocation, size_t sizeWithPadding) {
-    void *gpuRange = mmapFunction(nullptr, sizeWithPadding, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    StorageAllocatorType storageType = UNKNOWN_ALLOCATOR;
+    size_t reservedSize = sizeWithPadding;
+    void *gpuRange = reserveGpuVirtualAddress(reservedSize, storageType);
 
     auto srcPtr = inputGraphicsAllocation->getUnderlyingBuffer();
     auto srcSize = inputGraphicsAllocation->getUnderlyingBufferSize();
@@ -422,8 +592,8 @@ GraphicsAllocation *DrmMemoryManager::createPaddedAllocation(GraphicsAllocation
     }
     bo->setAddress(gpuRange);
     bo->softPin(reinterpret_cast<uint64_t>(gpuRange));
-    bo->setUnmapSize(sizeWithPadding);
-    bo->setAllocationType(MMAP_ALLOCATOR);
+    bo->setUnmapSize(reservedSize);
+    bo->setAllocationType(storageType);
     return new DrmAllocation(bo, (void *)srcPtr, (uint64_t)ptrOffset(gpuRange, offset), sizeWithPadding);
 }
 
@@ -611,4 +781,27 @@ void DrmMemoryManager::unlockResource(GraphicsAllocation *graphicsAllocation) {
 
     bo->setLockedAddress(nullptr);
 }
+
+void DrmMemoryManager::prefetchAllocations(ResidencyContainer &allocations) {
+    if (pinBB == nullptr) {
+        return;
+    }
+
+    // pinning executes dummy batch with all BOs, kernel populates userptr pages now instead of on first real submission
+    std::vector<BufferObject *> bosToPin;
+    for (auto allocation : allocations) {
+        auto drmAllocation = static_cast<DrmAllocation *>(allocation);
+        if (drmAllocation->fragmentsStorage.fragmentCount) {
+            for (unsigned int i = 0; i < drmAllocation->fragmentsStorage.fragmentCount; i++) {
+                bosToPin.push_back(drmAllocation->fragmentsStorage.fragmentStorageData[i].osHandleStorage->bo);
+            }
+        } else if (drmAllocation->getBO()) {
+            bosToPin.push_back(drmAllocation->getBO());
+        }
+    }
+
+    if (!bosToPin.empty()) {
+        pinBB->pin(bosToPin.data(), bosToPin.size());
+    }
+}
 } // namespace OCLRT
@@ -25,6 +25,7 @@
 #include "runtime/memory_manager/memory_manager.h"
 #include "runtime/os_interface/linux/drm_allocation.h"
 #include "runtime/os_interface/linux/drm_neo.h"
+#include "runtime/utilities/heap_allocator.h"
 #include <map>
 #include <sys/mman.h>
 
@@ -36,7 +37,7 @@ class DrmMemoryManager : public MemoryManager {
   public:
     using MemoryManager::createGraphicsAllocationFromSharedHandle;
 
-    DrmMemoryManager(Drm *drm, gemCloseWorkerMode mode, bool forcePinAllowed, bool validateHostPtrMemory);
+    DrmMemoryManager(Drm *drm, gemCloseWorkerMode mode, bool forcePinAllowed, bool validateHostPtrMemory, bool enable64kbPages);
     ~DrmMemoryManager() override;
 
     BufferObject *getPinBB() const;
@@ -47,6 +48,7 @@ class DrmMemoryManager : public MemoryManager {
     }
     DrmAllocation *allocateGraphicsMemory(size_t size, size_t alignment, bool forcePin, bool uncacheable) override;
     DrmAllocation *allocateGraphicsMemory64kb(size_t size, size_t alignment, bool forcePin) override;
+    GraphicsAllocation *allocateDriverInternalGraphicsMemory(size_t size, size_t alignment) override;
     DrmAllocation *allocateGraphicsMemory(size_t size, const void *ptr) override {
         return allocateGraphicsMemory(size, ptr, false);
     }
@@ -59,6 +61,7 @@ class DrmMemoryManager : public MemoryManager {
     GraphicsAllocation *createGraphicsAllocationFromNTHandle(void *handle) override { return nullptr; }
     void *lockResource(GraphicsAllocation *graphicsAllocation) override;
     void unlockResource(GraphicsAllocation *graphicsAllocation) override;
+    void prefetchAllocations(ResidencyContainer &allocations) override;
 
     uint64_t getSystemSharedMemory() override;
     uint64_t getMaxApplicationAddress() override;
@@ -85,7 +88,10 @@ class DrmMemoryManager : public MemoryManager {
     void eraseSharedBufferObject(BufferObject *bo);
     void pushSharedBufferObject(BufferObject *bo);
     BufferObject *allocUserptr(uintptr_t address, size_t size, uint64_t flags, bool softpin);
+    DrmAllocation *allocateGraphicsMemoryWithHugePages(size_t size, bool forcePin);
+    DrmAllocation *allocateGraphicsMemoryWithGemCreate(size_t size);
     bool setDomainCpu(GraphicsAllocation &graphicsAllocation, bool writeEnable);
+    void *reserveGpuVirtualAddress(size_t &size, StorageAllocatorType &storageType);
 
     Drm *drm;
     BufferObject *pinBB;
@@ -96,9 +102,13 @@ class DrmMemoryManager : public MemoryManager {
     decltype(&lseek) lseekFunction = lseek;
     decltype(&mmap) mmapFunction = mmap;
     decltype(&munmap) munmapFunction = munmap;
+    decltype(&madvise) madviseFunction = madvise;
     decltype(&close) closeFunction = close;
     std::vector<BufferObject *> sharingBufferObjects;
     std::recursive_mutex mtx;
     std::unique_ptr<Allocator32bit> internal32bitAllocator;
+    std::unique_ptr<HeapAllocator> gpuVirtualAddressHeap;
+    void *gpuVirtualAddressHeapReservation = nullptr;
+    uint64_t gpuVirtualAddressHeapSize = 64 * MemoryConstants::gigaByte;
 };
 } // namespace OCLRT
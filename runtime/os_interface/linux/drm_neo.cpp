@@ -28,6 +28,7 @@
 #include <cstdio>
 #include <cstring>
 #include <fstream>
+#include <poll.h>
 
 namespace OCLRT {
 
@@ -73,6 +74,26 @@ int Drm::getExecSoftPin(int &execSoftPin) {
     return getParamIoctl(I915_PARAM_HAS_EXEC_SOFTPIN, &execSoftPin);
 }
 
+int Drm::getExecFence(int &execFence) {
+    return getParamIoctl(I915_PARAM_HAS_EXEC_FENCE, &execFence);
+}
+
+bool Drm::waitOutFence(int fenceFd, int timeoutMs) {
+    struct pollfd pollFd = {};
+    pollFd.fd = fenceFd;
+    pollFd.events = POLLIN;
+
+    int ret;
+    do {
+        ret = poll(&pollFd, 1, timeoutMs);
+    } while (ret == -1 && (errno == EINTR || errno == EAGAIN));
+    return ret > 0;
+}
+
+void Drm::closeOutFence(int fenceFd) {
+    ::close(fenceFd);
+}
+
 int Drm::enableTurboBoost() {
     int ret = 0;
     struct drm_i915_gem_context_param contextParam;
@@ -23,6 +23,7 @@
 #pragma once
 #include "igfxfmid.h"
 #include "runtime/utilities/api_intercept.h"
+#include "drm/i915_drm.h"
 
 #include <sys/ioctl.h>
 #include <fcntl.h>
@@ -39,6 +40,16 @@ namespace OCLRT {
 
 #define I915_CONTEXT_PRIVATE_PARAM_BOOST 0x80000000
 
+#ifndef I915_PARAM_HAS_EXEC_FENCE
+#define I915_PARAM_HAS_EXEC_FENCE 44
+#endif
+#ifndef I915_EXEC_FENCE_OUT
+#define I915_EXEC_FENCE_OUT (1 << 17)
+#endif
+#ifndef DRM_IOCTL_I915_GEM_EXECBUFFER2_WR
+#define DRM_IOCTL_I915_GEM_EXECBUFFER2_WR DRM_IOWR(DRM_COMMAND_BASE + DRM_I915_GEM_EXECBUFFER2, struct drm_i915_gem_execbuffer2)
+#endif
+
 class DeviceFactory;
 struct HardwareInfo;
 
@@ -63,6 +74,10 @@ class Drm {
     int getDeviceID(int &devId);
     int getDeviceRevID(int &revId);
     int getExecSoftPin(int &execSoftPin);
+    int getExecFence(int &execFence);
+    bool isExecFenceSupported() const { return execFenceSupported; }
+    MOCKABLE_VIRTUAL bool waitOutFence(int fenceFd, int timeoutMs);
+    MOCKABLE_VIRTUAL void closeOutFence(int fenceFd);
     int enableTurboBoost();
     int getEuTotal(int &euTotal);
     int getSubsliceTotal(int &subsliceTotal);
@@ -90,6 +105,7 @@ class Drm {
     int revisionId;
     GTTYPE eGtType;
     bool coherencyDisablePatchActive = false;
+    bool execFenceSupported = false;
     Drm(int fd) : lowPriorityContextId(0), fd(fd), deviceId(0), revisionId(0), eGtType(GTTYPE_UNDEFINED) {}
     virtual ~Drm();
 
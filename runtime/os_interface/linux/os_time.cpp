@@ -21,6 +21,7 @@
  */
 
 #include <time.h>
+#include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/os_interface/linux/drm_neo.h"
 #include "drm/i915_drm.h"
 #include "runtime/os_interface/linux/os_interface.h"
@@ -37,6 +38,9 @@ OSTimeLinux::OSTimeLinux(OSInterface *osInterface) {
     } else {
         pDrm = Drm::get(0);
     }
+    if (DebugManager.flags.OverrideGpuTimestampCalibrationIntervalMs.get() >= 0) {
+        timeCorrelation.setCalibrationInterval(static_cast<uint64_t>(DebugManager.flags.OverrideGpuTimestampCalibrationIntervalMs.get()) * 1000000);
+    }
     timestampTypeDetect();
 }
 
@@ -65,6 +69,7 @@ void OSTimeLinux::timestampTypeDetect() {
         getGpuTime = &OSTimeLinux::getGpuTime36;
         timestampSizeInBits = OCLRT_NUM_TIMESTAMP_BITS;
     }
+    timeCorrelation.setGpuTimestampBits(timestampSizeInBits);
 }
 
 bool OSTimeLinux::getCpuTime(uint64_t *timestamp) {
@@ -125,6 +130,16 @@ bool OSTimeLinux::getGpuTimeSplitted(uint64_t *timestamp) {
 }
 
 bool OSTimeLinux::getCpuGpuTime(TimeStampData *pGpuCpuTime) {
+    if (timeCorrelation.isEnabled() && timeCorrelation.isCalibrated()) {
+        uint64_t cpuTime = 0;
+        if (!getCpuTime(&cpuTime)) {
+            return false;
+        }
+        if (timeCorrelation.estimateGpuTime(cpuTime, pGpuCpuTime)) {
+            return true;
+        }
+    }
+
     if (!(this->*getGpuTime)(&pGpuCpuTime->GPUTimeStamp)) {
         return false;
     }
@@ -132,6 +147,9 @@ bool OSTimeLinux::getCpuGpuTime(TimeStampData *pGpuCpuTime) {
         return false;
     }
 
+    if (timeCorrelation.isEnabled()) {
+        *pGpuCpuTime = timeCorrelation.calibrate(*pGpuCpuTime);
+    }
     return true;
 }
 
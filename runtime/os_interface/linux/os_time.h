@@ -22,6 +22,7 @@
 
 #pragma once
 #include "runtime/os_interface/os_time.h"
+#include "runtime/os_interface/os_time_correlation.h"
 
 #define OCLRT_NUM_TIMESTAMP_BITS (36)
 #define OCLRT_NUM_TIMESTAMP_BITS_FALLBACK (32)
@@ -45,6 +46,7 @@ class OSTimeLinux : public OSTime {
     double getHostTimerResolution() const override;
     double getDynamicDeviceTimerResolution(HardwareInfo const &hwInfo) const override;
     uint64_t getCpuRawTimestamp() override;
+    const CpuGpuTimeCorrelation *getTimeCorrelation() const override { return &timeCorrelation; }
 
   protected:
     typedef int (*resolutionFunc_t)(clockid_t, struct timespec *);
@@ -53,6 +55,7 @@ class OSTimeLinux : public OSTime {
     unsigned timestampSizeInBits;
     resolutionFunc_t resolutionFunc;
     getTimeFunc_t getTimeFunc;
+    CpuGpuTimeCorrelation timeCorrelation;
 };
 
 } // namespace OCLRT
@@ -27,6 +27,7 @@
 
 namespace OCLRT {
 
+class CpuGpuTimeCorrelation;
 class OSInterface;
 struct HardwareInfo;
 
@@ -45,6 +46,7 @@ class OSTime {
     virtual double getHostTimerResolution() const = 0;
     virtual double getDynamicDeviceTimerResolution(HardwareInfo const &hwInfo) const = 0;
     virtual uint64_t getCpuRawTimestamp() = 0;
+    virtual const CpuGpuTimeCorrelation *getTimeCorrelation() const { return nullptr; }
     OSInterface *getOSInterface() const {
         return osInterface;
     }
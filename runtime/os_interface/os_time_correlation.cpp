@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/os_interface/os_time_correlation.h"
+
+namespace OCLRT {
+
+const uint64_t CpuGpuTimeCorrelation::defaultCalibrationIntervalInNs;
+const uint64_t CpuGpuTimeCorrelation::minSlopeWindowInNs;
+const uint64_t CpuGpuTimeCorrelation::defaultMaxErrorInNs;
+
+void CpuGpuTimeCorrelation::setGpuTimestampBits(uint32_t bits) {
+    std::lock_guard<std::mutex> lock(mtx);
+    gpuTimestampMask = (bits >= 64) ? ~0ull : ((1ull << bits) - 1);
+    reportedAny = false;
+    resetModel();
+}
+
+void CpuGpuTimeCorrelation::reset() {
+    std::lock_guard<std::mutex> lock(mtx);
+    resetModel();
+}
+
+void CpuGpuTimeCorrelation::resetModel() {
+    anchorValid = false;
+    gpuTicksPerNs = 0.0;
+    lastUnwrappedGpuTicks = 0;
+    lastErrorInNs = 0;
+}
+
+bool CpuGpuTimeCorrelation::isCalibrated() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return gpuTicksPerNs > 0.0;
+}
+
+double CpuGpuTimeCorrelation::getGpuTimerResolution() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return gpuTicksPerNs > 0.0 ? 1.0 / gpuTicksPerNs : 0.0;
+}
+
+uint64_t CpuGpuTimeCorrelation::getLastCalibrationErrorInNs() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return lastErrorInNs;
+}
+
+uint32_t CpuGpuTimeCorrelation::getCalibrationCount() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return calibrationCount;
+}
+
+uint64_t CpuGpuTimeCorrelation::getMaxAllowedErrorInNs(uint64_t extrapolationInNs) const {
+    // both samples defining the slope carry up to maxErrorInNs of read jitter, so the slope error
+    // grows with the extrapolated distance relative to the window it was fitted over
+    auto window = last.CPUTimeinNS - anchor.CPUTimeinNS;
+    if (window < minSlopeWindowInNs) {
+        window = minSlopeWindowInNs;
+    }
+    return 2 * maxErrorInNs + static_cast<uint64_t>(2.0 * maxErrorInNs * extrapolationInNs / window);
+}
+
+uint64_t CpuGpuTimeCorrelation::unwrapGpuTicks(uint64_t gpuTimeStamp) const {
+    // GPU counter is narrower than 64 bits, keep the model monotonic across wraps
+    auto delta = (gpuTimeStamp - last.GPUTimeStamp) & gpuTimestampMask;
+    return lastUnwrappedGpuTicks + delta;
+}
+
+uint64_t CpuGpuTimeCorrelation::makeMonotonic(uint64_t gpuTimeStamp) {
+    // compare modulo the counter width, anything less than half the range behind is a step back
+    if (reportedAny) {
+        auto behind = (lastReportedGpuTimeStamp - gpuTimeStamp) & gpuTimestampMask;
+        if (behind != 0 && behind <= (gpuTimestampMask >> 1)) {
+            return lastReportedGpuTimeStamp;
+        }
+    }
+    lastReportedGpuTimeStamp = gpuTimeStamp;
+    reportedAny = true;
+    return gpuTimeStamp;
+}
+
+bool CpuGpuTimeCorrelation::estimateGpuTime(uint64_t cpuTimeInNs, TimeStampData *pGpuCpuTime) {
+    if (!isEnabled()) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mtx);
+    if (gpuTicksPerNs <= 0.0) {
+        return false;
+    }
+    if (cpuTimeInNs < last.CPUTimeinNS || cpuTimeInNs - last.CPUTimeinNS >= calibrationIntervalInNs) {
+        return false;
+    }
+    auto elapsedTicks = static_cast<uint64_t>((cpuTimeInNs - last.CPUTimeinNS) * gpuTicksPerNs);
+    pGpuCpuTime->GPUTimeStamp = makeMonotonic((last.GPUTimeStamp + elapsedTicks) & gpuTimestampMask);
+    pGpuCpuTime->CPUTimeinNS = cpuTimeInNs;
+    return true;
+}
+
+TimeStampData CpuGpuTimeCorrelation::calibrate(const TimeStampData &sample) {
+    std::lock_guard<std::mutex> lock(mtx);
+    calibrationCount++;
+    TimeStampData reported = sample;
+    reported.GPUTimeStamp = makeMonotonic(sample.GPUTimeStamp);
+
+    if (!anchorValid) {
+        anchor = sample;
+        last = sample;
+        lastUnwrappedGpuTicks = 0;
+        gpuTicksPerNs = 0.0;
+        anchorValid = true;
+        return reported;
+    }
+    if (sample.CPUTimeinNS < last.CPUTimeinNS) {
+        // read by a concurrent query that lost the race to a newer sample
+        return reported;
+    }
+
+    auto unwrappedGpuTicks = unwrapGpuTicks(sample.GPUTimeStamp);
+
+    if (gpuTicksPerNs > 0.0) {
+        auto extrapolationInNs = sample.CPUTimeinNS - last.CPUTimeinNS;
+        auto predictedTicks = lastUnwrappedGpuTicks + extrapolationInNs * gpuTicksPerNs;
+        auto errorInTicks = predictedTicks > unwrappedGpuTicks ? predictedTicks - unwrappedGpuTicks
+                                                               : unwrappedGpuTicks - predictedTicks;
+        auto errorInNs = static_cast<uint64_t>(errorInTicks / gpuTicksPerNs);
+        if (errorInNs > getMaxAllowedErrorInNs(extrapolationInNs)) {
+            // clocks diverged (suspend, frequency change), start a new window
+            resetModel();
+            lastErrorInNs = errorInNs;
+            anchor = sample;
+            last = sample;
+            anchorValid = true;
+            return reported;
+        }
+        lastErrorInNs = errorInNs;
+    }
+
+    last = sample;
+    lastUnwrappedGpuTicks = unwrappedGpuTicks;
+
+    auto cpuWindow = sample.CPUTimeinNS - anchor.CPUTimeinNS;
+    if (cpuWindow >= minSlopeWindowInNs && unwrappedGpuTicks != 0) {
+        gpuTicksPerNs = static_cast<double>(unwrappedGpuTicks) / static_cast<double>(cpuWindow);
+    }
+    return reported;
+}
+} // namespace OCLRT
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include "runtime/os_interface/os_time.h"
+#include <cstdint>
+#include <mutex>
+
+namespace OCLRT {
+
+// Linear model of the GPU timestamp as a function of the CPU clock.
+// Calibration points are real CPU/GPU pairs read from the device, the slope is
+// estimated between the first point of the current window and the latest one.
+// Between calibrations the GPU timestamp is extrapolated on the CPU only.
+// Shared by all queues of a device, every query and calibration is serialized.
+class CpuGpuTimeCorrelation {
+  public:
+    static const uint64_t defaultCalibrationIntervalInNs = 100 * 1000 * 1000;
+    static const uint64_t minSlopeWindowInNs = 1000 * 1000;
+    // jitter of a single CPU/GPU sample read, the allowed prediction error is scaled from it
+    static const uint64_t defaultMaxErrorInNs = 1000;
+    // calibrated resolution further from nominal than this is treated as a measurement error
+    static constexpr double maxResolutionDeviation = 0.01;
+
+    void setCalibrationInterval(uint64_t intervalInNs) { calibrationIntervalInNs = intervalInNs; }
+    void setMaxError(uint64_t errorInNs) { maxErrorInNs = errorInNs; }
+    void setGpuTimestampBits(uint32_t bits);
+    void reset();
+
+    bool isEnabled() const { return calibrationIntervalInNs != 0; }
+    bool isCalibrated() const;
+    bool estimateGpuTime(uint64_t cpuTimeInNs, TimeStampData *pGpuCpuTime);
+    // returns the sample with its GPU timestamp clamped to never precede an already reported one
+    TimeStampData calibrate(const TimeStampData &sample);
+
+    double getGpuTimerResolution() const;
+    uint64_t getLastCalibrationErrorInNs() const;
+    uint32_t getCalibrationCount() const;
+    uint64_t getMaxAllowedErrorInNs(uint64_t extrapolationInNs) const;
+
+  protected:
+    void resetModel();
+    uint64_t unwrapGpuTicks(uint64_t gpuTimeStamp) const;
+    uint64_t makeMonotonic(uint64_t gpuTimeStamp);
+
+    mutable std::mutex mtx;
+
+    uint64_t calibrationIntervalInNs = defaultCalibrationIntervalInNs;
+    uint64_t maxErrorInNs = defaultMaxErrorInNs;
+    uint64_t gpuTimestampMask = ~0ull;
+
+    TimeStampData anchor = {0, 0};
+    TimeStampData last = {0, 0};
+    uint64_t lastUnwrappedGpuTicks = 0;
+    double gpuTicksPerNs = 0.0;
+    uint64_t lastErrorInNs = 0;
+    uint32_t calibrationCount = 0;
+    bool anchorValid = false;
+    uint64_t lastReportedGpuTimeStamp = 0;
+    bool reportedAny = false;
+};
+} // namespace OCLRT
@@ -32,6 +32,7 @@
 #include "runtime/os_interface/windows/wddm_memory_manager.h"
 #include "runtime/os_interface/windows/wddm_allocation.h"
 #include "runtime/os_interface/windows/wddm.h"
+#include "runtime/utilities/binary_tracer.h"
 #include <algorithm>
 #pragma warning(push)
 #pragma warning(disable : 4005)
@@ -70,6 +71,7 @@ GraphicsAllocation *WddmMemoryManager::allocateGraphicsMemoryForImage(ImageInfo
         delete gmm;
         return allocateGraphicsMemory(imgInfo.size, MemoryConstants::preferredAlignment);
     }
+    globalTracer.record(TraceCategory::Memory, TracePhase::Instant, "allocateGraphicsMemoryForImage", imgInfo.size);
     auto allocation = new WddmAllocation(nullptr, imgInfo.size, nullptr);
     allocation->gmm = gmm;
 
@@ -81,6 +83,7 @@ GraphicsAllocation *WddmMemoryManager::allocateGraphicsMemoryForImage(ImageInfo
 }
 
 GraphicsAllocation *WddmMemoryManager::allocateGraphicsMemory64kb(size_t size, size_t alignment, bool forcePin) {
+    globalTracer.record(TraceCategory::Memory, TracePhase::Instant, "allocateGraphicsMemory64kb", size);
     size_t sizeAligned = alignUp(size, MemoryConstants::pageSize64k);
     Gmm *gmm = nullptr;
 
@@ -108,6 +111,7 @@ GraphicsAllocation *WddmMemoryManager::allocateGraphicsMemory64kb(size_t size, s
 }
 
 GraphicsAllocation *WddmMemoryManager::allocateGraphicsMemory(size_t size, size_t alignment, bool forcePin, bool uncacheable) {
+    globalTracer.record(TraceCategory::Memory, TracePhase::Instant, "allocateGraphicsMemory", size);
     size_t newAlignment = alignment ? alignUp(alignment, MemoryConstants::pageSize) : MemoryConstants::pageSize;
     size_t sizeAligned = size ? alignUp(size, MemoryConstants::pageSize) : MemoryConstants::pageSize;
     void *pSysMem = allocateSystemMemory(sizeAligned, newAlignment);
@@ -168,6 +172,7 @@ GraphicsAllocation *WddmMemoryManager::allocateGraphicsMemory(size_t size, const
 }
 
 GraphicsAllocation *WddmMemoryManager::allocate32BitGraphicsMemory(size_t size, void *ptr, MemoryType memoryType) {
+    globalTracer.record(TraceCategory::Memory, TracePhase::Instant, "allocate32BitGraphicsMemory", size);
     Gmm *gmm = nullptr;
     const void *ptrAligned = nullptr;
     size_t sizeAligned = size;
@@ -754,6 +759,12 @@ bool WddmMemoryManager::mapAuxGpuVA(GraphicsAllocation *graphicsAllocation) {
     return wddm->updateAuxTable(graphicsAllocation->getGpuAddress(), graphicsAllocation->gmm, true);
 }
 
+void WddmMemoryManager::prefetchAllocations(ResidencyContainer &allocations) {
+    bool success = makeResidentResidencyAllocations(&allocations);
+    DEBUG_BREAK_IF(!success);
+    ((void)(success));
+}
+
 AlignedMallocRestrictions *WddmMemoryManager::getAlignedMallocRestrictions() {
     return &mallocRestrictions;
 }
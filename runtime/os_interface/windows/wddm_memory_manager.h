@@ -87,6 +87,8 @@ class WddmMemoryManager : public MemoryManager {
 
     bool mapAuxGpuVA(GraphicsAllocation *graphicsAllocation) override;
 
+    void prefetchAllocations(ResidencyContainer &allocations) override;
+
     AlignedMallocRestrictions *getAlignedMallocRestrictions() override;
 
   protected:
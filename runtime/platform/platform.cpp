@@ -30,10 +30,12 @@
 #include "runtime/helpers/get_info.h"
 #include "runtime/helpers/options.h"
 #include "runtime/helpers/string.h"
+#include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/os_interface/device_factory.h"
 #include "runtime/event/async_events_handler.h"
 #include "runtime/sharings/sharing_factory.h"
 #include "runtime/platform/extensions.h"
+#include "runtime/utilities/binary_tracer.h"
 #include "CL/cl_ext.h"
 
 namespace OCLRT {
@@ -159,6 +161,10 @@ bool Platform::initialize(size_t numDevices,
 
     this->fillGlobalDispatchTable();
 
+    if (DebugManager.flags.BinaryTraceFileName.get() != "unk") {
+        globalTracer.startDrainer(DebugManager.flags.BinaryTraceFileName.get());
+    }
+
     state = StateInited;
     return true;
 }
@@ -29,13 +29,23 @@
 #include "runtime/helpers/ptr_math.h"
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/memory_manager/memory_manager.h"
+#include "runtime/os_interface/debug_settings_manager.h"
+#include "runtime/program/printf_output_worker.h"
+#include "runtime/program/printf_surface_pool.h"
 
 namespace OCLRT {
 
 PrintfHandler::PrintfHandler(Device &deviceArg) : device(deviceArg) {}
 
 PrintfHandler::~PrintfHandler() {
-    device.getMemoryManager()->freeGraphicsMemory(printfSurface);
+    if (printfSurface) {
+        //once output was printed the GPU is done with the surface, otherwise it can be reused only after all submitted work completes
+        auto taskCount = outputPrinted ? 0u : device.getCommandStreamReceiver().peekTaskCount();
+        device.getPrintfSurfacePool().returnSurface(printfSurface, taskCount);
+    }
+    if (kernelRetained) {
+        kernel->decRefInternal();
+    }
 }
 
 PrintfHandler *PrintfHandler::create(const MultiDispatchInfo &multiDispatchInfo, Device &device) {
@@ -53,7 +63,7 @@ void PrintfHandler::prepareDispatch(const MultiDispatchInfo &multiDispatchInfo)
     }
     kernel = multiDispatchInfo.begin()->getKernel();
 
-    printfSurface = device.getMemoryManager()->createGraphicsAllocationWithRequiredBitness(printfSurfaceSize, nullptr);
+    printfSurface = device.getPrintfSurfacePool().obtainSurface(*device.getMemoryManager(), printfSurfaceSize, device.getTagAddress());
 
     *reinterpret_cast<uint32_t *>(printfSurface->getUnderlyingBuffer()) = printfSurfaceInitialDataSize;
 
@@ -77,5 +87,18 @@ void PrintfHandler::makeResident(CommandStreamReceiver &commandStreamReceiver) {
 void PrintfHandler::printEnqueueOutput() {
     PrintFormatter printFormatter(*kernel, *printfSurface);
     printFormatter.printKernelOutput();
+    outputPrinted = true;
+}
+
+void PrintfHandler::flushEnqueueOutput(std::unique_ptr<PrintfHandler> printfHandler) {
+    if (DebugManager.flags.EnableAsyncPrintfOutput.get()) {
+        //kernel may be released by application before output is printed
+        printfHandler->kernel->incRefInternal();
+        printfHandler->kernelRetained = true;
+        auto &device = printfHandler->device;
+        device.getPrintfOutputWorker().schedule(std::move(printfHandler));
+    } else {
+        printfHandler->printEnqueueOutput();
+    }
 }
 } // namespace OCLRT
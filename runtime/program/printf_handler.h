@@ -39,6 +39,9 @@ class PrintfHandler {
     void makeResident(CommandStreamReceiver &commandStreamReceiver);
     void printEnqueueOutput();
 
+    // Prints output right away or hands it to device's printf worker, depending on EnableAsyncPrintfOutput
+    static void flushEnqueueOutput(std::unique_ptr<PrintfHandler> printfHandler);
+
     GraphicsAllocation *getSurface() {
         return printfSurface;
     }
@@ -50,5 +53,7 @@ class PrintfHandler {
     Device &device;
     Kernel *kernel = nullptr;
     GraphicsAllocation *printfSurface = nullptr;
+    bool outputPrinted = false;
+    bool kernelRetained = false;
 };
 } // namespace OCLRT
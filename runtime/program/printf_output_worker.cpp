@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/program/printf_output_worker.h"
+#include "runtime/program/printf_handler.h"
+
+namespace OCLRT {
+
+PrintfOutputWorker::~PrintfOutputWorker() {
+    stop();
+}
+
+void PrintfOutputWorker::schedule(std::unique_ptr<PrintfHandler> printfHandler) {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    queue.push_back(std::move(printfHandler));
+    if (!worker) {
+        worker = new std::thread(run, this);
+    }
+    lock.unlock();
+    condition.notify_one();
+}
+
+void PrintfOutputWorker::drain() {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    queueDrained.wait(lock, [this] { return queue.empty() && !processing; });
+}
+
+void PrintfOutputWorker::stop() {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    stopRequested = true;
+    lock.unlock();
+    condition.notify_one();
+    if (worker) {
+        worker->join();
+        delete worker;
+        worker = nullptr;
+    }
+}
+
+void PrintfOutputWorker::run(PrintfOutputWorker *self) {
+    std::unique_lock<std::mutex> lock(self->queueMutex);
+    while (true) {
+        self->condition.wait(lock, [self] { return !self->queue.empty() || self->stopRequested; });
+        if (self->queue.empty()) {
+            //stop is requested only after all scheduled output was printed
+            break;
+        }
+        auto printfHandler = std::move(self->queue.front());
+        self->queue.pop_front();
+        self->processing = true;
+        lock.unlock();
+
+        printfHandler->printEnqueueOutput();
+        printfHandler.reset();
+
+        lock.lock();
+        self->processing = false;
+        if (self->queue.empty()) {
+            self->queueDrained.notify_all();
+        }
+    }
+}
+} // namespace OCLRT
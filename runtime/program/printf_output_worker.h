@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace OCLRT {
+class PrintfHandler;
+
+// Formats printf output of completed enqueues on background thread, in submission order
+class PrintfOutputWorker {
+  public:
+    PrintfOutputWorker() = default;
+    virtual ~PrintfOutputWorker();
+
+    PrintfOutputWorker(const PrintfOutputWorker &) = delete;
+    PrintfOutputWorker &operator=(const PrintfOutputWorker &) = delete;
+
+    void schedule(std::unique_ptr<PrintfHandler> printfHandler);
+    void drain();
+
+  protected:
+    void stop();
+    static void run(PrintfOutputWorker *self);
+
+    std::deque<std::unique_ptr<PrintfHandler>> queue;
+    bool processing = false;
+    bool stopRequested = false;
+    std::thread *worker = nullptr;
+    std::mutex queueMutex;
+    std::condition_variable condition;
+    std::condition_variable queueDrained;
+};
+} // namespace OCLRT
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/program/printf_surface_pool.h"
+
+namespace OCLRT {
+
+GraphicsAllocation *PrintfSurfacePool::obtainSurface(MemoryManager &memoryManager, size_t size, volatile uint32_t *tagAddress) {
+    auto surface = surfaces.detachAllocation(size, tagAddress).release();
+    if (!surface) {
+        surface = memoryManager.createGraphicsAllocationWithRequiredBitness(size, nullptr);
+    }
+    return surface;
+}
+
+void PrintfSurfacePool::returnSurface(GraphicsAllocation *surface, uint32_t taskCount) {
+    surface->taskCount = taskCount;
+    surfaces.pushTailOne(*surface);
+}
+
+void PrintfSurfacePool::freeSurfaces(MemoryManager &memoryManager) {
+    std::unique_ptr<GraphicsAllocation> surface;
+    while ((surface = surfaces.detachAllocation(0)) != nullptr) {
+        memoryManager.freeGraphicsMemory(surface.release());
+    }
+}
+} // namespace OCLRT
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include "runtime/memory_manager/memory_manager.h"
+
+namespace OCLRT {
+
+// Per device cache of printf surfaces, surfaces are reused once GPU is done with them
+class PrintfSurfacePool {
+  public:
+    PrintfSurfacePool() = default;
+    PrintfSurfacePool(const PrintfSurfacePool &) = delete;
+    PrintfSurfacePool &operator=(const PrintfSurfacePool &) = delete;
+
+    GraphicsAllocation *obtainSurface(MemoryManager &memoryManager, size_t size, volatile uint32_t *tagAddress);
+    void returnSurface(GraphicsAllocation *surface, uint32_t taskCount);
+    void freeSurfaces(MemoryManager &memoryManager);
+
+  protected:
+    AllocationsList surfaces;
+};
+} // namespace OCLRT
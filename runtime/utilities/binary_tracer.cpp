@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/utilities/binary_tracer.h"
+#include "runtime/os_interface/debug_settings_manager.h"
+#include <chrono>
+
+#if defined(_WIN32)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+namespace OCLRT {
+
+Tracer globalTracer;
+const uint32_t Tracer::drainIntervalInMs;
+
+void traceApiCall(const char *funcName, bool enter) {
+    globalTracer.record(TraceCategory::Api, enter ? TracePhase::Begin : TracePhase::End, funcName, 0);
+}
+
+namespace {
+struct ThreadTraceBuffer {
+    ~ThreadTraceBuffer() {
+        if (buffer) {
+            buffer->markOwnerExited();
+        }
+    }
+    // shared with the tracer, whichever lets go last frees the ring
+    std::shared_ptr<TraceRingBuffer> buffer;
+    uint32_t generation = 0;
+};
+thread_local ThreadTraceBuffer threadTraceBuffer;
+// generations are unique across tracer instances, a cached thread buffer is never reused by another tracer
+std::atomic<uint32_t> traceGenerationCounter{0};
+
+uint64_t getSteadyTimeInNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+const char *getCategoryName(TraceCategory category) {
+    switch (category) {
+    case TraceCategory::Api:
+        return "api";
+    case TraceCategory::Csr:
+        return "csr";
+    case TraceCategory::Os:
+        return "os";
+    case TraceCategory::Wait:
+        return "wait";
+    default:
+        return "memory";
+    }
+}
+
+const char *getPhaseName(TracePhase phase) {
+    switch (phase) {
+    case TracePhase::Begin:
+        return "B";
+    case TracePhase::End:
+        return "E";
+    default:
+        return "i";
+    }
+}
+} // namespace
+
+size_t TraceRingBuffer::drain(std::vector<TraceRecord> &output) {
+    auto read = readIndex.load(std::memory_order_relaxed);
+    auto write = writeIndex.load(std::memory_order_acquire);
+    for (auto index = read; index < write; index++) {
+        output.push_back(records[index & (capacity - 1)]);
+    }
+    readIndex.store(write, std::memory_order_release);
+    return static_cast<size_t>(write - read);
+}
+
+Tracer::Tracer() {
+    generation.store(++traceGenerationCounter);
+}
+
+Tracer::~Tracer() {
+    stopDrainer();
+}
+
+uint64_t Tracer::getTimestamp() {
+    return __rdtsc();
+}
+
+void Tracer::enable() {
+    std::unique_lock<std::mutex> lock(buffersMutex);
+    if (!isEnabled()) {
+        referenceTimestamp = getTimestamp();
+        referenceTimeInNs = getSteadyTimeInNs();
+        enabled.store(true);
+    }
+}
+
+void Tracer::disable() {
+    enabled.store(false);
+}
+
+TraceRingBuffer *Tracer::getThreadBuffer() {
+    auto currentGeneration = generation.load(std::memory_order_acquire);
+    if (threadTraceBuffer.generation != currentGeneration) {
+        std::unique_lock<std::mutex> lock(buffersMutex);
+        if (threadTraceBuffer.buffer) {
+            threadTraceBuffer.buffer->markOwnerExited();
+        }
+        threadTraceBuffer.buffer = std::make_shared<TraceRingBuffer>(nextThreadId++);
+        buffers.push_back(threadTraceBuffer.buffer);
+        threadTraceBuffer.generation = currentGeneration;
+    }
+    return threadTraceBuffer.buffer.get();
+}
+
+size_t Tracer::drain(std::vector<TraceRecord> &output) {
+    std::unique_lock<std::mutex> lock(buffersMutex);
+    size_t drained = 0;
+    for (auto it = buffers.begin(); it != buffers.end();) {
+        // checked before draining, an exited owner cannot push anything after it
+        auto ownerExited = (*it)->isOwnerExited();
+        drained += (*it)->drain(output);
+        if (ownerExited) {
+            droppedByExitedThreads += (*it)->peekDroppedCount();
+            it = buffers.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return drained;
+}
+
+uint64_t Tracer::getDroppedCount() {
+    std::unique_lock<std::mutex> lock(buffersMutex);
+    uint64_t dropped = droppedByExitedThreads;
+    for (auto &buffer : buffers) {
+        dropped += buffer->peekDroppedCount();
+    }
+    return dropped;
+}
+
+size_t Tracer::getBufferCount() {
+    std::unique_lock<std::mutex> lock(buffersMutex);
+    return buffers.size();
+}
+
+void Tracer::releaseBuffers() {
+    std::unique_lock<std::mutex> lock(buffersMutex);
+    buffers.clear();
+    droppedByExitedThreads = 0;
+    nextThreadId = 0;
+    generation.store(++traceGenerationCounter, std::memory_order_release);
+}
+
+double Tracer::getTicksPerMicrosecond() const {
+    auto elapsedTicks = getTimestamp() - referenceTimestamp;
+    auto elapsedNs = getSteadyTimeInNs() - referenceTimeInNs;
+    if (elapsedNs < 1000 || elapsedTicks == 0) {
+        return 1.0;
+    }
+    return static_cast<double>(elapsedTicks) * 1000.0 / static_cast<double>(elapsedNs);
+}
+
+void Tracer::exportChromeTrace(const std::vector<TraceRecord> &records, std::ostream &out, bool &firstRecord) const {
+    auto ticksPerUs = getTicksPerMicrosecond();
+    for (auto &record : records) {
+        auto ticks = record.timestamp > referenceTimestamp ? record.timestamp - referenceTimestamp : 0;
+        out << (firstRecord ? "" : ",\n");
+        out << "{\"name\":\"" << (record.name ? record.name : "") << "\""
+            << ",\"cat\":\"" << getCategoryName(record.category) << "\""
+            << ",\"ph\":\"" << getPhaseName(record.phase) << "\""
+            << ",\"ts\":" << static_cast<double>(ticks) / ticksPerUs
+            << ",\"pid\":0,\"tid\":" << record.threadId;
+        if (record.phase == TracePhase::Instant) {
+            out << ",\"s\":\"t\"";
+        }
+        if (record.phase != TracePhase::End) {
+            out << ",\"args\":{\"value\":" << record.payload << "}";
+        }
+        out << "}";
+        firstRecord = false;
+    }
+}
+
+bool Tracer::startDrainer(const std::string &fileName) {
+    if (drainerThread) {
+        return true;
+    }
+    traceFile.open(fileName, std::ios::out | std::ios::trunc);
+    if (!traceFile.is_open()) {
+        return false;
+    }
+    traceFile << "{\"traceEvents\":[\n";
+    traceFileEmpty = true;
+    drainerStopRequested = false;
+    enable();
+    drainerThread.reset(new std::thread([this] { drainerLoop(); }));
+    return true;
+}
+
+void Tracer::stopDrainer() {
+    if (!drainerThread) {
+        return;
+    }
+    {
+        std::unique_lock<std::mutex> lock(drainerMutex);
+        drainerStopRequested = true;
+    }
+    drainerCond.notify_one();
+    drainerThread->join();
+    drainerThread.reset();
+
+    std::vector<TraceRecord> records;
+    drain(records);
+    exportChromeTrace(records, traceFile, traceFileEmpty);
+    traceFile << "\n]}\n";
+    traceFile.close();
+}
+
+void Tracer::drainerLoop() {
+    std::vector<TraceRecord> records;
+    records.reserve(TraceRingBuffer::capacity);
+    std::unique_lock<std::mutex> lock(drainerMutex);
+    while (!drainerStopRequested) {
+        drainerCond.wait_for(lock, std::chrono::milliseconds(drainIntervalInMs));
+        records.clear();
+        drain(records);
+        exportChromeTrace(records, traceFile, traceFileEmpty);
+    }
+}
+} // namespace OCLRT
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace OCLRT {
+
+enum class TraceCategory : uint16_t {
+    Api,
+    Csr,
+    Os,
+    Wait,
+    Memory
+};
+
+enum class TracePhase : uint16_t {
+    Begin,
+    End,
+    Instant
+};
+
+// name must point to a string with static storage duration, it is dereferenced only when exporting
+struct TraceRecord {
+    uint64_t timestamp;
+    uint64_t payload;
+    const char *name;
+    uint32_t threadId;
+    TraceCategory category;
+    TracePhase phase;
+};
+
+// Single producer (owning thread), single consumer (drainer) ring of fixed-size records.
+// Records pushed while the ring is full are dropped and counted.
+class TraceRingBuffer {
+  public:
+    static const uint32_t capacity = 4096;
+
+    TraceRingBuffer(uint32_t threadId) : threadId(threadId) {}
+
+    bool push(TraceCategory category, TracePhase phase, const char *name, uint64_t payload, uint64_t timestamp) {
+        auto write = writeIndex.load(std::memory_order_relaxed);
+        if (write - readIndex.load(std::memory_order_acquire) >= capacity) {
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        auto &record = records[write & (capacity - 1)];
+        record.timestamp = timestamp;
+        record.payload = payload;
+        record.name = name;
+        record.threadId = threadId;
+        record.category = category;
+        record.phase = phase;
+        writeIndex.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t drain(std::vector<TraceRecord> &output);
+
+    uint64_t peekDroppedCount() const { return droppedCount.load(std::memory_order_relaxed); }
+    uint32_t getThreadId() const { return threadId; }
+
+    // set by the owning thread on exit, the tracer frees the ring once it is drained
+    void markOwnerExited() { ownerExited.store(true, std::memory_order_release); }
+    bool isOwnerExited() const { return ownerExited.load(std::memory_order_acquire); }
+
+  protected:
+    std::atomic<bool> ownerExited{false};
+    std::atomic<uint64_t> writeIndex{0};
+    std::atomic<uint64_t> readIndex{0};
+    std::atomic<uint64_t> droppedCount{0};
+    uint32_t threadId;
+    TraceRecord records[capacity];
+};
+
+// Records API calls, flushes, waits and allocations into per-thread rings. It runs alongside
+// LogApiCalls and PerfProfiler, which keep their own text outputs.
+class Tracer {
+  public:
+    static const uint32_t drainIntervalInMs = 10;
+
+    Tracer();
+    ~Tracer();
+
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+    void enable();
+    void disable();
+
+    void record(TraceCategory category, TracePhase phase, const char *name, uint64_t payload) {
+        if (isEnabled()) {
+            getThreadBuffer()->push(category, phase, name, payload, getTimestamp());
+        }
+    }
+
+    // also frees rings of exited threads once their records are collected
+    size_t drain(std::vector<TraceRecord> &output);
+    uint64_t getDroppedCount();
+    size_t getBufferCount();
+
+    // Enables tracing and writes drained records as Chrome trace JSON from a background thread
+    bool startDrainer(const std::string &fileName);
+    void stopDrainer();
+
+    // Must not race with recording threads
+    void releaseBuffers();
+
+    static uint64_t getTimestamp();
+    double getTicksPerMicrosecond() const;
+    void exportChromeTrace(const std::vector<TraceRecord> &records, std::ostream &out, bool &firstRecord) const;
+
+  protected:
+    TraceRingBuffer *getThreadBuffer();
+    void drainerLoop();
+
+    std::atomic<bool> enabled{false};
+    std::atomic<uint32_t> generation{0};
+    std::mutex buffersMutex;
+    std::vector<std::shared_ptr<TraceRingBuffer>> buffers;
+    uint64_t droppedByExitedThreads = 0;
+    uint32_t nextThreadId = 0;
+
+    uint64_t referenceTimestamp = 0;
+    uint64_t referenceTimeInNs = 0;
+
+    std::unique_ptr<std::thread> drainerThread;
+    std::mutex drainerMutex;
+    std::condition_variable drainerCond;
+    bool drainerStopRequested = false;
+    std::ofstream traceFile;
+    bool traceFileEmpty = true;
+};
+
+extern Tracer globalTracer;
+
+class TraceScope {
+  public:
+    TraceScope(TraceCategory category, const char *name, uint64_t payload)
+        : category(category), name(name) {
+        globalTracer.record(category, TracePhase::Begin, name, payload);
+    }
+    ~TraceScope() {
+        globalTracer.record(category, TracePhase::End, name, 0);
+    }
+
+  protected:
+    TraceCategory category;
+    const char *name;
+};
+} // namespace OCLRT
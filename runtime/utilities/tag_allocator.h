@@ -24,18 +24,21 @@
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/helpers/debug_helpers.h"
 #include "runtime/memory_manager/memory_manager.h"
-#include "runtime/utilities/idlist.h"
+#include "runtime/utilities/iflist.h"
 #include "runtime/utilities/tag_allocator_base.h"
 
+#include <atomic>
 #include <cstdint>
+#include <functional>
 #include <mutex>
+#include <thread>
 #include <vector>
 
 namespace OCLRT {
 class GraphicsAllocation;
 
 template <typename TagType>
-struct TagNode : public IDNode<TagNode<TagType>> {
+struct TagNode : public IFNode<TagNode<TagType>> {
   public:
     TagType *tag;
     GraphicsAllocation *getGraphicsAllocation() {
@@ -45,15 +48,70 @@ struct TagNode : public IDNode<TagNode<TagType>> {
   protected:
     TagNode() = default;
     GraphicsAllocation *gfxAllocation;
+    // deferred return, tag may be reused once *completionTagAddress reaches completionTaskCount
+    uint32_t completionTaskCount = 0;
+    volatile uint32_t *completionTagAddress = nullptr;
 
     template <typename TagType2>
     friend class TagAllocator;
 };
 
+// Lock-free stack of tag nodes. The head pointer shares one 64-bit word with a counter bumped on
+// every change, so a pop that raced with another thread popping and pushing back the same node fails
+// its compare exchange instead of installing a stale next pointer (ABA). Nodes are never freed while
+// the stack is in use, which makes reading next of a node popped concurrently safe.
+template <typename NodeType>
+class TagNodeStack {
+  public:
+    void push(NodeType &first, NodeType &last) {
+        uint64_t oldHead = head.load();
+        do {
+            last.next = getNode(oldHead);
+        } while (!head.compare_exchange_weak(oldHead, makeHead(&first, oldHead)));
+    }
+
+    NodeType *pop() {
+        uint64_t oldHead = head.load();
+        NodeType *node = nullptr;
+        do {
+            node = getNode(oldHead);
+            if (node == nullptr) {
+                return nullptr;
+            }
+        } while (!head.compare_exchange_weak(oldHead, makeHead(node->next, oldHead)));
+        node->next = nullptr;
+        return node;
+    }
+
+    NodeType *peekHead() const { return getNode(head.load()); }
+    void clear() { head = 0; }
+
+  protected:
+    // user space pointers fit in 48 bits on 64-bit platforms
+    static const uint32_t counterShift = sizeof(uintptr_t) == 8 ? 48 : 32;
+    static const uint64_t pointerMask = (1ull << counterShift) - 1;
+
+    static NodeType *getNode(uint64_t value) {
+        return reinterpret_cast<NodeType *>(static_cast<uintptr_t>(value & pointerMask));
+    }
+
+    static uint64_t makeHead(NodeType *node, uint64_t previousHead) {
+        auto pointer = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(node));
+        DEBUG_BREAK_IF((pointer & ~pointerMask) != 0);
+        return (((previousHead >> counterShift) + 1) << counterShift) | pointer;
+    }
+
+    std::atomic<uint64_t> head{0};
+};
+
+// Free tags are kept in lock-free stacks selected by thread id, so threads submitting in parallel
+// mostly work on their own stack. freeTagCount is raised before a push and lowered after a pop, so
+// it never undercounts: a new pool is allocated only when it is zero, i.e. when no tag is free anywhere.
 template <typename TagType>
 class TagAllocator : public TagAllocatorBase {
   public:
     using NodeType = TagNode<TagType>;
+    static const size_t freeTagListCount = 8;
 
     TagAllocator(MemoryManager *memMngr, size_t tagCount, size_t tagAlignment, size_t maxTagPoolCount) : memoryManager(memMngr),
                                                                                                          maxTagPoolCount(maxTagPoolCount),
@@ -66,7 +124,7 @@ class TagAllocator : public TagAllocatorBase {
             gfxAllocations.reserve(PrefferedProfilingTagPoolCount);
             tagPoolMemory.reserve(PrefferedProfilingTagPoolCount);
         }
-        populateFreeTags();
+        populateFreeTags(getFreeTagListIndex());
     }
 
     ~TagAllocator() override {
@@ -74,6 +132,12 @@ class TagAllocator : public TagAllocatorBase {
     }
 
     void cleanUpResources() override {
+        for (auto &freeTagList : freeTags) {
+            freeTagList.clear();
+        }
+        freeTagCount = 0;
+        deferredTags.detachNodes();
+
         size_t size = gfxAllocations.size();
 
         for (uint32_t i = 0; i < size; ++i) {
@@ -89,27 +153,44 @@ class TagAllocator : public TagAllocatorBase {
     }
 
     NodeType *getTag() {
-        NodeType *node = freeTags.removeFrontOne().release();
-        if (!node) {
-            populateFreeTags();
-            node = freeTags.removeFrontOne().release();
+        auto listIndex = getFreeTagListIndex();
+        NodeType *node = popFreeTag(listIndex);
+        while (!node && refillFreeTags(listIndex)) {
+            node = popFreeTag(listIndex);
         }
         if (node)
-            usedTags.pushFrontOne(*node);
+            usedTagCount++;
         return node;
     }
 
     void returnTag(NodeType *node) {
-        NodeType *usedNode = usedTags.removeOne(*node).release();
-        DEBUG_BREAK_IF(usedNode == nullptr);
-        ((void)(usedNode));
-        freeTags.pushFrontOne(*node);
+        DEBUG_BREAK_IF(usedTagCount == 0);
+        usedTagCount--;
+        pushFreeTags(getFreeTagListIndex(), *node, *node, 1);
     }
+
+    // returns tag whose memory may still be written by task taskCount of the receiver owning tagAddress
+    void returnTagWhenCompleted(NodeType *node, uint32_t taskCount, volatile uint32_t *tagAddress) {
+        if (tagAddress == nullptr || *tagAddress >= taskCount) {
+            returnTag(node);
+            return;
+        }
+        DEBUG_BREAK_IF(usedTagCount == 0);
+        usedTagCount--;
+        node->completionTaskCount = taskCount;
+        node->completionTagAddress = tagAddress;
+        deferredTags.pushFrontOne(*node);
+    }
+
     size_t peekMaxTagPoolCount() { return maxTagPoolCount; }
+    size_t peekUsedTagCount() const { return usedTagCount; }
 
   protected:
-    IDList<NodeType> freeTags;
-    IDList<NodeType> usedTags;
+    TagNodeStack<NodeType> freeTags[freeTagListCount];
+    std::atomic<size_t> freeTagCount{0};
+    // only detached under allocationsMutex, concurrent returns just push
+    IFList<NodeType, true> deferredTags;
+    std::atomic<size_t> usedTagCount{0};
     std::vector<GraphicsAllocation *> gfxAllocations;
     std::vector<NodeType *> tagPoolMemory;
 
@@ -120,36 +201,87 @@ class TagAllocator : public TagAllocatorBase {
 
     std::mutex allocationsMutex;
 
-    void populateFreeTags() {
+    static size_t getFreeTagListIndex() {
+        return std::hash<std::thread::id>()(std::this_thread::get_id()) % freeTagListCount;
+    }
+
+    void pushFreeTags(size_t listIndex, NodeType &first, NodeType &last, size_t count) {
+        freeTagCount += count;
+        freeTags[listIndex].push(first, last);
+    }
+
+    NodeType *popFreeTag(size_t listIndex) {
+        for (size_t i = 0; i < freeTagListCount; i++) {
+            NodeType *node = freeTags[(listIndex + i) % freeTagListCount].pop();
+            if (node) {
+                freeTagCount--;
+                return node;
+            }
+        }
+        return nullptr;
+    }
+
+    // returns false only when no tag is free and no new pool may be allocated
+    bool refillFreeTags(size_t listIndex) {
+        std::unique_lock<std::mutex> lock(allocationsMutex);
+        if (freeTagCount != 0) {
+            // returned meanwhile, or still being pushed by another thread
+            return true;
+        }
+        if (releaseCompletedTags(listIndex)) {
+            return true;
+        }
+        return populateFreeTags(listIndex);
+    }
+
+    bool releaseCompletedTags(size_t listIndex) {
+        bool released = false;
+        NodeType *node = deferredTags.detachNodes();
+        while (node) {
+            NodeType *next = node->slice();
+            if (*node->completionTagAddress >= node->completionTaskCount) {
+                pushFreeTags(listIndex, *node, *node, 1);
+                released = true;
+            } else {
+                deferredTags.pushFrontOne(*node);
+            }
+            node = next;
+        }
+        return released;
+    }
+
+    // called under allocationsMutex, or from the constructor
+    bool populateFreeTags(size_t listIndex) {
 
         size_t tagSize = sizeof(TagType);
         tagSize = alignUp(tagSize, tagAlignment);
         size_t allocationSizeRequired = tagCount * tagSize;
 
-        std::unique_lock<std::mutex> lock(allocationsMutex);
-
         size_t tagPoolCount = gfxAllocations.size();
-        if (tagPoolCount < maxTagPoolCount || maxTagPoolCount == 0) {
-            GraphicsAllocation *graphicsAllocation = memoryManager->allocateGraphicsMemory(allocationSizeRequired);
-            gfxAllocations.push_back(graphicsAllocation);
-
-            uintptr_t Size = graphicsAllocation->getUnderlyingBufferSize();
-            uintptr_t Start = reinterpret_cast<uintptr_t>(graphicsAllocation->getUnderlyingBuffer());
-            uintptr_t End = Start + Size;
-            size_t nodeCount = Size / tagSize;
-
-            NodeType *nodesMemory = new NodeType[nodeCount];
-
-            for (size_t i = 0; i < nodeCount; ++i) {
-                nodesMemory[i].gfxAllocation = graphicsAllocation;
-                nodesMemory[i].tag = reinterpret_cast<TagType *>(Start);
-                freeTags.pushTailOne(nodesMemory[i]);
-                Start += tagSize;
-            }
-            DEBUG_BREAK_IF(Start > End);
-            ((void)(End));
-            tagPoolMemory.push_back(nodesMemory);
+        if (tagPoolCount >= maxTagPoolCount && maxTagPoolCount != 0) {
+            return false;
+        }
+        GraphicsAllocation *graphicsAllocation = memoryManager->allocateDriverInternalGraphicsMemory(allocationSizeRequired, MemoryConstants::pageSize);
+        gfxAllocations.push_back(graphicsAllocation);
+
+        uintptr_t Size = graphicsAllocation->getUnderlyingBufferSize();
+        uintptr_t Start = reinterpret_cast<uintptr_t>(graphicsAllocation->getUnderlyingBuffer());
+        uintptr_t End = Start + Size;
+        size_t nodeCount = Size / tagSize;
+
+        NodeType *nodesMemory = new NodeType[nodeCount];
+
+        for (size_t i = 0; i < nodeCount; ++i) {
+            nodesMemory[i].gfxAllocation = graphicsAllocation;
+            nodesMemory[i].tag = reinterpret_cast<TagType *>(Start);
+            nodesMemory[i].next = (i + 1 < nodeCount) ? &nodesMemory[i + 1] : nullptr;
+            Start += tagSize;
         }
+        DEBUG_BREAK_IF(Start > End);
+        ((void)(End));
+        tagPoolMemory.push_back(nodesMemory);
+        pushFreeTags(listIndex, nodesMemory[0], nodesMemory[nodeCount - 1], nodeCount);
+        return true;
     }
 };
 } // namespace OCLRT
@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/utilities/tlsf_heap_allocator.h"
+#include "runtime/helpers/aligned_memory.h"
+#include "runtime/helpers/basic_math.h"
+#include "runtime/helpers/debug_helpers.h"
+#include "runtime/helpers/ptr_math.h"
+
+#include <algorithm>
+
+namespace OCLRT {
+
+const uint32_t TlsfHeapAllocator::secondLevelIndexLog2;
+const uint32_t TlsfHeapAllocator::secondLevelCount;
+const uint32_t TlsfHeapAllocator::firstLevelCount;
+const uint32_t TlsfHeapAllocator::invalidIndex;
+const size_t TlsfHeapAllocator::granularity;
+
+TlsfHeapAllocator::TlsfHeapAllocator(void *address, uint64_t size) : address(address), size(size), availableSize(size) {
+    for (auto &secondLevel : freeLists) {
+        std::fill(std::begin(secondLevel), std::end(secondLevel), invalidIndex);
+    }
+    auto units = size / granularity;
+    this->size = units * granularity;
+    this->availableSize = this->size;
+    if (units > 0) {
+        insertFreeBlock(createBlock(0, units));
+    }
+}
+
+void TlsfHeapAllocator::mapping(uint64_t units, uint32_t &fl, uint32_t &sl) {
+    if (units < secondLevelCount) {
+        fl = 0;
+        sl = static_cast<uint32_t>(units);
+    } else {
+        auto msb = static_cast<uint32_t>(Math::log2(units));
+        fl = msb - secondLevelIndexLog2 + 1;
+        sl = static_cast<uint32_t>(units >> (msb - secondLevelIndexLog2)) - secondLevelCount;
+    }
+}
+
+// rounds request up to next bin boundary, so any block found in resulting bin is large enough
+void TlsfHeapAllocator::mappingSearch(uint64_t units, uint32_t &fl, uint32_t &sl) {
+    if (units >= secondLevelCount) {
+        auto msb = static_cast<uint32_t>(Math::log2(units));
+        units += (1ull << (msb - secondLevelIndexLog2)) - 1;
+    }
+    mapping(units, fl, sl);
+}
+
+uint32_t TlsfHeapAllocator::findSuitableBlock(uint32_t &fl, uint32_t &sl) {
+    if (fl >= firstLevelCount) {
+        return invalidIndex;
+    }
+    uint32_t secondLevelMap = secondLevelBitmaps[fl] & (~0u << sl);
+    if (secondLevelMap == 0) {
+        if (fl + 1 >= firstLevelCount) {
+            return invalidIndex;
+        }
+        uint32_t firstLevelMap = firstLevelBitmap & (~0u << (fl + 1));
+        if (firstLevelMap == 0) {
+            return invalidIndex;
+        }
+        fl = Math::getMinLsbSet(firstLevelMap);
+        secondLevelMap = secondLevelBitmaps[fl];
+    }
+    sl = Math::getMinLsbSet(secondLevelMap);
+    return freeLists[fl][sl];
+}
+
+void TlsfHeapAllocator::insertFreeBlock(uint32_t index) {
+    uint32_t fl, sl;
+    mapping(blocks[index].units, fl, sl);
+
+    auto head = freeLists[fl][sl];
+    blocks[index].isFree = true;
+    blocks[index].prevFree = invalidIndex;
+    blocks[index].nextFree = head;
+    if (head != invalidIndex) {
+        blocks[head].prevFree = index;
+    }
+    freeLists[fl][sl] = index;
+    secondLevelBitmaps[fl] |= (1u << sl);
+    firstLevelBitmap |= (1u << fl);
+    statistics.freeBlockCount++;
+}
+
+void TlsfHeapAllocator::removeFreeBlock(uint32_t index) {
+    uint32_t fl, sl;
+    mapping(blocks[index].units, fl, sl);
+
+    auto prev = blocks[index].prevFree;
+    auto next = blocks[index].nextFree;
+    if (prev != invalidIndex) {
+        blocks[prev].nextFree = next;
+    }
+    if (next != invalidIndex) {
+        blocks[next].prevFree = prev;
+    }
+    if (freeLists[fl][sl] == index) {
+        freeLists[fl][sl] = next;
+        if (next == invalidIndex) {
+            secondLevelBitmaps[fl] &= ~(1u << sl);
+            if (secondLevelBitmaps[fl] == 0) {
+                firstLevelBitmap &= ~(1u << fl);
+            }
+        }
+    }
+    blocks[index].isFree = false;
+    statistics.freeBlockCount--;
+}
+
+uint32_t TlsfHeapAllocator::createBlock(uint64_t offset, uint64_t units) {
+    uint32_t index;
+    if (!unusedBlocks.empty()) {
+        index = unusedBlocks.back();
+        unusedBlocks.pop_back();
+    } else {
+        index = static_cast<uint32_t>(blocks.size());
+        blocks.emplace_back();
+    }
+    auto &block = blocks[index];
+    block.offset = offset;
+    block.units = units;
+    block.prevPhysical = invalidIndex;
+    block.nextPhysical = invalidIndex;
+    block.prevFree = invalidIndex;
+    block.nextFree = invalidIndex;
+    block.isFree = false;
+    return index;
+}
+
+void TlsfHeapAllocator::releaseBlock(uint32_t index) {
+    unusedBlocks.push_back(index);
+}
+
+void TlsfHeapAllocator::mergeWithNext(uint32_t index) {
+    auto next = blocks[index].nextPhysical;
+    DEBUG_BREAK_IF(next == invalidIndex);
+    auto nextOfNext = blocks[next].nextPhysical;
+    blocks[index].units += blocks[next].units;
+    blocks[index].nextPhysical = nextOfNext;
+    if (nextOfNext != invalidIndex) {
+        blocks[nextOfNext].prevPhysical = index;
+    }
+    releaseBlock(next);
+}
+
+void *TlsfHeapAllocator::allocate(size_t &sizeToAllocate) {
+    std::lock_guard<std::mutex> lock(mtx);
+    sizeToAllocate = alignUp(sizeToAllocate, granularity);
+    uint64_t units = std::max(static_cast<uint64_t>(sizeToAllocate / granularity), static_cast<uint64_t>(1u));
+
+    if (units * granularity > availableSize) {
+        statistics.failedAllocationCount++;
+        return nullptr;
+    }
+
+    uint32_t fl, sl;
+    mappingSearch(units, fl, sl);
+    auto index = findSuitableBlock(fl, sl);
+
+    if (index == invalidIndex) {
+        // rounded up request found nothing, blocks in exact size bin may still fit
+        mapping(units, fl, sl);
+        for (index = freeLists[fl][sl]; index != invalidIndex; index = blocks[index].nextFree) {
+            if (blocks[index].units >= units) {
+                break;
+            }
+        }
+        if (index == invalidIndex) {
+            statistics.failedAllocationCount++;
+            return nullptr;
+        }
+    }
+
+    removeFreeBlock(index);
+
+    if (blocks[index].units > units) {
+        auto remainder = createBlock(blocks[index].offset + units, blocks[index].units - units);
+        auto next = blocks[index].nextPhysical;
+        blocks[remainder].prevPhysical = index;
+        blocks[remainder].nextPhysical = next;
+        if (next != invalidIndex) {
+            blocks[next].prevPhysical = remainder;
+        }
+        blocks[index].nextPhysical = remainder;
+        blocks[index].units = units;
+        insertFreeBlock(remainder);
+    }
+
+    usedBlocks[blocks[index].offset] = index;
+
+    sizeToAllocate = static_cast<size_t>(units * granularity);
+    availableSize -= sizeToAllocate;
+    statistics.allocationCount++;
+    statistics.peakUsedSize = std::max(statistics.peakUsedSize, size - availableSize);
+
+    return ptrOffset(address, static_cast<size_t>(blocks[index].offset * granularity));
+}
+
+void TlsfHeapAllocator::free(void *ptr, size_t size) {
+    if (ptr == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mtx);
+
+    auto offset = static_cast<uint64_t>(ptrDiff(ptr, address)) / granularity;
+    auto it = usedBlocks.find(offset);
+    if (it == usedBlocks.end()) {
+        DEBUG_BREAK_IF(true);
+        return;
+    }
+    auto index = it->second;
+    usedBlocks.erase(it);
+    DEBUG_BREAK_IF(alignUp(size, granularity) != blocks[index].units * granularity);
+
+    availableSize += blocks[index].units * granularity;
+    statistics.freeCount++;
+
+    auto next = blocks[index].nextPhysical;
+    if (next != invalidIndex && blocks[next].isFree) {
+        removeFreeBlock(next);
+        mergeWithNext(index);
+    }
+    auto prev = blocks[index].prevPhysical;
+    if (prev != invalidIndex && blocks[prev].isFree) {
+        removeFreeBlock(prev);
+        mergeWithNext(prev);
+        index = prev;
+    }
+    insertFreeBlock(index);
+}
+
+uint64_t TlsfHeapAllocator::getLeftSize() {
+    return availableSize;
+}
+
+uint64_t TlsfHeapAllocator::getUsedSize() {
+    return size - availableSize;
+}
+
+double TlsfHeapAllocator::getUsage() {
+    return 1.0 * (size - availableSize) / (size * 1.0);
+}
+
+TlsfHeapAllocator::Statistics TlsfHeapAllocator::getStatistics() {
+    std::lock_guard<std::mutex> lock(mtx);
+    Statistics result = statistics;
+    result.usedBlockCount = usedBlocks.size();
+    result.usedSize = size - availableSize;
+    result.largestFreeBlockSize = 0;
+    if (firstLevelBitmap != 0) {
+        auto fl = Math::log2(firstLevelBitmap);
+        auto sl = Math::log2(secondLevelBitmaps[fl]);
+        for (auto index = freeLists[fl][sl]; index != invalidIndex; index = blocks[index].nextFree) {
+            result.largestFreeBlockSize = std::max(result.largestFreeBlockSize, blocks[index].units * granularity);
+        }
+    }
+    return result;
+}
+} // namespace OCLRT
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include "runtime/memory_manager/memory_constants.h"
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace OCLRT {
+
+// Two-level segregated fit allocator of address range, constant time allocate and free.
+// Block bookkeeping is kept out of managed range, so it may cover memory not accessible by CPU.
+class TlsfHeapAllocator {
+  public:
+    struct Statistics {
+        uint64_t allocationCount = 0;
+        uint64_t freeCount = 0;
+        uint64_t failedAllocationCount = 0;
+        uint64_t usedBlockCount = 0;
+        uint64_t freeBlockCount = 0;
+        uint64_t usedSize = 0;
+        uint64_t peakUsedSize = 0;
+        uint64_t largestFreeBlockSize = 0;
+    };
+
+    TlsfHeapAllocator(void *address, uint64_t size);
+
+    void *allocate(size_t &sizeToAllocate);
+    void free(void *ptr, size_t size);
+
+    uint64_t getLeftSize();
+    uint64_t getUsedSize();
+    double getUsage();
+    Statistics getStatistics();
+
+  protected:
+    static const uint32_t secondLevelIndexLog2 = 4;
+    static const uint32_t secondLevelCount = 1u << secondLevelIndexLog2;
+    static const uint32_t firstLevelCount = 32;
+    static const uint32_t invalidIndex = 0xffffffffu;
+    static const size_t granularity = MemoryConstants::pageSize;
+
+    struct Block {
+        uint64_t offset;
+        uint64_t units;
+        uint32_t prevPhysical;
+        uint32_t nextPhysical;
+        uint32_t prevFree;
+        uint32_t nextFree;
+        bool isFree;
+    };
+
+    static void mapping(uint64_t units, uint32_t &fl, uint32_t &sl);
+    static void mappingSearch(uint64_t units, uint32_t &fl, uint32_t &sl);
+    uint32_t findSuitableBlock(uint32_t &fl, uint32_t &sl);
+    void insertFreeBlock(uint32_t index);
+    void removeFreeBlock(uint32_t index);
+    uint32_t createBlock(uint64_t offset, uint64_t units);
+    void releaseBlock(uint32_t index);
+    void mergeWithNext(uint32_t index);
+
+    void *address;
+    uint64_t size;
+    uint64_t availableSize;
+
+    std::vector<Block> blocks;
+    std::vector<uint32_t> unusedBlocks;
+    std::unordered_map<uint64_t, uint32_t> usedBlocks;
+    uint32_t firstLevelBitmap = 0;
+    uint32_t secondLevelBitmaps[firstLevelCount] = {};
+    uint32_t freeLists[firstLevelCount][secondLevelCount];
+
+    Statistics statistics;
+    std::mutex mtx;
+};
+} // namespace OCLRT
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_queue/blocked_commands_pool.h"
+#include "runtime/memory_manager/memory_constants.h"
+
+#include "gtest/gtest.h"
+
+#include <utility>
+#include <vector>
+
+using namespace OCLRT;
+
+struct MockBlockedCommandsPool : public BlockedCommandsPool {
+    using BlockedCommandsPool::getClassSize;
+    using BlockedCommandsPool::getSizeClass;
+};
+
+TEST(BlockedCommandsPoolTest, givenSizeWhenObtainingBufferThenSizeIsRoundedUpToPowerOfTwoPages) {
+    BlockedCommandsPool pool;
+    size_t obtainedSize = 0;
+
+    auto buffer = pool.obtain(1, obtainedSize);
+    EXPECT_NE(nullptr, buffer);
+    EXPECT_EQ(MemoryConstants::pageSize, obtainedSize);
+    pool.release(buffer, obtainedSize);
+
+    buffer = pool.obtain(3 * MemoryConstants::pageSize, obtainedSize);
+    EXPECT_NE(nullptr, buffer);
+    EXPECT_EQ(4 * MemoryConstants::pageSize, obtainedSize);
+    pool.release(buffer, obtainedSize);
+}
+
+TEST(BlockedCommandsPoolTest, givenReleasedBufferWhenObtainingSameSizeClassThenBufferIsReused) {
+    BlockedCommandsPool pool;
+    size_t obtainedSize = 0;
+
+    auto buffer = pool.obtain(MemoryConstants::pageSize + 1, obtainedSize);
+    EXPECT_EQ(1u, pool.peekSystemAllocationsCount());
+    pool.release(buffer, obtainedSize);
+    EXPECT_EQ(1u, pool.peekCachedBuffersCount());
+
+    size_t secondSize = 0;
+    auto secondBuffer = pool.obtain(2 * MemoryConstants::pageSize, secondSize);
+    EXPECT_EQ(buffer, secondBuffer);
+    EXPECT_EQ(obtainedSize, secondSize);
+    EXPECT_EQ(1u, pool.peekSystemAllocationsCount());
+    EXPECT_EQ(0u, pool.peekCachedBuffersCount());
+    pool.release(secondBuffer, secondSize);
+}
+
+TEST(BlockedCommandsPoolTest, givenReleasedBufferWhenObtainingDifferentSizeClassThenNewBufferIsAllocated) {
+    BlockedCommandsPool pool;
+    size_t obtainedSize = 0;
+
+    auto buffer = pool.obtain(MemoryConstants::pageSize, obtainedSize);
+    pool.release(buffer, obtainedSize);
+
+    size_t biggerSize = 0;
+    auto biggerBuffer = pool.obtain(2 * MemoryConstants::pageSize, biggerSize);
+    EXPECT_EQ(2u, pool.peekSystemAllocationsCount());
+    EXPECT_EQ(1u, pool.peekCachedBuffersCount());
+    pool.release(biggerBuffer, biggerSize);
+    EXPECT_EQ(2u, pool.peekCachedBuffersCount());
+}
+
+TEST(BlockedCommandsPoolTest, givenBufferBiggerThanLargestClassWhenReleasedThenItIsNotCached) {
+    BlockedCommandsPool pool;
+    size_t obtainedSize = 0;
+    auto largestClassSize = MockBlockedCommandsPool::getClassSize(BlockedCommandsPool::numSizeClasses - 1);
+
+    auto buffer = pool.obtain(largestClassSize + 1, obtainedSize);
+    EXPECT_NE(nullptr, buffer);
+    EXPECT_LE(largestClassSize + 1, obtainedSize);
+    pool.release(buffer, obtainedSize);
+    EXPECT_EQ(0u, pool.peekCachedBuffersCount());
+}
+
+TEST(BlockedCommandsPoolTest, givenBufferWithNonClassSizeWhenReleasedThenItIsNotCached) {
+    BlockedCommandsPool pool;
+    size_t obtainedSize = 0;
+    auto buffer = pool.obtain(MemoryConstants::pageSize, obtainedSize);
+    pool.release(buffer, obtainedSize - 1);
+    EXPECT_EQ(0u, pool.peekCachedBuffersCount());
+}
+
+TEST(BlockedCommandsPoolTest, givenFullSizeClassWhenReleasingThenBufferIsFreed) {
+    BlockedCommandsPool pool;
+    void *buffers[BlockedCommandsPool::maxCachedBuffersPerClass + 1];
+    size_t obtainedSize = 0;
+    for (auto &buffer : buffers) {
+        buffer = pool.obtain(MemoryConstants::pageSize, obtainedSize);
+    }
+    for (auto &buffer : buffers) {
+        pool.release(buffer, obtainedSize);
+    }
+    EXPECT_EQ(BlockedCommandsPool::maxCachedBuffersPerClass, pool.peekCachedBuffersCount());
+}
+
+TEST(BlockedCommandsPoolTest, givenNullBufferWhenReleasingThenNothingIsCached) {
+    BlockedCommandsPool pool;
+    pool.release(nullptr, MemoryConstants::pageSize);
+    EXPECT_EQ(0u, pool.peekCachedBuffersCount());
+}
+
+TEST(BlockedCommandsPoolTest, givenManyReleasedBuffersWhenClassesFillUpThenCachedBytesStayWithinBudget) {
+    const size_t budget = 16 * MemoryConstants::pageSize;
+    BlockedCommandsPool pool(budget);
+    std::vector<std::pair<void *, size_t>> buffers;
+    for (uint32_t sizeClass = 0; sizeClass < 4; sizeClass++) {
+        for (size_t i = 0; i < BlockedCommandsPool::maxCachedBuffersPerClass; i++) {
+            size_t obtainedSize = 0;
+            auto buffer = pool.obtain(MockBlockedCommandsPool::getClassSize(sizeClass), obtainedSize);
+            buffers.push_back(std::make_pair(buffer, obtainedSize));
+        }
+    }
+    for (auto &buffer : buffers) {
+        pool.release(buffer.first, buffer.second);
+        EXPECT_LE(pool.peekCachedBytes(), budget);
+    }
+    EXPECT_LT(0u, pool.peekCachedBuffersCount());
+}
+
+TEST(BlockedCommandsPoolTest, givenReleaseOverBudgetWhenEvictingThenLargestBuffersAreFreedFirst) {
+    BlockedCommandsPool pool(8 * MemoryConstants::pageSize);
+    size_t smallSize = 0;
+    size_t largeSize = 0;
+    auto small = pool.obtain(MemoryConstants::pageSize, smallSize);
+    auto large = pool.obtain(4 * MemoryConstants::pageSize, largeSize);
+    auto secondLarge = pool.obtain(4 * MemoryConstants::pageSize, largeSize);
+
+    pool.release(large, largeSize);
+    pool.release(secondLarge, largeSize);
+    EXPECT_EQ(8 * MemoryConstants::pageSize, pool.peekCachedBytes());
+    EXPECT_EQ(2u, pool.peekCachedBuffersCount());
+
+    pool.release(small, smallSize);
+    EXPECT_EQ(5 * MemoryConstants::pageSize, pool.peekCachedBytes());
+    EXPECT_EQ(2u, pool.peekCachedBuffersCount());
+
+    size_t obtainedSize = 0;
+    auto reused = pool.obtain(MemoryConstants::pageSize, obtainedSize);
+    EXPECT_EQ(small, reused);
+    EXPECT_EQ(4 * MemoryConstants::pageSize, pool.peekCachedBytes());
+    pool.release(reused, obtainedSize);
+}
+
+TEST(BlockedCommandsPoolTest, givenBufferLargerThanBudgetWhenReleasedThenItIsNotCached) {
+    BlockedCommandsPool pool(2 * MemoryConstants::pageSize);
+    size_t obtainedSize = 0;
+    auto buffer = pool.obtain(4 * MemoryConstants::pageSize, obtainedSize);
+    pool.release(buffer, obtainedSize);
+    EXPECT_EQ(0u, pool.peekCachedBuffersCount());
+    EXPECT_EQ(0u, pool.peekCachedBytes());
+}
@@ -542,6 +542,31 @@ HWTEST_F(BlockedCommandQueueTest, givenEnqueueBlockedByUserEventWhenItIsEnqueued
     EXPECT_EQ(currentRefCount, mockKernel->getRefInternalCount());
 }
 
+HWTEST_F(BlockedCommandQueueTest, givenBlockedKernelWithScratchWhenItIsSubmittedThenScratchRequirementIsRecordedOnlyAtSubmission) {
+    UserEvent userEvent(context);
+    MockKernelWithInternals mockKernelWithInternals(*pDevice);
+    auto mockKernel = mockKernelWithInternals.mockKernel;
+
+    SPatchMediaVFEState mediaVFEstate;
+    mediaVFEstate.PerThreadScratchSpace = 1024;
+    mockKernelWithInternals.kernelInfo.patchInfo.mediavfestate = &mediaVFEstate;
+
+    size_t offset = 0;
+    size_t size = 1;
+    cl_event blockedEvent = &userEvent;
+
+    auto &commandStreamReceiver = pDevice->getCommandStreamReceiver();
+    auto requiredScratchSizeBefore = commandStreamReceiver.peekRequiredScratchSize();
+    ASSERT_LT(requiredScratchSizeBefore, mediaVFEstate.PerThreadScratchSpace);
+
+    pCmdQ->enqueueKernel(mockKernel, 1, &offset, &size, &size, 1, &blockedEvent, nullptr);
+    // tasks flushed while the kernel is blocked must not count it in their scratch usage window
+    EXPECT_EQ(requiredScratchSizeBefore, commandStreamReceiver.peekRequiredScratchSize());
+
+    userEvent.setStatus(CL_COMPLETE);
+    EXPECT_EQ(mediaVFEstate.PerThreadScratchSpace, commandStreamReceiver.peekRequiredScratchSize());
+}
+
 typedef CommandQueueHwTest CommandQueueHwRefCountTest;
 
 HWTEST_F(CommandQueueHwRefCountTest, givenBlockedCmdQWhenNewBlockedEnqueueReplacesVirtualEventThenPreviousVirtualEventDecrementsCmdQRefCount) {
@@ -598,6 +598,27 @@ TEST_P(CommandQueueIndirectHeapTest, GivenCommandQueueWithHeapWhenGraphicAllocat
     memoryManager->freeGraphicsMemory(allocation);
 }
 
+TEST_P(CommandQueueIndirectHeapTest, givenSharedIndirectHeapsWhenQueuesAskForHeapThenHeapOwnedByCommandStreamReceiverIsSuballocated) {
+    auto &commandStreamReceiver = pDevice->getCommandStreamReceiver();
+    commandStreamReceiver.overrideSharedIndirectHeaps(true);
+
+    const cl_queue_properties props[3] = {CL_QUEUE_PROPERTIES, 0, 0};
+    CommandQueue cmdQ1(&context, pDevice, props);
+    CommandQueue cmdQ2(&context, pDevice, props);
+
+    auto &indirectHeap1 = cmdQ1.getIndirectHeap(this->GetParam(), 64);
+    auto usedByFirstQueue = indirectHeap1.getUsed() + 64;
+    indirectHeap1.getSpace(64);
+
+    auto &indirectHeap2 = cmdQ2.getIndirectHeap(this->GetParam(), 64);
+    EXPECT_EQ(&indirectHeap1, &indirectHeap2);
+    EXPECT_EQ(&commandStreamReceiver.getIndirectHeap(this->GetParam(), 0), &indirectHeap2);
+    EXPECT_EQ(usedByFirstQueue, indirectHeap2.getUsed());
+
+    cmdQ2.releaseIndirectHeap(this->GetParam());
+    EXPECT_EQ(nullptr, indirectHeap1.getGraphicsAllocation());
+}
+
 INSTANTIATE_TEST_CASE_P(
     Device,
     CommandQueueIndirectHeapTest,
@@ -22,6 +22,7 @@
 
 #include "test.h"
 #include "runtime/command_queue/dispatch_walker.h"
+#include "runtime/command_queue/command_queue_hw.h"
 #include "runtime/event/perf_counter.h"
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/helpers/kernel_commands.h"
@@ -1012,6 +1013,147 @@ HWTEST_F(DispatchWalkerTest, givenMultiDispatchWhenWhitelistedRegisterForCoheren
     }
 }
 
+HWTEST_F(DispatchWalkerTest, givenDispatchTemplatesEnabledWhenIdenticalDispatchIsReplayedThenCommandsAndIndirectDataMatchRegularPath) {
+    MockKernel kernel(&program, kernelInfo, *pDevice);
+    ASSERT_EQ(CL_SUCCESS, kernel.initialize());
+
+    size_t globalOffsets[3] = {0, 0, 0};
+    size_t workItems[3] = {256, 4, 1};
+    cl_uint dimensions = 2;
+
+    auto dispatch = [&](std::vector<char> &commands, std::vector<char> &indirectData) {
+        CommandQueueHw<FamilyType> cmdQ(nullptr, pDevice, 0);
+        auto &commandStream = cmdQ.getCS(4096);
+        auto &ioh = cmdQ.getIndirectHeap(IndirectHeap::INDIRECT_OBJECT, 4096);
+        auto commandStreamStart = commandStream.getUsed();
+        auto iohStart = ioh.getUsed();
+
+        dispatchWalker<FamilyType>(
+            cmdQ,
+            kernel,
+            dimensions,
+            globalOffsets,
+            workItems,
+            nullptr,
+            0,
+            nullptr,
+            nullptr,
+            nullptr,
+            nullptr,
+            pDevice->getPreemptionMode());
+
+        auto commandStreamBase = static_cast<char *>(commandStream.getCpuBase());
+        commands.assign(commandStreamBase + commandStreamStart, commandStreamBase + commandStream.getUsed());
+        auto iohBase = static_cast<char *>(ioh.getCpuBase());
+        indirectData.assign(iohBase + iohStart, iohBase + ioh.getUsed());
+    };
+
+    std::vector<char> referenceCommands, referenceIndirectData;
+    dispatch(referenceCommands, referenceIndirectData);
+    EXPECT_EQ(0u, kernel.getDispatchTemplates().getTemplateCount());
+
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.EnableDispatchTemplates.set(true);
+
+    std::vector<char> recordedCommands, recordedIndirectData;
+    dispatch(recordedCommands, recordedIndirectData);
+    EXPECT_EQ(1u, kernel.getDispatchTemplates().getTemplateCount());
+
+    std::vector<char> replayedCommands, replayedIndirectData;
+    dispatch(replayedCommands, replayedIndirectData);
+    EXPECT_EQ(1u, kernel.getDispatchTemplates().getTemplateCount());
+
+    EXPECT_EQ(referenceCommands, recordedCommands);
+    EXPECT_EQ(referenceIndirectData, recordedIndirectData);
+    EXPECT_EQ(referenceCommands, replayedCommands);
+    EXPECT_EQ(referenceIndirectData, replayedIndirectData);
+}
+
+HWTEST_F(DispatchWalkerTest, givenDispatchTemplatesEnabledWhenDispatchIsReplayedInSameQueueThenWalkerIndirectDataStartAddressIsRelocated) {
+    using GPGPU_WALKER = typename FamilyType::GPGPU_WALKER;
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.EnableDispatchTemplates.set(true);
+
+    MockKernel kernel(&program, kernelInfo, *pDevice);
+    ASSERT_EQ(CL_SUCCESS, kernel.initialize());
+
+    auto &cmdStream = pCmdQ->getCS(0);
+
+    size_t globalOffsets[3] = {0, 0, 0};
+    size_t workItems[3] = {64, 1, 1};
+    cl_uint dimensions = 1;
+    for (int i = 0; i < 2; i++) {
+        dispatchWalker<FamilyType>(
+            *pCmdQ,
+            kernel,
+            dimensions,
+            globalOffsets,
+            workItems,
+            nullptr,
+            0,
+            nullptr,
+            nullptr,
+            nullptr,
+            nullptr,
+            pDevice->getPreemptionMode());
+    }
+    EXPECT_EQ(1u, kernel.getDispatchTemplates().getTemplateCount());
+
+    HardwareParse hwParser;
+    hwParser.parseCommands<FamilyType>(cmdStream, 0);
+    hwParser.findHardwareCommands<FamilyType>();
+
+    auto walkerItor = hwParser.itorWalker;
+    ASSERT_NE(hwParser.cmdList.end(), walkerItor);
+    auto firstWalker = *reinterpret_cast<GPGPU_WALKER *>(*walkerItor);
+
+    walkerItor = find<GPGPU_WALKER *>(++walkerItor, hwParser.cmdList.end());
+    ASSERT_NE(hwParser.cmdList.end(), walkerItor);
+    auto secondWalker = *reinterpret_cast<GPGPU_WALKER *>(*walkerItor);
+
+    EXPECT_LT(firstWalker.getIndirectDataStartAddress(), secondWalker.getIndirectDataStartAddress());
+    secondWalker.setIndirectDataStartAddress(firstWalker.getIndirectDataStartAddress());
+    EXPECT_EQ(0, memcmp(&firstWalker, &secondWalker, sizeof(GPGPU_WALKER)));
+}
+
+HWTEST_F(DispatchWalkerTest, givenDispatchTemplatesEnabledWhenSlmSizeChangesBetweenDispatchesThenNewTemplateIsRecorded) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.EnableDispatchTemplates.set(true);
+
+    MockKernel kernel(&program, kernelInfo, *pDevice);
+    ASSERT_EQ(CL_SUCCESS, kernel.initialize());
+
+    size_t globalOffsets[3] = {0, 0, 0};
+    size_t workItems[3] = {64, 1, 1};
+    cl_uint dimensions = 1;
+    auto dispatch = [&]() {
+        dispatchWalker<FamilyType>(
+            *pCmdQ,
+            kernel,
+            dimensions,
+            globalOffsets,
+            workItems,
+            nullptr,
+            0,
+            nullptr,
+            nullptr,
+            nullptr,
+            nullptr,
+            pDevice->getPreemptionMode());
+    };
+
+    dispatch();
+    EXPECT_EQ(1u, kernel.getDispatchTemplates().getTemplateCount());
+
+    // local memory argument resized, as setArg does
+    kernel.slmTotalSize += 4 * KB;
+    dispatch();
+    EXPECT_EQ(2u, kernel.getDispatchTemplates().getTemplateCount());
+
+    dispatch();
+    EXPECT_EQ(2u, kernel.getDispatchTemplates().getTemplateCount());
+}
+
 TEST(DispatchWalker, calculateDispatchDim) {
     Vec3<size_t> dim0{0, 0, 0};
     Vec3<size_t> dim1{2, 1, 1};
@@ -83,6 +83,8 @@ struct EnqueueCopyBufferRectTest : public CommandEnqueueFixture,
 
         srcBuffer = BufferHelper<BufferRect>::create();
         dstBuffer = BufferHelper<BufferRect>::create();
+        srcBuffer->forceDisallowCPUCopy = true;
+        dstBuffer->forceDisallowCPUCopy = true;
     }
 
     virtual void TearDown(void) override {
@@ -241,6 +241,35 @@ HWTEST_F(EnqueueCopyImageTest, surfaceState) {
     EXPECT_EQ(reinterpret_cast<uint64_t>(dstImage->getCpuAddress()), dstSurfaceState.getSurfaceBaseAddress());
 }
 
+HWTEST_F(EnqueueCopyImageTest, givenRepeatedCopiesOfSameImagesWhenEnqueuedThenRedescribedViewsAreReused) {
+    auto retVal = EnqueueCopyImageHelper<>::enqueueCopyImage(pCmdQ, srcImage, dstImage);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    auto srcView = srcImage->getRedescribedView();
+    auto dstView = dstImage->getRedescribedView();
+    //only the image cache and this test hold views after enqueue completed
+    EXPECT_EQ(2, srcView->getReference());
+    EXPECT_EQ(2, dstView->getReference());
+    srcView->release();
+    dstView->release();
+
+    retVal = EnqueueCopyImageHelper<>::enqueueCopyImage(pCmdQ, srcImage, dstImage);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    parseCommands<FamilyType>(*pCmdQ);
+
+    auto srcView2 = srcImage->getRedescribedView();
+    auto dstView2 = dstImage->getRedescribedView();
+    EXPECT_EQ(srcView, srcView2);
+    EXPECT_EQ(dstView, dstView2);
+    srcView2->release();
+    dstView2->release();
+
+    const auto &srcSurfaceState = getSurfaceState<FamilyType>(0);
+    EXPECT_EQ(reinterpret_cast<uint64_t>(srcImage->getCpuAddress()), srcSurfaceState.getSurfaceBaseAddress());
+    const auto &dstSurfaceState = getSurfaceState<FamilyType>(1);
+    EXPECT_EQ(reinterpret_cast<uint64_t>(dstImage->getCpuAddress()), dstSurfaceState.getSurfaceBaseAddress());
+}
+
 HWTEST_F(EnqueueCopyImageTest, pipelineSelect) {
     enqueueCopyImage<FamilyType>();
     int numCommands = getNumberOfPipelineSelectsThatEnablePipelineSelect<FamilyType>();
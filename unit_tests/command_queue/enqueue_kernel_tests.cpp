@@ -1584,3 +1584,99 @@ TEST_F(EnqueueKernelTest, givenKernelWhenAllArgsAreNotAndEventExistSetThenClEnqu
 
     clReleaseCommandQueue(pCmdQ2);
 }
+
+static void setBufferArgument(MockKernelWithInternals &kernel, MockBuffer &buffer, const char *typeQualifier) {
+    std::vector<Kernel::SimpleKernelArgInfo> kernelArguments(1);
+    kernelArguments[0].type = Kernel::kernelArgType::BUFFER_OBJ;
+    kernelArguments[0].object = (cl_mem)&buffer;
+
+    kernel.kernelInfo.kernelArgInfo.resize(1);
+    kernel.kernelInfo.kernelArgInfo[0].typeQualifierStr = typeQualifier;
+    kernel.mockKernel->setKernelArguments(kernelArguments);
+}
+
+HWTEST_F(EnqueueKernelTest, givenResourceDependencyTrackingWhenSecondQueueWritesBufferWrittenByFirstQueueThenDependencyStallIsKept) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.EnableResourceDependencyTracking.set(true);
+
+    auto mockCsr = new MockCsrHw2<FamilyType>(pDevice->getHardwareInfo());
+    mockCsr->overrideDispatchPolicy(CommandStreamReceiver::DispatchMode::BatchedDispatch);
+    pDevice->resetCommandStreamReceiver(mockCsr);
+
+    CommandQueueHw<FamilyType> secondCmdQ(context, pDevice, 0);
+    MockBuffer sharedBuffer, otherBuffer;
+    MockKernelWithInternals firstKernel(*pDevice), secondKernel(*pDevice), thirdKernel(*pDevice);
+    setBufferArgument(firstKernel, sharedBuffer, "");
+    setBufferArgument(secondKernel, otherBuffer, "");
+    setBufferArgument(thirdKernel, sharedBuffer, "");
+
+    size_t gws[3] = {1, 0, 0};
+    pCmdQ->enqueueKernel(firstKernel.mockKernel, 1, nullptr, gws, nullptr, 0, nullptr, nullptr);
+    secondCmdQ.enqueueKernel(secondKernel.mockKernel, 1, nullptr, gws, nullptr, 0, nullptr, nullptr);
+    EXPECT_EQ(0u, mockCsr->peekLastStalledTaskCount());
+
+    secondCmdQ.enqueueKernel(thirdKernel.mockKernel, 1, nullptr, gws, nullptr, 0, nullptr, nullptr);
+
+    EXPECT_EQ(3u, mockCsr->peekTaskCount());
+    EXPECT_EQ(2u, mockCsr->peekLastStalledTaskCount());
+    EXPECT_EQ(3u, sharedBuffer.getGraphicsAllocation()->peekLastWriteTaskCount());
+}
+
+HWTEST_F(EnqueueKernelTest, givenResourceDependencyTrackingWhenSecondQueueWritesBufferDisjointFromFirstQueueThenDependencyStallIsDropped) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.EnableResourceDependencyTracking.set(true);
+
+    auto mockCsr = new MockCsrHw2<FamilyType>(pDevice->getHardwareInfo());
+    mockCsr->overrideDispatchPolicy(CommandStreamReceiver::DispatchMode::BatchedDispatch);
+    pDevice->resetCommandStreamReceiver(mockCsr);
+
+    CommandQueueHw<FamilyType> secondCmdQ(context, pDevice, 0);
+    MockBuffer firstBuffer, secondBuffer, thirdBuffer;
+    MockKernelWithInternals firstKernel(*pDevice), secondKernel(*pDevice), thirdKernel(*pDevice);
+    setBufferArgument(firstKernel, firstBuffer, "");
+    setBufferArgument(secondKernel, secondBuffer, "");
+    setBufferArgument(thirdKernel, thirdBuffer, "");
+
+    size_t gws[3] = {1, 0, 0};
+    pCmdQ->enqueueKernel(firstKernel.mockKernel, 1, nullptr, gws, nullptr, 0, nullptr, nullptr);
+    secondCmdQ.enqueueKernel(secondKernel.mockKernel, 1, nullptr, gws, nullptr, 0, nullptr, nullptr);
+    secondCmdQ.enqueueKernel(thirdKernel.mockKernel, 1, nullptr, gws, nullptr, 0, nullptr, nullptr);
+
+    EXPECT_EQ(3u, mockCsr->peekTaskCount());
+    EXPECT_EQ(0u, mockCsr->peekLastStalledTaskCount());
+    EXPECT_EQ(1u, firstBuffer.getGraphicsAllocation()->peekLastWriteTaskCount());
+    EXPECT_EQ(3u, thirdBuffer.getGraphicsAllocation()->peekLastWriteTaskCount());
+}
+
+HWTEST_F(EnqueueKernelTest, givenResourceDependencyTrackingWhenKernelBlockedByUserEventIsUnblockedThenItIsSubmittedWithStallAndItsAllocationsAreTrackedAsWritten) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.EnableResourceDependencyTracking.set(true);
+
+    auto mockCsr = new MockCsrHw2<FamilyType>(pDevice->getHardwareInfo());
+    mockCsr->overrideDispatchPolicy(CommandStreamReceiver::DispatchMode::BatchedDispatch);
+    pDevice->resetCommandStreamReceiver(mockCsr);
+
+    CommandQueueHw<FamilyType> secondCmdQ(context, pDevice, 0);
+    MockBuffer sharedBuffer;
+    MockKernelWithInternals writingKernel(*pDevice), readingKernel(*pDevice);
+    setBufferArgument(writingKernel, sharedBuffer, "");
+    setBufferArgument(readingKernel, sharedBuffer, "const");
+
+    size_t gws[3] = {1, 0, 0};
+    pCmdQ->enqueueKernel(writingKernel.mockKernel, 1, nullptr, gws, nullptr, 0, nullptr, nullptr);
+    EXPECT_EQ(0u, mockCsr->peekLastStalledTaskCount());
+
+    UserEvent userEvent(context);
+    cl_event blockingEvent = &userEvent;
+    secondCmdQ.enqueueKernel(readingKernel.mockKernel, 1, nullptr, gws, nullptr, 1, &blockingEvent, nullptr);
+    EXPECT_EQ(1u, mockCsr->peekTaskCount());
+
+    userEvent.setStatus(CL_COMPLETE);
+
+    EXPECT_EQ(2u, mockCsr->peekTaskCount());
+    EXPECT_TRUE(mockCsr->passedDispatchFlags.blocking);
+    EXPECT_EQ(nullptr, mockCsr->passedDispatchFlags.readOnlyAllocations);
+    EXPECT_EQ(2u, mockCsr->peekLastStalledTaskCount());
+    EXPECT_EQ(2u, sharedBuffer.getGraphicsAllocation()->peekLastWriteTaskCount());
+    EXPECT_LT(0, mockCsr->flushCalledCount);
+}
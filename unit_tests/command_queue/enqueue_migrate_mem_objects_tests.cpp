@@ -22,12 +22,20 @@
 
 #include "runtime/command_stream/command_stream_receiver.h"
 #include "runtime/event/event.h"
+#include "runtime/helpers/ptr_math.h"
+#include "runtime/mem_obj/buffer.h"
 #include "unit_tests/command_queue/command_queue_fixture.h"
 #include "unit_tests/command_stream/command_stream_fixture.h"
 #include "unit_tests/fixtures/device_fixture.h"
 #include "unit_tests/mocks/mock_buffer.h"
+#include "unit_tests/mocks/mock_command_queue.h"
+#include "unit_tests/mocks/mock_context.h"
+#include "unit_tests/mocks/mock_device.h"
+#include "unit_tests/mocks/mock_memory_manager.h"
 #include "test.h"
 
+#include <memory>
+
 using namespace OCLRT;
 
 class MigrateMemObjectsFixture
@@ -51,10 +59,11 @@ typedef Test<MigrateMemObjectsFixture> MigrateMemObjectsTest;
 TEST_F(MigrateMemObjectsTest, ValidInputsReturnsNullEvent) {
 
     MockBuffer buffer;
+    cl_mem memObj = &buffer;
 
     auto retVal = pCmdQ->enqueueMigrateMemObjects(
         1,
-        (cl_mem *)&buffer,
+        &memObj,
         CL_MIGRATE_MEM_OBJECT_HOST,
         0,
         nullptr,
@@ -66,13 +75,14 @@ TEST_F(MigrateMemObjectsTest, ValidInputsReturnsNullEvent) {
 TEST_F(MigrateMemObjectsTest, ValidInputsAndBlockedOnEventReturnsNullEvent) {
 
     MockBuffer buffer;
+    cl_mem memObj = &buffer;
 
     UserEvent uEvent;
     cl_event eventWaitList[] = {&uEvent};
 
     auto retVal = pCmdQ->enqueueMigrateMemObjects(
         1,
-        (cl_mem *)&buffer,
+        &memObj,
         CL_MIGRATE_MEM_OBJECT_HOST,
         1,
         eventWaitList,
@@ -84,12 +94,13 @@ TEST_F(MigrateMemObjectsTest, ValidInputsAndBlockedOnEventReturnsNullEvent) {
 TEST_F(MigrateMemObjectsTest, ValidInputsReturnsNonNullEvent) {
 
     MockBuffer buffer;
+    cl_mem memObj = &buffer;
 
     cl_event event = nullptr;
 
     auto retVal = pCmdQ->enqueueMigrateMemObjects(
         1,
-        (cl_mem *)&buffer,
+        &memObj,
         CL_MIGRATE_MEM_OBJECT_HOST,
         0,
         nullptr,
@@ -101,3 +112,101 @@ TEST_F(MigrateMemObjectsTest, ValidInputsReturnsNonNullEvent) {
     Event *eventObject = (Event *)event;
     delete eventObject;
 }
+
+class PrefetchCountingMemoryManager : public MockMemoryManager {
+  public:
+    void prefetchAllocations(ResidencyContainer &allocations) override {
+        prefetchCalled++;
+        prefetchedAllocations.insert(prefetchedAllocations.end(), allocations.begin(), allocations.end());
+    }
+    uint32_t prefetchCalled = 0u;
+    ResidencyContainer prefetchedAllocations;
+};
+
+HWTEST_F(MigrateMemObjectsTest, givenMigrationToDeviceWhenEnqueueMigrateMemObjectsIsCalledThenAllocationsArePrefetched) {
+    auto memoryManager = new PrefetchCountingMemoryManager;
+    std::unique_ptr<MockDevice> device(DeviceHelper<>::create(nullptr));
+    device->injectMemoryManager(memoryManager);
+    MockContext mockContext(device.get());
+    MockCommandQueueHw<FamilyType> cmdQ(&mockContext, device.get(), 0);
+
+    MockBuffer buffer1;
+    MockBuffer buffer2;
+    cl_mem memObjs[] = {&buffer1, &buffer2};
+
+    auto retVal = cmdQ.enqueueMigrateMemObjects(2, memObjs, 0, 0, nullptr, nullptr);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    EXPECT_EQ(1u, memoryManager->prefetchCalled);
+    ASSERT_EQ(2u, memoryManager->prefetchedAllocations.size());
+    EXPECT_EQ(buffer1.getGraphicsAllocation(), memoryManager->prefetchedAllocations[0]);
+    EXPECT_EQ(buffer2.getGraphicsAllocation(), memoryManager->prefetchedAllocations[1]);
+}
+
+HWTEST_F(MigrateMemObjectsTest, givenMigrationToHostWhenEnqueueMigrateMemObjectsIsCalledThenAllocationsAreNotPrefetched) {
+    auto memoryManager = new PrefetchCountingMemoryManager;
+    std::unique_ptr<MockDevice> device(DeviceHelper<>::create(nullptr));
+    device->injectMemoryManager(memoryManager);
+    MockContext mockContext(device.get());
+    MockCommandQueueHw<FamilyType> cmdQ(&mockContext, device.get(), 0);
+
+    MockBuffer buffer;
+    cl_mem memObj = &buffer;
+
+    auto retVal = cmdQ.enqueueMigrateMemObjects(1, &memObj, CL_MIGRATE_MEM_OBJECT_HOST, 0, nullptr, nullptr);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(0u, memoryManager->prefetchCalled);
+}
+
+TEST_F(MigrateMemObjectsTest, givenNonZeroCopyBufferWhenMigratedToHostThenDeviceContentIsCopiedToHostPtr) {
+    char hostMemory[MemoryConstants::cacheLineSize * 2];
+    auto unalignedHostPtr = ptrOffset(hostMemory, 1);
+    cl_int retVal = CL_SUCCESS;
+    std::unique_ptr<Buffer> buffer(Buffer::create(context, CL_MEM_USE_HOST_PTR, MemoryConstants::cacheLineSize, unalignedHostPtr, retVal));
+    ASSERT_NE(nullptr, buffer.get());
+    ASSERT_FALSE(buffer->isMemObjZeroCopy());
+    cl_mem memObj = buffer.get();
+
+    auto taskCountBefore = pCmdQ->taskCount;
+    retVal = pCmdQ->enqueueMigrateMemObjects(1, &memObj, CL_MIGRATE_MEM_OBJECT_HOST, 0, nullptr, nullptr);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_LT(taskCountBefore, pCmdQ->taskCount);
+}
+
+TEST_F(MigrateMemObjectsTest, givenNonZeroCopyBufferWhenMigratedToHostWithUndefinedContentThenNoCopyIsEnqueued) {
+    char hostMemory[MemoryConstants::cacheLineSize * 2];
+    auto unalignedHostPtr = ptrOffset(hostMemory, 1);
+    cl_int retVal = CL_SUCCESS;
+    std::unique_ptr<Buffer> buffer(Buffer::create(context, CL_MEM_USE_HOST_PTR, MemoryConstants::cacheLineSize, unalignedHostPtr, retVal));
+    ASSERT_NE(nullptr, buffer.get());
+    ASSERT_FALSE(buffer->isMemObjZeroCopy());
+    cl_mem memObj = buffer.get();
+
+    auto taskCountBefore = pCmdQ->taskCount;
+    retVal = pCmdQ->enqueueMigrateMemObjects(1, &memObj, CL_MIGRATE_MEM_OBJECT_HOST | CL_MIGRATE_MEM_OBJECT_CONTENT_UNDEFINED, 0, nullptr, nullptr);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(taskCountBefore, pCmdQ->taskCount);
+}
+
+TEST_F(MigrateMemObjectsTest, givenCopyHostPtrBufferWhenMigratedToHostThenItsHostPtrIsNotWritten) {
+    char hostMemory[MemoryConstants::cacheLineSize * 2];
+    auto unalignedHostPtr = ptrOffset(hostMemory, 1);
+    memset(hostMemory, 0x11, sizeof(hostMemory));
+    cl_int retVal = CL_SUCCESS;
+    std::unique_ptr<Buffer> buffer(Buffer::create(context, CL_MEM_COPY_HOST_PTR, MemoryConstants::cacheLineSize, unalignedHostPtr, retVal));
+    ASSERT_NE(nullptr, buffer.get());
+    cl_mem memObj = buffer.get();
+
+    // app is free to reuse or release memory passed with CL_MEM_COPY_HOST_PTR
+    memset(hostMemory, 0x22, sizeof(hostMemory));
+
+    auto taskCountBefore = pCmdQ->taskCount;
+    retVal = pCmdQ->enqueueMigrateMemObjects(1, &memObj, CL_MIGRATE_MEM_OBJECT_HOST, 0, nullptr, nullptr);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(taskCountBefore, pCmdQ->taskCount);
+
+    pCmdQ->finish(false);
+    char expectedMemory[sizeof(hostMemory)];
+    memset(expectedMemory, 0x22, sizeof(expectedMemory));
+    EXPECT_EQ(0, memcmp(expectedMemory, hostMemory, sizeof(hostMemory)));
+}
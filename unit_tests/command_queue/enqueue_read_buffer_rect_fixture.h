@@ -58,8 +58,10 @@ struct EnqueueReadBufferRectTest : public CommandEnqueueFixture,
             nullptr,
             retVal));
         ASSERT_NE(nullptr, buffer.get());
+        buffer->forceDisallowCPUCopy = true;
 
         nonZeroCopyBuffer.reset(BufferHelper<BufferUseHostPtr<>>::create());
+        nonZeroCopyBuffer->forceDisallowCPUCopy = true;
     }
 
     void TearDown() override {
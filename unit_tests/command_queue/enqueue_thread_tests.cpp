@@ -344,6 +344,7 @@ HWTEST_F(EnqueueThreading, enqueueReadBufferRect) {
 
     std::unique_ptr<Buffer> buffer(Buffer::create(context, CL_MEM_READ_WRITE, 1024u, nullptr, retVal));
     ASSERT_NE(nullptr, buffer.get());
+    buffer->forceDisallowCPUCopy = true;
 
     void *ptr = ::alignedMalloc(1024u, 4096);
     ASSERT_NE(nullptr, ptr);
@@ -393,6 +394,7 @@ HWTEST_F(EnqueueThreading, enqueueWriteBufferRect) {
 
     std::unique_ptr<Buffer> buffer(Buffer::create(context, CL_MEM_READ_WRITE, 1024u, nullptr, retVal));
     ASSERT_NE(nullptr, buffer.get());
+    buffer->forceDisallowCPUCopy = true;
 
     size_t bufferOrigin[3] = {1024u, 1, 0};
     size_t hostOrigin[3] = {1024u, 1, 0};
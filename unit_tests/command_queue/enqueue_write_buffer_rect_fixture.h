@@ -64,6 +64,8 @@ struct EnqueueWriteBufferRectTest : public CommandEnqueueFixture,
         nonZeroCopyBuffer.reset(BufferHelper<BufferUseHostPtr<>>::create());
 
         ASSERT_NE(nullptr, buffer.get());
+        buffer->forceDisallowCPUCopy = true;
+        nonZeroCopyBuffer->forceDisallowCPUCopy = true;
     }
 
     void TearDown() override {
@@ -21,6 +21,7 @@
  */
 
 #include "unit_tests/command_queue/enqueue_read_buffer_fixture.h"
+#include "runtime/event/user_event.h"
 #include "runtime/helpers/basic_math.h"
 #include "test.h"
 
@@ -286,4 +287,158 @@ HWTEST_F(ReadWriteBufferCpuCopyTest, cpuCopyCriteriaNotMet) {
     alignedFree(largeBufferPtr);
     alignedFree(alignedHostPtr);
     alignedFree(alignedBufferPtr);
-}
\ No newline at end of file
+}
+HWTEST_F(ReadWriteBufferCpuCopyTest, givenZeroCopyBufferWhenBlockingReadBufferRectIsEnqueuedThenRegionIsCopiedOnCpuWithoutGpuSubmission) {
+    cl_int retVal;
+    const size_t rowPitch = 64, slicePitch = 64 * 16;
+    const size_t hostRowPitch = 32, hostSlicePitch = 32 * 8;
+    size_t bufferOrigin[] = {10, 2, 1};
+    size_t hostOrigin[] = {4, 3, 0};
+    size_t region[] = {20, 4, 2};
+
+    auto deviceInfo = context->getDevice(0)->getMutableDeviceInfo();
+    deviceInfo->cpuCopyAllowed = true;
+
+    std::unique_ptr<Buffer> buffer(Buffer::create(context, CL_MEM_READ_WRITE, 3 * slicePitch, nullptr, retVal));
+    ASSERT_EQ(CL_SUCCESS, retVal);
+    ASSERT_TRUE(buffer->isMemObjZeroCopy());
+    auto bufferStorage = static_cast<uint8_t *>(buffer->getCpuAddressForMemoryTransfer());
+    for (size_t i = 0; i < 3 * slicePitch; i++) {
+        bufferStorage[i] = static_cast<uint8_t>(i * 3);
+    }
+    std::unique_ptr<uint8_t[]> hostMemory(new uint8_t[2 * hostSlicePitch]);
+    memset(hostMemory.get(), 0, 2 * hostSlicePitch);
+
+    auto taskCountBefore = pCmdQ->taskCount;
+    retVal = pCmdQ->enqueueReadBufferRect(buffer.get(), CL_TRUE, bufferOrigin, hostOrigin, region, rowPitch, slicePitch,
+                                          hostRowPitch, hostSlicePitch, hostMemory.get(), 0, nullptr, nullptr);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(taskCountBefore, pCmdQ->taskCount);
+
+    for (size_t z = 0; z < region[2]; z++) {
+        for (size_t y = 0; y < region[1]; y++) {
+            auto hostRow = ptrOffset(hostMemory.get(), (hostOrigin[2] + z) * hostSlicePitch + (hostOrigin[1] + y) * hostRowPitch + hostOrigin[0]);
+            auto bufferRow = ptrOffset(bufferStorage, (bufferOrigin[2] + z) * slicePitch + (bufferOrigin[1] + y) * rowPitch + bufferOrigin[0]);
+            EXPECT_EQ(0, memcmp(hostRow, bufferRow, region[0]));
+        }
+    }
+    EXPECT_EQ(0u, hostMemory[0]);
+}
+
+HWTEST_F(ReadWriteBufferCpuCopyTest, givenZeroCopyBufferWhenBlockingWriteBufferRectIsEnqueuedThenRegionIsCopiedOnCpuWithoutGpuSubmission) {
+    cl_int retVal;
+    const size_t rowPitch = 48, slicePitch = 48 * 8;
+    size_t bufferOrigin[] = {8, 1, 0};
+    size_t hostOrigin[] = {0, 0, 0};
+    size_t region[] = {16, 5, 1};
+
+    auto deviceInfo = context->getDevice(0)->getMutableDeviceInfo();
+    deviceInfo->cpuCopyAllowed = true;
+
+    std::unique_ptr<Buffer> buffer(Buffer::create(context, CL_MEM_READ_WRITE, slicePitch, nullptr, retVal));
+    ASSERT_EQ(CL_SUCCESS, retVal);
+    auto bufferStorage = static_cast<uint8_t *>(buffer->getCpuAddressForMemoryTransfer());
+    memset(bufferStorage, 0, slicePitch);
+
+    uint8_t hostMemory[16 * 5];
+    for (size_t i = 0; i < sizeof(hostMemory); i++) {
+        hostMemory[i] = static_cast<uint8_t>(i + 1);
+    }
+
+    auto taskCountBefore = pCmdQ->taskCount;
+    retVal = pCmdQ->enqueueWriteBufferRect(buffer.get(), CL_TRUE, bufferOrigin, hostOrigin, region, rowPitch, slicePitch,
+                                           region[0], region[0] * region[1], hostMemory, 0, nullptr, nullptr);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(taskCountBefore, pCmdQ->taskCount);
+
+    for (size_t y = 0; y < region[1]; y++) {
+        auto bufferRow = ptrOffset(bufferStorage, (bufferOrigin[1] + y) * rowPitch + bufferOrigin[0]);
+        EXPECT_EQ(0, memcmp(bufferRow, &hostMemory[y * region[0]], region[0]));
+        EXPECT_EQ(0u, bufferRow[-1]);
+        EXPECT_EQ(0u, bufferRow[region[0]]);
+    }
+}
+
+HWTEST_F(ReadWriteBufferCpuCopyTest, givenIdleQueueAndZeroCopyBuffersWhenCopyBufferRectIsEnqueuedThenRegionIsCopiedOnCpu) {
+    cl_int retVal;
+    const size_t rowPitch = 32, slicePitch = 32 * 4;
+    size_t srcOrigin[] = {0, 1, 0};
+    size_t dstOrigin[] = {4, 0, 1};
+    size_t region[] = {8, 3, 1};
+
+    auto deviceInfo = context->getDevice(0)->getMutableDeviceInfo();
+    deviceInfo->cpuCopyAllowed = true;
+
+    std::unique_ptr<Buffer> srcBuffer(Buffer::create(context, CL_MEM_READ_WRITE, 2 * slicePitch, nullptr, retVal));
+    std::unique_ptr<Buffer> dstBuffer(Buffer::create(context, CL_MEM_READ_WRITE, 2 * slicePitch, nullptr, retVal));
+    auto srcStorage = static_cast<uint8_t *>(srcBuffer->getCpuAddressForMemoryTransfer());
+    auto dstStorage = static_cast<uint8_t *>(dstBuffer->getCpuAddressForMemoryTransfer());
+    for (size_t i = 0; i < 2 * slicePitch; i++) {
+        srcStorage[i] = static_cast<uint8_t>(i);
+    }
+    memset(dstStorage, 0, 2 * slicePitch);
+    ASSERT_TRUE(pCmdQ->isCompleted(pCmdQ->taskCount));
+
+    auto taskCountBefore = pCmdQ->taskCount;
+    retVal = pCmdQ->enqueueCopyBufferRect(srcBuffer.get(), dstBuffer.get(), srcOrigin, dstOrigin, region,
+                                          rowPitch, slicePitch, rowPitch, slicePitch, 0, nullptr, nullptr);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(taskCountBefore, pCmdQ->taskCount);
+
+    for (size_t y = 0; y < region[1]; y++) {
+        EXPECT_EQ(0, memcmp(ptrOffset(dstStorage, slicePitch + y * rowPitch + dstOrigin[0]),
+                            ptrOffset(srcStorage, (srcOrigin[1] + y) * rowPitch), region[0]));
+    }
+}
+
+HWTEST_F(ReadWriteBufferCpuCopyTest, givenQueueBlockedByUserEventWhenCopyBufferRectIsEnqueuedThenItIsNotCopiedOnCpuAheadOfBlockedCommands) {
+    cl_int retVal;
+    const size_t rowPitch = 32, slicePitch = 32 * 4;
+    size_t origin[] = {0, 0, 0};
+    size_t region[] = {8, 3, 1};
+
+    auto deviceInfo = context->getDevice(0)->getMutableDeviceInfo();
+    deviceInfo->cpuCopyAllowed = true;
+
+    std::unique_ptr<Buffer> srcBuffer(Buffer::create(context, CL_MEM_READ_WRITE, slicePitch, nullptr, retVal));
+    std::unique_ptr<Buffer> dstBuffer(Buffer::create(context, CL_MEM_READ_WRITE, slicePitch, nullptr, retVal));
+    auto srcStorage = static_cast<uint8_t *>(srcBuffer->getCpuAddressForMemoryTransfer());
+    auto dstStorage = static_cast<uint8_t *>(dstBuffer->getCpuAddressForMemoryTransfer());
+    memset(srcStorage, 0x11, slicePitch);
+    memset(dstStorage, 0, slicePitch);
+
+    UserEvent userEvent(context);
+    cl_event blockedEvent = &userEvent;
+    retVal = pCmdQ->enqueueMarkerWithWaitList(1, &blockedEvent, nullptr);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    ASSERT_TRUE(pCmdQ->isQueueBlocked());
+    ASSERT_TRUE(pCmdQ->isCompleted(pCmdQ->taskCount));
+
+    auto taskCountBefore = pCmdQ->taskCount;
+    retVal = pCmdQ->enqueueCopyBufferRect(srcBuffer.get(), dstBuffer.get(), origin, origin, region,
+                                          rowPitch, slicePitch, rowPitch, slicePitch, 0, nullptr, nullptr);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(0u, dstStorage[0]);
+
+    userEvent.setStatus(CL_COMPLETE);
+    EXPECT_LT(taskCountBefore, pCmdQ->taskCount);
+}
+
+HWTEST_F(ReadWriteBufferCpuCopyTest, givenDeviceThatDoesntSupportCpuCopiesWhenReadBufferRectIsExecutedThenBuiltinIsDispatched) {
+    cl_int retVal;
+    size_t origin[] = {0, 0, 0};
+    size_t region[] = {16, 2, 1};
+
+    auto deviceInfo = context->getDevice(0)->getMutableDeviceInfo();
+    deviceInfo->cpuCopyAllowed = false;
+
+    std::unique_ptr<Buffer> buffer(Buffer::create(context, CL_MEM_READ_WRITE, MemoryConstants::pageSize, nullptr, retVal));
+    auto hostMemory = alignedMalloc(MemoryConstants::pageSize, MemoryConstants::pageSize);
+
+    auto taskCountBefore = pCmdQ->taskCount;
+    retVal = pCmdQ->enqueueReadBufferRect(buffer.get(), CL_TRUE, origin, origin, region, 16, 32, 16, 32, hostMemory, 0, nullptr, nullptr);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_LT(taskCountBefore, pCmdQ->taskCount);
+
+    alignedFree(hostMemory);
+}
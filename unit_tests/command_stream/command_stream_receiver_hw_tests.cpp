@@ -23,6 +23,7 @@
 #include "runtime/built_ins/built_ins.h"
 #include "runtime/command_queue/command_queue_hw.h"
 #include "runtime/command_stream/command_stream_receiver.h"
+#include "runtime/command_stream/command_stream_ring.h"
 #include "runtime/command_stream/linear_stream.h"
 #include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/event/user_event.h"
@@ -1667,6 +1668,78 @@ HWTEST_F(CommandStreamReceiverFlushTaskTests, handleTagAndScratchAllocationsResi
     EXPECT_TRUE(commandStreamReceiver->isMadeNonResident(scratchAllocation));
 }
 
+HWTEST_F(CommandStreamReceiverFlushTaskTests, givenScratchSpaceManagementWhenScratchRequirementAlternatesThenPooledAllocationsAreReused) {
+    auto &commandStreamReceiver = pDevice->getUltCommandStreamReceiver<FamilyType>();
+    commandStreamReceiver.overrideScratchSpaceManagement(true);
+    commandStreamReceiver.setScratchSpaceShrinkPeriod(1);
+
+    GraphicsAllocation *scratchAllocations[2] = {};
+    uint32_t scratchSizes[2] = {4096, 65536};
+    for (int i = 0; i < 6; i++) {
+        *commandStreamReceiver.getTagAddress() = commandStreamReceiver.peekTaskCount();
+        commandStreamReceiver.setRequiredScratchSize(scratchSizes[i % 2]);
+        flushTask(commandStreamReceiver);
+
+        EXPECT_EQ(scratchSizes[i % 2], commandStreamReceiver.peekRequiredScratchSize());
+        auto scratchAllocation = commandStreamReceiver.getScratchAllocation();
+        ASSERT_NE(nullptr, scratchAllocation);
+        if (i < 2) {
+            scratchAllocations[i] = scratchAllocation;
+        } else {
+            EXPECT_EQ(scratchAllocations[i % 2], scratchAllocation);
+        }
+    }
+    EXPECT_NE(scratchAllocations[0], scratchAllocations[1]);
+    EXPECT_EQ(2u, pDevice->getMemoryManager()->getScratchSpacePool()->peekCreatedCount());
+}
+
+HWTEST_F(CommandStreamReceiverFlushTaskTests, givenScratchSpaceManagementWhenTasksStopUsingScratchForShrinkPeriodThenScratchIsReleasedAndMediaVfeStateReprogrammedOnce) {
+    typedef typename FamilyType::MEDIA_VFE_STATE MEDIA_VFE_STATE;
+    configureCSRtoNonDirtyState<FamilyType>();
+    auto &commandStreamReceiver = pDevice->getUltCommandStreamReceiver<FamilyType>();
+    commandStreamReceiver.overrideScratchSpaceManagement(true);
+    commandStreamReceiver.setScratchSpaceShrinkPeriod(4);
+
+    commandStreamReceiver.setRequiredScratchSize(1024);
+    flushTask(commandStreamReceiver);
+    ASSERT_NE(nullptr, commandStreamReceiver.getScratchAllocation());
+
+    auto usedBefore = commandStreamReceiver.commandStream.getUsed();
+    for (int i = 0; i < 6; i++) {
+        flushTask(commandStreamReceiver);
+    }
+    EXPECT_NE(nullptr, commandStreamReceiver.getScratchAllocation());
+    EXPECT_EQ(1024u, commandStreamReceiver.peekRequiredScratchSize());
+    parseCommands<FamilyType>(commandStreamReceiver.commandStream, usedBefore);
+    EXPECT_EQ(cmdList.end(), find<MEDIA_VFE_STATE *>(cmdList.begin(), cmdList.end()));
+
+    usedBefore = commandStreamReceiver.commandStream.getUsed();
+    flushTask(commandStreamReceiver);
+    EXPECT_EQ(nullptr, commandStreamReceiver.getScratchAllocation());
+    EXPECT_EQ(0u, commandStreamReceiver.peekRequiredScratchSize());
+    EXPECT_EQ(1u, pDevice->getMemoryManager()->getScratchSpacePool()->peekPooledCount());
+
+    cmdList.clear();
+    parseCommands<FamilyType>(commandStreamReceiver.commandStream, usedBefore);
+    auto itorMediaVfeState = find<MEDIA_VFE_STATE *>(cmdList.begin(), cmdList.end());
+    ASSERT_NE(cmdList.end(), itorMediaVfeState);
+    EXPECT_EQ(cmdList.end(), find<MEDIA_VFE_STATE *>(++itorMediaVfeState, cmdList.end()));
+}
+
+HWTEST_F(CommandStreamReceiverFlushTaskTests, givenScratchSpaceManagementDisabledWhenTasksStopUsingScratchThenScratchIsKept) {
+    auto &commandStreamReceiver = pDevice->getUltCommandStreamReceiver<FamilyType>();
+    commandStreamReceiver.setScratchSpaceShrinkPeriod(1);
+
+    commandStreamReceiver.setRequiredScratchSize(1024);
+    flushTask(commandStreamReceiver);
+    auto scratchAllocation = commandStreamReceiver.getScratchAllocation();
+    flushTask(commandStreamReceiver);
+    flushTask(commandStreamReceiver);
+
+    EXPECT_EQ(scratchAllocation, commandStreamReceiver.getScratchAllocation());
+    EXPECT_EQ(nullptr, pDevice->getMemoryManager()->peekScratchSpacePool());
+}
+
 HWTEST_F(CommandStreamReceiverFlushTaskTests, givenTwoConsecutiveNDRangeKernelsStateBaseAddressIsProgrammedOnceAndScratchAddressInMediaVFEStateIsProgrammedTwiceBothWithCorrectAddress) {
     typedef typename FamilyType::PARSE PARSE;
     typedef typename PARSE::MEDIA_VFE_STATE MEDIA_VFE_STATE;
@@ -3425,3 +3498,476 @@ HWTEST_F(CommandStreamReceiverFlushTaskTests, givenDispatchFlagsWithThrottleSetT
 
     EXPECT_EQ(cmdBuffer->batchBuffer.throttle, QueueThrottle::HIGH);
 }
+
+HWTEST_F(CommandStreamReceiverFlushTaskTests, givenCsrInBatchingModeWithPipeControlEliminationWhenDependentTaskUsesDisjointAllocationsThenStallsBetweenThemAreNooped) {
+    typedef typename FamilyType::PIPE_CONTROL PIPE_CONTROL;
+    CommandQueueHw<FamilyType> commandQueue(nullptr, pDevice, 0);
+    auto &commandStream = commandQueue.getCS(4096u);
+
+    auto mockCsr = new MockCsrHw2<FamilyType>(*platformDevices[0]);
+    pDevice->resetCommandStreamReceiver(mockCsr);
+
+    mockCsr->overrideDispatchPolicy(CommandStreamReceiver::DispatchMode::BatchedDispatch);
+    mockCsr->overridePipeControlElimination(true);
+
+    auto mockedSubmissionsAggregator = new mockSubmissionsAggregator();
+    mockCsr->overrideSubmissionAggregator(mockedSubmissionsAggregator);
+
+    DispatchFlags dispatchFlags;
+    dispatchFlags.guardCommandBufferWithPipeControl = true;
+    dispatchFlags.outOfOrderExecutionAllowed = false;
+
+    auto taskLevelPriorToSubmission = mockCsr->peekTaskLevel();
+
+    GraphicsAllocation firstAllocation(nullptr, 4096);
+    GraphicsAllocation secondAllocation(nullptr, 4096);
+
+    mockCsr->makeResident(firstAllocation);
+    mockCsr->flushTask(commandStream, 0, dsh, ih, ioh, ssh, taskLevelPriorToSubmission, dispatchFlags);
+
+    mockCsr->makeResident(secondAllocation);
+    mockCsr->flushTask(commandStream, 0, dsh, ih, ioh, ssh, taskLevelPriorToSubmission + 1, dispatchFlags);
+
+    auto firstCmdBuffer = mockedSubmissionsAggregator->peekCommandBuffers().peekHead();
+    auto secondCmdBuffer = firstCmdBuffer->next;
+    ASSERT_EQ(1u, firstCmdBuffer->trackedAllocations.size());
+    EXPECT_EQ(&firstAllocation, firstCmdBuffer->trackedAllocations[0]);
+    ASSERT_EQ(1u, secondCmdBuffer->trackedAllocations.size());
+    EXPECT_EQ(&secondAllocation, secondCmdBuffer->trackedAllocations[0]);
+
+    auto firstEpilogue = firstCmdBuffer->epiloguePipeControlLocation;
+    auto secondEpilogue = secondCmdBuffer->epiloguePipeControlLocation;
+    auto dependencyPipeControl = secondCmdBuffer->dependencyPipeControlLocation;
+    ASSERT_NE(nullptr, firstEpilogue);
+    ASSERT_NE(nullptr, secondEpilogue);
+    ASSERT_NE(nullptr, dependencyPipeControl);
+    EXPECT_NE(nullptr, genCmdCast<PIPE_CONTROL *>(firstEpilogue));
+    EXPECT_NE(nullptr, genCmdCast<PIPE_CONTROL *>(dependencyPipeControl));
+
+    mockCsr->flushBatchedSubmissions();
+
+    EXPECT_EQ(nullptr, genCmdCast<PIPE_CONTROL *>(firstEpilogue));
+    EXPECT_EQ(nullptr, genCmdCast<PIPE_CONTROL *>(dependencyPipeControl));
+
+    //last tag write is preserved and preceded by DC flush of the kept epilogue
+    EXPECT_TRUE(genCmdCast<PIPE_CONTROL *>(secondEpilogue)->getDcFlushEnable());
+    parseCommands<FamilyType>(commandStream);
+    auto itorPipeControl = find<PIPE_CONTROL *>(cmdList.begin(), cmdList.end());
+    PIPE_CONTROL *lastTagWrite = nullptr;
+    while (itorPipeControl != cmdList.end()) {
+        auto pipeControl = genCmdCast<PIPE_CONTROL *>(*itorPipeControl);
+        if (pipeControl->getPostSyncOperation() == PIPE_CONTROL::POST_SYNC_OPERATION_WRITE_IMMEDIATE_DATA) {
+            lastTagWrite = pipeControl;
+        }
+        itorPipeControl = find<PIPE_CONTROL *>(++itorPipeControl, cmdList.end());
+    }
+    ASSERT_NE(nullptr, lastTagWrite);
+    EXPECT_EQ(mockCsr->peekLatestFlushedTaskCount(), lastTagWrite->getImmediateData());
+}
+
+HWTEST_F(CommandStreamReceiverFlushTaskTests, givenCsrInBatchingModeWithPipeControlEliminationWhenTaskFlushingDcIsFollowedByDisjointTaskThenItsEpilogueIsKept) {
+    typedef typename FamilyType::PIPE_CONTROL PIPE_CONTROL;
+    CommandQueueHw<FamilyType> commandQueue(nullptr, pDevice, 0);
+    auto &commandStream = commandQueue.getCS(4096u);
+
+    auto mockCsr = new MockCsrHw2<FamilyType>(*platformDevices[0]);
+    pDevice->resetCommandStreamReceiver(mockCsr);
+
+    mockCsr->overrideDispatchPolicy(CommandStreamReceiver::DispatchMode::BatchedDispatch);
+    mockCsr->overridePipeControlElimination(true);
+
+    auto mockedSubmissionsAggregator = new mockSubmissionsAggregator();
+    mockCsr->overrideSubmissionAggregator(mockedSubmissionsAggregator);
+
+    DispatchFlags dispatchFlags;
+    dispatchFlags.outOfOrderExecutionAllowed = false;
+
+    auto taskLevelPriorToSubmission = mockCsr->peekTaskLevel();
+
+    GraphicsAllocation firstAllocation(nullptr, 4096);
+    GraphicsAllocation secondAllocation(nullptr, 4096);
+
+    //non-blocking read, host reads the data once the tag of this task passes
+    dispatchFlags.dcFlush = true;
+    mockCsr->makeResident(firstAllocation);
+    mockCsr->flushTask(commandStream, 0, dsh, ih, ioh, ssh, taskLevelPriorToSubmission, dispatchFlags);
+
+    dispatchFlags.dcFlush = false;
+    dispatchFlags.guardCommandBufferWithPipeControl = true;
+    mockCsr->makeResident(secondAllocation);
+    mockCsr->flushTask(commandStream, 0, dsh, ih, ioh, ssh, taskLevelPriorToSubmission + 1, dispatchFlags);
+
+    auto firstCmdBuffer = mockedSubmissionsAggregator->peekCommandBuffers().peekHead();
+    auto secondCmdBuffer = firstCmdBuffer->next;
+    EXPECT_TRUE(firstCmdBuffer->epilogueDcFlush);
+    EXPECT_FALSE(secondCmdBuffer->epilogueDcFlush);
+    auto firstEpilogue = firstCmdBuffer->epiloguePipeControlLocation;
+    auto secondEpilogue = secondCmdBuffer->epiloguePipeControlLocation;
+    auto dependencyPipeControl = secondCmdBuffer->dependencyPipeControlLocation;
+    ASSERT_NE(nullptr, firstEpilogue);
+    ASSERT_NE(nullptr, secondEpilogue);
+    ASSERT_NE(nullptr, dependencyPipeControl);
+
+    mockCsr->flushBatchedSubmissions();
+
+    //only the stall is nooped, DC flush of the first task precedes its tag write
+    EXPECT_EQ(nullptr, genCmdCast<PIPE_CONTROL *>(dependencyPipeControl));
+    auto firstEpiloguePipeControl = genCmdCast<PIPE_CONTROL *>(firstEpilogue);
+    ASSERT_NE(nullptr, firstEpiloguePipeControl);
+    EXPECT_TRUE(firstEpiloguePipeControl->getDcFlushEnable());
+    EXPECT_TRUE(genCmdCast<PIPE_CONTROL *>(secondEpilogue)->getDcFlushEnable());
+
+    parseCommands<FamilyType>(commandStream);
+    auto itorPipeControl = find<PIPE_CONTROL *>(cmdList.begin(), cmdList.end());
+    uint32_t tagWrites = 0;
+    while (itorPipeControl != cmdList.end()) {
+        auto pipeControl = genCmdCast<PIPE_CONTROL *>(*itorPipeControl);
+        if (pipeControl->getPostSyncOperation() == PIPE_CONTROL::POST_SYNC_OPERATION_WRITE_IMMEDIATE_DATA) {
+            tagWrites++;
+        }
+        itorPipeControl = find<PIPE_CONTROL *>(++itorPipeControl, cmdList.end());
+    }
+    EXPECT_EQ(2u, tagWrites);
+}
+
+HWTEST_F(CommandStreamReceiverFlushTaskTests, givenCsrInBatchingModeWithPipeControlEliminationWhenDependentTaskSharesAllocationThenStallsAreKept) {
+    typedef typename FamilyType::PIPE_CONTROL PIPE_CONTROL;
+    CommandQueueHw<FamilyType> commandQueue(nullptr, pDevice, 0);
+    auto &commandStream = commandQueue.getCS(4096u);
+
+    auto mockCsr = new MockCsrHw2<FamilyType>(*platformDevices[0]);
+    pDevice->resetCommandStreamReceiver(mockCsr);
+
+    mockCsr->overrideDispatchPolicy(CommandStreamReceiver::DispatchMode::BatchedDispatch);
+    mockCsr->overridePipeControlElimination(true);
+
+    auto mockedSubmissionsAggregator = new mockSubmissionsAggregator();
+    mockCsr->overrideSubmissionAggregator(mockedSubmissionsAggregator);
+
+    DispatchFlags dispatchFlags;
+    dispatchFlags.guardCommandBufferWithPipeControl = true;
+    dispatchFlags.outOfOrderExecutionAllowed = false;
+
+    auto taskLevelPriorToSubmission = mockCsr->peekTaskLevel();
+
+    GraphicsAllocation sharedAllocation(nullptr, 4096);
+
+    mockCsr->makeResident(sharedAllocation);
+    mockCsr->flushTask(commandStream, 0, dsh, ih, ioh, ssh, taskLevelPriorToSubmission, dispatchFlags);
+
+    mockCsr->makeResident(sharedAllocation);
+    mockCsr->flushTask(commandStream, 0, dsh, ih, ioh, ssh, taskLevelPriorToSubmission + 1, dispatchFlags);
+
+    auto firstCmdBuffer = mockedSubmissionsAggregator->peekCommandBuffers().peekHead();
+    auto secondCmdBuffer = firstCmdBuffer->next;
+    auto firstEpilogue = firstCmdBuffer->epiloguePipeControlLocation;
+    auto dependencyPipeControl = secondCmdBuffer->dependencyPipeControlLocation;
+    ASSERT_NE(nullptr, dependencyPipeControl);
+
+    mockCsr->flushBatchedSubmissions();
+
+    EXPECT_NE(nullptr, genCmdCast<PIPE_CONTROL *>(firstEpilogue));
+    EXPECT_NE(nullptr, genCmdCast<PIPE_CONTROL *>(dependencyPipeControl));
+}
+
+HWTEST_F(CommandStreamReceiverFlushTaskTests, givenCsrInBatchingModeWithoutPipeControlEliminationWhenTaskIsRecordedThenDependencyInformationIsNotTracked) {
+    CommandQueueHw<FamilyType> commandQueue(nullptr, pDevice, 0);
+    auto &commandStream = commandQueue.getCS(4096u);
+
+    auto mockCsr = new MockCsrHw2<FamilyType>(*platformDevices[0]);
+    pDevice->resetCommandStreamReceiver(mockCsr);
+
+    mockCsr->overrideDispatchPolicy(CommandStreamReceiver::DispatchMode::BatchedDispatch);
+    mockCsr->overridePipeControlElimination(false);
+
+    auto mockedSubmissionsAggregator = new mockSubmissionsAggregator();
+    mockCsr->overrideSubmissionAggregator(mockedSubmissionsAggregator);
+
+    DispatchFlags dispatchFlags;
+    dispatchFlags.guardCommandBufferWithPipeControl = true;
+
+    GraphicsAllocation allocation(nullptr, 4096);
+    mockCsr->makeResident(allocation);
+    mockCsr->flushTask(commandStream, 0, dsh, ih, ioh, ssh, mockCsr->peekTaskLevel() + 1, dispatchFlags);
+
+    auto cmdBuffer = mockedSubmissionsAggregator->peekCommandBuffers().peekHead();
+    EXPECT_EQ(nullptr, cmdBuffer->dependencyPipeControlLocation);
+    EXPECT_TRUE(cmdBuffer->trackedAllocations.empty());
+}
+
+template <typename FamilyType>
+bool isPipeControlEmitted(LinearStream &commandStream, size_t startOffset) {
+    HardwareParse hwParser;
+    hwParser.parseCommands<FamilyType>(commandStream, startOffset);
+    return hwParser.cmdList.end() != find<typename FamilyType::PIPE_CONTROL *>(hwParser.cmdList.begin(), hwParser.cmdList.end());
+}
+
+HWTEST_F(CommandStreamReceiverFlushTaskTests, givenResourceDependencyTrackingWhenDependentTaskUsesDisjointAllocationThenPipeControlIsNotEmitted) {
+    auto mockCsr = new MockCsrHw2<FamilyType>(*platformDevices[0]);
+    pDevice->resetCommandStreamReceiver(mockCsr);
+    mockCsr->overrideResourceDependencyTracking(true);
+
+    CommandQueueHw<FamilyType> commandQueue(nullptr, pDevice, 0);
+    auto &commandStream = commandQueue.getCS(4096u);
+    DispatchFlags dispatchFlags;
+
+    GraphicsAllocation firstAllocation(nullptr, 4096);
+    GraphicsAllocation secondAllocation(nullptr, 4096);
+
+    mockCsr->makeResident(firstAllocation);
+    mockCsr->flushTask(commandStream, 0, dsh, ih, ioh, ssh, taskLevel, dispatchFlags);
+    EXPECT_EQ(1u, firstAllocation.peekLastWriteTaskCount());
+
+    auto csrOffset = mockCsr->commandStream.getUsed();
+    mockCsr->makeResident(secondAllocation);
+    mockCsr->flushTask(commandStream, commandStream.getUsed(), dsh, ih, ioh, ssh, taskLevel + 1, dispatchFlags);
+
+    EXPECT_FALSE(isPipeControlEmitted<FamilyType>(mockCsr->commandStream, csrOffset));
+    EXPECT_EQ(0u, mockCsr->peekLastStalledTaskCount());
+    EXPECT_EQ(taskLevel + 1, mockCsr->peekTaskLevel());
+}
+
+HWTEST_F(CommandStreamReceiverFlushTaskTests, givenResourceDependencyTrackingWhenTaskReadsAllocationWrittenByPreviousTaskThenPipeControlIsEmitted) {
+    auto mockCsr = new MockCsrHw2<FamilyType>(*platformDevices[0]);
+    pDevice->resetCommandStreamReceiver(mockCsr);
+    mockCsr->overrideResourceDependencyTracking(true);
+
+    CommandQueueHw<FamilyType> commandQueue(nullptr, pDevice, 0);
+    auto &commandStream = commandQueue.getCS(4096u);
+    DispatchFlags dispatchFlags;
+
+    GraphicsAllocation allocation(nullptr, 4096);
+
+    mockCsr->makeResident(allocation);
+    mockCsr->flushTask(commandStream, 0, dsh, ih, ioh, ssh, taskLevel, dispatchFlags);
+
+    std::vector<GraphicsAllocation *> readOnlyAllocations = {&allocation};
+    dispatchFlags.readOnlyAllocations = &readOnlyAllocations;
+    auto csrOffset = mockCsr->commandStream.getUsed();
+    mockCsr->makeResident(allocation);
+    mockCsr->flushTask(commandStream, commandStream.getUsed(), dsh, ih, ioh, ssh, taskLevel + 1, dispatchFlags);
+
+    EXPECT_TRUE(isPipeControlEmitted<FamilyType>(mockCsr->commandStream, csrOffset));
+    EXPECT_EQ(1u, mockCsr->peekLastStalledTaskCount());
+    EXPECT_EQ(1u, allocation.peekLastWriteTaskCount());
+    EXPECT_EQ(2u, allocation.peekLastReadTaskCount());
+}
+
+HWTEST_F(CommandStreamReceiverFlushTaskTests, givenResourceDependencyTrackingWhenBothTasksOnlyReadAllocationThenPipeControlIsNotEmitted) {
+    auto mockCsr = new MockCsrHw2<FamilyType>(*platformDevices[0]);
+    pDevice->resetCommandStreamReceiver(mockCsr);
+    mockCsr->overrideResourceDependencyTracking(true);
+
+    CommandQueueHw<FamilyType> commandQueue(nullptr, pDevice, 0);
+    auto &commandStream = commandQueue.getCS(4096u);
+    DispatchFlags dispatchFlags;
+
+    GraphicsAllocation allocation(nullptr, 4096);
+    std::vector<GraphicsAllocation *> readOnlyAllocations = {&allocation};
+    dispatchFlags.readOnlyAllocations = &readOnlyAllocations;
+
+    mockCsr->makeResident(allocation);
+    mockCsr->flushTask(commandStream, 0, dsh, ih, ioh, ssh, taskLevel, dispatchFlags);
+
+    auto csrOffset = mockCsr->commandStream.getUsed();
+    mockCsr->makeResident(allocation);
+    mockCsr->flushTask(commandStream, commandStream.getUsed(), dsh, ih, ioh, ssh, taskLevel + 1, dispatchFlags);
+
+    EXPECT_FALSE(isPipeControlEmitted<FamilyType>(mockCsr->commandStream, csrOffset));
+    EXPECT_EQ(0u, allocation.peekLastWriteTaskCount());
+    EXPECT_EQ(2u, allocation.peekLastReadTaskCount());
+}
+
+HWTEST_F(CommandStreamReceiverFlushTaskTests, givenResourceDependencyTrackingWhenTaskWritesAllocationReadByPreviousTaskThenPipeControlIsEmitted) {
+    auto mockCsr = new MockCsrHw2<FamilyType>(*platformDevices[0]);
+    pDevice->resetCommandStreamReceiver(mockCsr);
+    mockCsr->overrideResourceDependencyTracking(true);
+
+    CommandQueueHw<FamilyType> commandQueue(nullptr, pDevice, 0);
+    auto &commandStream = commandQueue.getCS(4096u);
+    DispatchFlags dispatchFlags;
+
+    GraphicsAllocation allocation(nullptr, 4096);
+    std::vector<GraphicsAllocation *> readOnlyAllocations = {&allocation};
+    dispatchFlags.readOnlyAllocations = &readOnlyAllocations;
+
+    mockCsr->makeResident(allocation);
+    mockCsr->flushTask(commandStream, 0, dsh, ih, ioh, ssh, taskLevel, dispatchFlags);
+
+    dispatchFlags.readOnlyAllocations = nullptr;
+    auto csrOffset = mockCsr->commandStream.getUsed();
+    mockCsr->makeResident(allocation);
+    mockCsr->flushTask(commandStream, commandStream.getUsed(), dsh, ih, ioh, ssh, taskLevel + 1, dispatchFlags);
+
+    EXPECT_TRUE(isPipeControlEmitted<FamilyType>(mockCsr->commandStream, csrOffset));
+}
+
+HWTEST_F(CommandStreamReceiverFlushTaskTests, givenResourceDependencyTrackingWhenPreviousTaskEndsWithStallingEpilogueThenPipeControlIsNotEmitted) {
+    auto mockCsr = new MockCsrHw2<FamilyType>(*platformDevices[0]);
+    pDevice->resetCommandStreamReceiver(mockCsr);
+    mockCsr->overrideResourceDependencyTracking(true);
+
+    CommandQueueHw<FamilyType> commandQueue(nullptr, pDevice, 0);
+    auto &commandStream = commandQueue.getCS(4096u);
+    DispatchFlags dispatchFlags;
+    dispatchFlags.guardCommandBufferWithPipeControl = true;
+
+    GraphicsAllocation allocation(nullptr, 4096);
+
+    mockCsr->makeResident(allocation);
+    mockCsr->flushTask(commandStream, 0, dsh, ih, ioh, ssh, taskLevel, dispatchFlags);
+    EXPECT_EQ(1u, mockCsr->peekLastStalledTaskCount());
+
+    auto csrOffset = mockCsr->commandStream.getUsed();
+    mockCsr->makeResident(allocation);
+    mockCsr->flushTask(commandStream, commandStream.getUsed(), dsh, ih, ioh, ssh, taskLevel + 2, dispatchFlags);
+
+    EXPECT_FALSE(isPipeControlEmitted<FamilyType>(mockCsr->commandStream, csrOffset));
+}
+
+HWTEST_F(CommandStreamReceiverFlushTaskTests, givenResourceDependencyTrackingDisabledWhenTaskLevelIsIncreasedThenPipeControlIsEmittedRegardlessOfAllocations) {
+    auto mockCsr = new MockCsrHw2<FamilyType>(*platformDevices[0]);
+    pDevice->resetCommandStreamReceiver(mockCsr);
+    mockCsr->overrideResourceDependencyTracking(false);
+
+    CommandQueueHw<FamilyType> commandQueue(nullptr, pDevice, 0);
+    auto &commandStream = commandQueue.getCS(4096u);
+    DispatchFlags dispatchFlags;
+
+    mockCsr->flushTask(commandStream, 0, dsh, ih, ioh, ssh, taskLevel, dispatchFlags);
+
+    auto csrOffset = mockCsr->commandStream.getUsed();
+    mockCsr->flushTask(commandStream, commandStream.getUsed(), dsh, ih, ioh, ssh, taskLevel + 1, dispatchFlags);
+
+    EXPECT_TRUE(isPipeControlEmitted<FamilyType>(mockCsr->commandStream, csrOffset));
+}
+
+HWTEST_F(CommandStreamReceiverFlushTaskTests, givenCommandStreamRingWhenCsrCommandStreamIsFullThenStreamMovesToNextSegmentWithoutWritingToPreviousOne) {
+    auto &commandStreamReceiver = pDevice->getUltCommandStreamReceiver<FamilyType>();
+    commandStreamReceiver.overrideCommandStreamRing(true);
+
+    auto &csrStream = commandStreamReceiver.getCS();
+    auto firstSegment = csrStream.getGraphicsAllocation();
+    ASSERT_NE(nullptr, firstSegment);
+    EXPECT_EQ(CommandStreamRing::defaultSegmentSize + CSRequirements::csOverfetchSize, firstSegment->getUnderlyingBufferSize());
+
+    memset(firstSegment->getUnderlyingBuffer(), 0, firstSegment->getUnderlyingBufferSize());
+    csrStream.getSpace(csrStream.getAvailableSpace());
+    auto usedInFirstSegment = csrStream.getUsed();
+
+    commandStreamReceiver.getCS();
+    auto secondSegment = csrStream.getGraphicsAllocation();
+    ASSERT_NE(nullptr, secondSegment);
+    EXPECT_NE(firstSegment, secondSegment);
+    EXPECT_EQ(0u, csrStream.getUsed());
+    EXPECT_EQ(2u, commandStreamReceiver.peekCommandStreamRing()->getSegmentCount());
+
+    //tasks never span segments, nothing is appended past the batch buffer end of the last task
+    auto tailSize = firstSegment->getUnderlyingBufferSize() - usedInFirstSegment;
+    std::vector<uint8_t> zeros(tailSize, 0);
+    EXPECT_EQ(0, memcmp(zeros.data(), ptrOffset(firstSegment->getUnderlyingBuffer(), usedInFirstSegment), tailSize));
+}
+
+HWTEST_F(CommandStreamReceiverFlushTaskTests, givenCommandStreamRingWhenOldestSegmentIsCompletedThenQueueCommandStreamReusesItInRingOrder) {
+    auto &commandStreamReceiver = pDevice->getUltCommandStreamReceiver<FamilyType>();
+    commandStreamReceiver.overrideCommandStreamRing(true);
+
+    CommandQueueHw<FamilyType> commandQueue(nullptr, pDevice, 0);
+    auto &queueStream = commandQueue.getCS(1024u);
+    auto firstSegment = queueStream.getGraphicsAllocation();
+
+    commandStreamReceiver.taskCount = 1;
+    queueStream.getSpace(queueStream.getAvailableSpace());
+    commandQueue.getCS(1024u);
+    auto secondSegment = queueStream.getGraphicsAllocation();
+    EXPECT_NE(firstSegment, secondSegment);
+    EXPECT_EQ(1u, firstSegment->taskCount);
+
+    commandStreamReceiver.taskCount = 2;
+    *commandStreamReceiver.getTagAddress() = 1;
+    queueStream.getSpace(queueStream.getAvailableSpace());
+    commandQueue.getCS(1024u);
+    EXPECT_EQ(firstSegment, queueStream.getGraphicsAllocation());
+}
+
+HWTEST_F(CommandStreamReceiverFlushTaskTests, givenCommandStreamRingWhenOldestSegmentIsStillInUseThenNewSegmentIsAddedToRing) {
+    auto &commandStreamReceiver = pDevice->getUltCommandStreamReceiver<FamilyType>();
+    commandStreamReceiver.overrideCommandStreamRing(true);
+
+    auto &csrStream = commandStreamReceiver.getCS();
+    auto firstSegment = csrStream.getGraphicsAllocation();
+
+    commandStreamReceiver.taskCount = 1;
+    csrStream.getSpace(csrStream.getAvailableSpace());
+    commandStreamReceiver.getCS();
+    auto secondSegment = csrStream.getGraphicsAllocation();
+
+    commandStreamReceiver.taskCount = 2;
+    *commandStreamReceiver.getTagAddress() = 0;
+    csrStream.getSpace(csrStream.getAvailableSpace());
+    commandStreamReceiver.getCS();
+    auto thirdSegment = csrStream.getGraphicsAllocation();
+
+    EXPECT_NE(firstSegment, thirdSegment);
+    EXPECT_NE(secondSegment, thirdSegment);
+    EXPECT_EQ(3u, commandStreamReceiver.peekCommandStreamRing()->getSegmentCount());
+}
+
+HWTEST_F(CommandStreamReceiverFlushTaskTests, givenSharedIndirectHeapsWhenHeapRangeIsObtainedThenItIsPageAlignedSubrangeOfSharedHeap) {
+    auto &commandStreamReceiver = pDevice->getUltCommandStreamReceiver<FamilyType>();
+    commandStreamReceiver.overrideSharedIndirectHeaps(true);
+
+    auto &sharedHeap = commandStreamReceiver.getIndirectHeap(IndirectHeap::DYNAMIC_STATE, 0);
+    sharedHeap.getSpace(100);
+    auto sharedHeapAllocation = sharedHeap.getGraphicsAllocation();
+
+    auto range = commandStreamReceiver.obtainIndirectHeapRange(IndirectHeap::DYNAMIC_STATE, 100);
+    EXPECT_EQ(ptrOffset(sharedHeap.getCpuBase(), MemoryConstants::pageSize), range->getCpuBase());
+    EXPECT_EQ(0u, range->getUsed());
+    EXPECT_EQ(MemoryConstants::pageSize, range->getMaxAvailableSpace());
+    EXPECT_EQ(sharedHeapAllocation, range->getGraphicsAllocation());
+    EXPECT_EQ(sharedHeapAllocation, sharedHeap.getGraphicsAllocation());
+    EXPECT_EQ(2 * MemoryConstants::pageSize, sharedHeap.getUsed());
+}
+
+HWTEST_F(CommandStreamReceiverFlushTaskTests, givenSharedIndirectHeapsWhenInstructionHeapRangeIsObtainedThenItStartsWithReservedBlock) {
+    auto &commandStreamReceiver = pDevice->getUltCommandStreamReceiver<FamilyType>();
+    commandStreamReceiver.overrideSharedIndirectHeaps(true);
+
+    auto range = commandStreamReceiver.obtainIndirectHeapRange(IndirectHeap::INSTRUCTION, 100);
+    auto reservedSize = alignUp(commandStreamReceiver.getInstructionHeapCmdStreamReceiverReservedSize(), MemoryConstants::cacheLineSize);
+    EXPECT_EQ(reservedSize, range->getUsed());
+    EXPECT_GE(range->getAvailableSpace(), 100u);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(range->getCpuBase()) % MemoryConstants::pageSize);
+}
+
+HWTEST_F(CommandStreamReceiverFlushTaskTests, givenSharedIndirectHeapsWhenTasksFromDifferentQueuesAreFlushedThenStateBaseAddressIsNotReprogrammed) {
+    typedef typename FamilyType::STATE_BASE_ADDRESS STATE_BASE_ADDRESS;
+    auto &commandStreamReceiver = pDevice->getUltCommandStreamReceiver<FamilyType>();
+    commandStreamReceiver.overrideSharedIndirectHeaps(true);
+
+    CommandQueueHw<FamilyType> commandQueue1(nullptr, pDevice, 0);
+    CommandQueueHw<FamilyType> commandQueue2(nullptr, pDevice, 0);
+    DispatchFlags dispatchFlags;
+
+    auto flushQueueTask = [&](CommandQueue &commandQueue) {
+        auto &queueStream = commandQueue.getCS(1024u);
+        commandStreamReceiver.flushTask(queueStream, queueStream.getUsed(),
+                                        commandQueue.getIndirectHeap(IndirectHeap::DYNAMIC_STATE, 0u),
+                                        commandQueue.getIndirectHeap(IndirectHeap::INSTRUCTION, 0u),
+                                        commandQueue.getIndirectHeap(IndirectHeap::INDIRECT_OBJECT, 0u),
+                                        commandQueue.getIndirectHeap(IndirectHeap::SURFACE_STATE, 0u),
+                                        commandStreamReceiver.peekTaskLevel(), dispatchFlags);
+    };
+
+    flushQueueTask(commandQueue1);
+    parseCommands<FamilyType>(commandStreamReceiver.commandStream, 0);
+    EXPECT_NE(cmdList.end(), find<STATE_BASE_ADDRESS *>(cmdList.begin(), cmdList.end()));
+
+    auto csrOffset = commandStreamReceiver.commandStream.getUsed();
+    flushQueueTask(commandQueue2);
+
+    cmdList.clear();
+    parseCommands<FamilyType>(commandStreamReceiver.commandStream, csrOffset);
+    EXPECT_EQ(cmdList.end(), find<STATE_BASE_ADDRESS *>(cmdList.begin(), cmdList.end()));
+}
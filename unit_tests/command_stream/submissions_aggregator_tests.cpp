@@ -470,6 +470,123 @@ TEST(SubmissionsAggregator, givenCommandBuffersRequiringDifferentPrioritySetting
     EXPECT_EQ(1u, cmdBuffer->inspectionId);
 }
 
+TEST(SubmissionsAggregator, givenAggregatedCommandBuffersWithDisjointAllocationsWhenDependenciesAreAnalyzedThenStallsAreNotRequired) {
+    MockSubmissionAggregator submissionsAggregator;
+    CommandBuffer *cmdBuffer = new CommandBuffer;
+    CommandBuffer *cmdBuffer2 = new CommandBuffer;
+    CommandBuffer *cmdBuffer3 = new CommandBuffer;
+    uint32_t dependencyPipeControl = 0;
+
+    GraphicsAllocation alloc1(nullptr, 1);
+    GraphicsAllocation alloc2(nullptr, 2);
+    GraphicsAllocation alloc3(nullptr, 3);
+
+    cmdBuffer->trackedAllocations.push_back(&alloc1);
+    cmdBuffer2->trackedAllocations.push_back(&alloc2);
+    cmdBuffer2->dependencyPipeControlLocation = &dependencyPipeControl;
+    cmdBuffer3->trackedAllocations.push_back(&alloc3);
+    cmdBuffer3->dependencyPipeControlLocation = &dependencyPipeControl;
+
+    submissionsAggregator.recordCommandBuffer(cmdBuffer);
+    submissionsAggregator.recordCommandBuffer(cmdBuffer2);
+    submissionsAggregator.recordCommandBuffer(cmdBuffer3);
+
+    size_t totalUsedSize = 0;
+    size_t totalMemoryBudget = -1;
+    ResourcePackage resourcePackage;
+    submissionsAggregator.aggregateCommandBuffers(resourcePackage, totalUsedSize, totalMemoryBudget);
+    submissionsAggregator.analyzeDependencies(*cmdBuffer);
+
+    EXPECT_FALSE(cmdBuffer2->stallRequired);
+    EXPECT_FALSE(cmdBuffer3->stallRequired);
+}
+
+TEST(SubmissionsAggregator, givenCommandBufferSharingAllocationWithEarlierUnstalledBufferWhenDependenciesAreAnalyzedThenStallIsRequired) {
+    MockSubmissionAggregator submissionsAggregator;
+    CommandBuffer *cmdBuffer = new CommandBuffer;
+    CommandBuffer *cmdBuffer2 = new CommandBuffer;
+    CommandBuffer *cmdBuffer3 = new CommandBuffer;
+    uint32_t dependencyPipeControl = 0;
+
+    GraphicsAllocation alloc1(nullptr, 1);
+    GraphicsAllocation alloc2(nullptr, 2);
+
+    cmdBuffer->trackedAllocations.push_back(&alloc1);
+    cmdBuffer2->trackedAllocations.push_back(&alloc2);
+    cmdBuffer2->dependencyPipeControlLocation = &dependencyPipeControl;
+    //stall before second buffer is removed, so the first one may still run
+    cmdBuffer3->trackedAllocations.push_back(&alloc1);
+    cmdBuffer3->dependencyPipeControlLocation = &dependencyPipeControl;
+
+    submissionsAggregator.recordCommandBuffer(cmdBuffer);
+    submissionsAggregator.recordCommandBuffer(cmdBuffer2);
+    submissionsAggregator.recordCommandBuffer(cmdBuffer3);
+
+    size_t totalUsedSize = 0;
+    size_t totalMemoryBudget = -1;
+    ResourcePackage resourcePackage;
+    submissionsAggregator.aggregateCommandBuffers(resourcePackage, totalUsedSize, totalMemoryBudget);
+    submissionsAggregator.analyzeDependencies(*cmdBuffer);
+
+    EXPECT_FALSE(cmdBuffer2->stallRequired);
+    EXPECT_TRUE(cmdBuffer3->stallRequired);
+}
+
+TEST(SubmissionsAggregator, givenRequiredStallWhenDependenciesAreAnalyzedThenAllocationsBeforeStallAreNoLongerInFlight) {
+    MockSubmissionAggregator submissionsAggregator;
+    CommandBuffer *cmdBuffer = new CommandBuffer;
+    CommandBuffer *cmdBuffer2 = new CommandBuffer;
+    CommandBuffer *cmdBuffer3 = new CommandBuffer;
+    uint32_t dependencyPipeControl = 0;
+
+    GraphicsAllocation alloc1(nullptr, 1);
+    GraphicsAllocation alloc2(nullptr, 2);
+    GraphicsAllocation alloc3(nullptr, 3);
+
+    cmdBuffer->trackedAllocations.push_back(&alloc1);
+    cmdBuffer->trackedAllocations.push_back(&alloc3);
+    cmdBuffer2->trackedAllocations.push_back(&alloc1);
+    cmdBuffer2->dependencyPipeControlLocation = &dependencyPipeControl;
+    cmdBuffer3->trackedAllocations.push_back(&alloc3);
+    cmdBuffer3->trackedAllocations.push_back(&alloc2);
+    cmdBuffer3->dependencyPipeControlLocation = &dependencyPipeControl;
+
+    submissionsAggregator.recordCommandBuffer(cmdBuffer);
+    submissionsAggregator.recordCommandBuffer(cmdBuffer2);
+    submissionsAggregator.recordCommandBuffer(cmdBuffer3);
+
+    size_t totalUsedSize = 0;
+    size_t totalMemoryBudget = -1;
+    ResourcePackage resourcePackage;
+    submissionsAggregator.aggregateCommandBuffers(resourcePackage, totalUsedSize, totalMemoryBudget);
+    submissionsAggregator.analyzeDependencies(*cmdBuffer);
+
+    EXPECT_TRUE(cmdBuffer2->stallRequired);
+    EXPECT_FALSE(cmdBuffer3->stallRequired);
+}
+
+TEST(SubmissionsAggregator, givenCommandBuffersNotSeparatedByStallWhenDependenciesAreAnalyzedThenStallIsNotRequired) {
+    MockSubmissionAggregator submissionsAggregator;
+    CommandBuffer *cmdBuffer = new CommandBuffer;
+    CommandBuffer *cmdBuffer2 = new CommandBuffer;
+
+    GraphicsAllocation alloc1(nullptr, 1);
+
+    cmdBuffer->trackedAllocations.push_back(&alloc1);
+    cmdBuffer2->trackedAllocations.push_back(&alloc1);
+
+    submissionsAggregator.recordCommandBuffer(cmdBuffer);
+    submissionsAggregator.recordCommandBuffer(cmdBuffer2);
+
+    size_t totalUsedSize = 0;
+    size_t totalMemoryBudget = -1;
+    ResourcePackage resourcePackage;
+    submissionsAggregator.aggregateCommandBuffers(resourcePackage, totalUsedSize, totalMemoryBudget);
+    submissionsAggregator.analyzeDependencies(*cmdBuffer);
+
+    EXPECT_FALSE(cmdBuffer2->stallRequired);
+}
+
 TEST(SubmissionsAggregator, dontAllocateFlushStamp) {
     CommandBuffer cmdBuffer;
     EXPECT_EQ(nullptr, cmdBuffer.flushStamp->getStampReference());
@@ -533,6 +533,53 @@ TEST_F(InternalsEventTest, processBlockedCommandsKernelOperation) {
     EXPECT_EQ(surface->completionStamp, 1u);
 }
 
+TEST_F(InternalsEventTest, givenSharedIndirectHeapsWhenBlockedKernelIsSubmittedThenItsHeapsAreCopiedToPageAlignedRangesOfSharedHeapsWithoutReleasingThem) {
+    auto &csr = pDevice->getCommandStreamReceiver();
+    csr.overrideSharedIndirectHeaps(true);
+    CommandQueue *pCmdQ = new CommandQueue(mockContext, pDevice, 0);
+
+    auto &sharedDsh = pCmdQ->getIndirectHeap(IndirectHeap::DYNAMIC_STATE, 4096);
+    auto &sharedIoh = pCmdQ->getIndirectHeap(IndirectHeap::INDIRECT_OBJECT, 4096);
+    sharedDsh.getSpace(100);
+    sharedIoh.getSpace(100);
+    auto sharedDshAllocation = sharedDsh.getGraphicsAllocation();
+    auto sharedIohAllocation = sharedIoh.getGraphicsAllocation();
+    auto dshRangeOffset = alignUp(sharedDsh.getUsed(), MemoryConstants::pageSize);
+    auto iohRangeOffset = alignUp(sharedIoh.getUsed(), MemoryConstants::pageSize);
+
+    const size_t blockedDataSize = 64;
+    auto cmdStream = new LinearStream(alignedMalloc(4096, 4096), 4096);
+    auto dsh = new IndirectHeap(alignedMalloc(4096, 4096), 4096);
+    auto ish = new IndirectHeap(alignedMalloc(4096, 4096), 4096);
+    auto ioh = new IndirectHeap(alignedMalloc(4096, 4096), 4096);
+    auto ssh = new IndirectHeap(alignedMalloc(4096, 4096), 4096);
+    memset(dsh->getSpace(blockedDataSize), 0xAB, blockedDataSize);
+    memset(ioh->getSpace(blockedDataSize), 0xCD, blockedDataSize);
+    using UniqueIH = std::unique_ptr<IndirectHeap>;
+    auto blockedCommandsData = new KernelOperation(std::unique_ptr<LinearStream>(cmdStream), UniqueIH(dsh),
+                                                   UniqueIH(ish), UniqueIH(ioh), UniqueIH(ssh));
+
+    std::vector<Surface *> v;
+    PreemptionMode preemptionMode = pDevice->getPreemptionMode();
+    auto cmd = new CommandComputeKernel(*pCmdQ, csr, std::unique_ptr<KernelOperation>(blockedCommandsData), v, false, false, false, nullptr, preemptionMode);
+    cmd->submit(0, false);
+
+    EXPECT_EQ(sharedDshAllocation, sharedDsh.getGraphicsAllocation());
+    EXPECT_EQ(sharedIohAllocation, sharedIoh.getGraphicsAllocation());
+    EXPECT_LT(dshRangeOffset, sharedDsh.getUsed());
+    EXPECT_LT(iohRangeOffset, sharedIoh.getUsed());
+
+    uint8_t expectedDsh[blockedDataSize];
+    uint8_t expectedIoh[blockedDataSize];
+    memset(expectedDsh, 0xAB, blockedDataSize);
+    memset(expectedIoh, 0xCD, blockedDataSize);
+    EXPECT_EQ(0, memcmp(expectedDsh, ptrOffset(sharedDsh.getCpuBase(), dshRangeOffset), blockedDataSize));
+    EXPECT_EQ(0, memcmp(expectedIoh, ptrOffset(sharedIoh.getCpuBase(), iohRangeOffset), blockedDataSize));
+
+    delete cmd;
+    delete pCmdQ;
+}
+
 TEST_F(InternalsEventTest, processBlockedCommandsAbortKernelOperation) {
     MockEvent<Event> event(nullptr, CL_COMMAND_NDRANGE_KERNEL, 0, 0);
     CommandQueue *pCmdQ = new CommandQueue(mockContext, pDevice, 0);
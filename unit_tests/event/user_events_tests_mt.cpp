@@ -24,8 +24,11 @@
 #include "unit_tests/fixtures/buffer_fixture.h"
 #include "unit_tests/fixtures/hello_world_fixture.h"
 #include "runtime/memory_manager/memory_manager.h"
+#include "unit_tests/mocks/mock_event.h"
 
+#include <chrono>
 #include <memory>
+#include <thread>
 
 typedef HelloWorldTest<HelloWorldFixtureFactory> EventTests;
 
@@ -123,3 +126,80 @@ TEST_F(EventTests, givenUserEventBlockingEnqueueWithBlockingFlagWhenUserEventIsC
     EXPECT_EQ(CL_SUCCESS, retVal);
     t.join();
 }
+
+TEST_F(EventTests, givenUserEventWhenWaitingBlockingThenWaiterSleepsUntilStatusIsSetFromOtherThread) {
+    MockEvent<UserEvent> uEvent;
+    std::atomic<bool> waitCompleted(false);
+
+    std::thread t([&]() {
+        uEvent.wait(true);
+        waitCompleted = true;
+    });
+
+    while (uEvent.statusChangeWaiters == 0) {
+        std::this_thread::yield();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    // waiter is still parked on condition variable instead of spinning
+    EXPECT_FALSE(waitCompleted);
+    EXPECT_EQ(1u, uEvent.statusChangeWaiters.load());
+
+    auto signalTime = std::chrono::steady_clock::now();
+    uEvent.setStatus(CL_COMPLETE);
+    t.join();
+    auto wakeUpLatency = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - signalTime).count();
+
+    EXPECT_TRUE(waitCompleted);
+    EXPECT_EQ(0u, uEvent.statusChangeWaiters.load());
+    EXPECT_LT(wakeUpLatency, 1000);
+}
+
+TEST_F(EventTests, givenEventBlockedByUserEventWhenWaitingBlockingThenWaiterSleepsUntilUserEventIsSet) {
+    UserEvent uEvent;
+    MockEvent<Event> event(pCmdQ, CL_COMMAND_NDRANGE_KERNEL, Event::eventNotReady, Event::eventNotReady);
+    uEvent.addChild(event);
+    std::atomic<bool> waitCompleted(false);
+
+    std::thread t([&]() {
+        event.wait(true);
+        waitCompleted = true;
+    });
+
+    while (event.statusChangeWaiters == 0) {
+        std::this_thread::yield();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    EXPECT_FALSE(waitCompleted);
+    EXPECT_EQ(1u, event.statusChangeWaiters.load());
+
+    uEvent.setStatus(CL_COMPLETE);
+    t.join();
+
+    EXPECT_TRUE(waitCompleted);
+    EXPECT_EQ(0u, event.statusChangeWaiters.load());
+}
+
+TEST_F(EventTests, givenQueueBlockedByUserEventWhenFinishIsCalledFromOtherThreadThenItReturnsAfterUserEventIsSet) {
+    UserEvent uEvent;
+    cl_event eventWaitList[] = {&uEvent};
+    auto retVal = callOneWorkItemNDRKernel(eventWaitList, 1);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_TRUE(pCmdQ->isQueueBlocked());
+
+    std::atomic<bool> finishCompleted(false);
+    std::thread t([&]() {
+        clFinish(pCmdQ);
+        finishCompleted = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(finishCompleted);
+
+    uEvent.setStatus(CL_COMPLETE);
+    t.join();
+
+    EXPECT_TRUE(finishCompleted);
+    EXPECT_FALSE(pCmdQ->isQueueBlocked());
+}
@@ -27,6 +27,7 @@
 #include "runtime/helpers/ptr_math.h"
 #include "runtime/memory_manager/os_agnostic_memory_manager.h"
 #include "runtime/gmm_helper/gmm_helper.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
 #include "unit_tests/mocks/mock_device.h"
 #include "unit_tests/mocks/mock_gmm.h"
 
@@ -167,6 +168,80 @@ TEST_F(GmmTests, validImageTypeQuery) {
     EXPECT_EQ(queryGmm->resourceParams.Flags.Wa.__ForceOtherHVALIGN4, 1u);
 }
 
+TEST_F(GmmTests, givenImageLayoutCacheEnabledWhenSameImageIsQueriedTwiceThenCachedLayoutIsReturned) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.EnableImageLayoutCache.set(true);
+    Gmm::clearImageLayoutCache();
+
+    cl_image_desc imgDesc{};
+    imgDesc.image_type = CL_MEM_OBJECT_IMAGE3D;
+    imgDesc.image_width = 17;
+    imgDesc.image_height = 17;
+    imgDesc.image_depth = 17;
+
+    auto imgInfo = MockGmm::initImgInfo(imgDesc, 0, nullptr);
+    auto queryGmm = MockGmm::queryImgParams(imgInfo);
+    EXPECT_EQ(1u, Gmm::getImageLayoutCacheSize());
+
+    auto cachedImgInfo = MockGmm::initImgInfo(imgDesc, 0, nullptr);
+    auto cachedGmm = MockGmm::queryImgParams(cachedImgInfo);
+    EXPECT_EQ(1u, Gmm::getImageLayoutCacheSize());
+
+    EXPECT_EQ(imgInfo.size, cachedImgInfo.size);
+    EXPECT_EQ(imgInfo.rowPitch, cachedImgInfo.rowPitch);
+    EXPECT_EQ(imgInfo.slicePitch, cachedImgInfo.slicePitch);
+    EXPECT_EQ(imgInfo.qPitch, cachedImgInfo.qPitch);
+
+    ASSERT_NE(nullptr, cachedGmm->gmmResourceInfo.get());
+    EXPECT_NE(queryGmm->gmmResourceInfo.get(), cachedGmm->gmmResourceInfo.get());
+    EXPECT_EQ(queryGmm->gmmResourceInfo->getSizeAllocation(), cachedGmm->gmmResourceInfo->getSizeAllocation());
+    EXPECT_EQ(queryGmm->gmmResourceInfo->getTileType(), cachedGmm->gmmResourceInfo->getTileType());
+    EXPECT_EQ(queryGmm->resourceParams.BaseWidth, cachedGmm->resourceParams.BaseWidth);
+
+    Gmm::clearImageLayoutCache();
+}
+
+TEST_F(GmmTests, givenImageLayoutCacheEnabledWhenImagesWithDifferentDescriptorsAreQueriedThenSeparateLayoutsAreCached) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.EnableImageLayoutCache.set(true);
+    Gmm::clearImageLayoutCache();
+
+    cl_image_desc imgDesc{};
+    imgDesc.image_type = CL_MEM_OBJECT_IMAGE2D;
+    imgDesc.image_width = 64;
+    imgDesc.image_height = 64;
+
+    auto imgInfo = MockGmm::initImgInfo(imgDesc, 0, nullptr);
+    auto queryGmm = MockGmm::queryImgParams(imgInfo);
+
+    imgDesc.image_width = 128;
+    auto widerImgInfo = MockGmm::initImgInfo(imgDesc, 0, nullptr);
+    auto widerGmm = MockGmm::queryImgParams(widerImgInfo);
+
+    EXPECT_EQ(2u, Gmm::getImageLayoutCacheSize());
+    EXPECT_LT(imgInfo.rowPitch, widerImgInfo.rowPitch);
+    EXPECT_EQ(128u, widerGmm->gmmResourceInfo->getBaseWidth());
+
+    Gmm::clearImageLayoutCache();
+    EXPECT_EQ(0u, Gmm::getImageLayoutCacheSize());
+}
+
+TEST_F(GmmTests, givenImageLayoutCacheDisabledWhenImageIsQueriedThenLayoutIsNotCached) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.EnableImageLayoutCache.set(false);
+    Gmm::clearImageLayoutCache();
+
+    cl_image_desc imgDesc{};
+    imgDesc.image_type = CL_MEM_OBJECT_IMAGE2D;
+    imgDesc.image_width = 64;
+    imgDesc.image_height = 64;
+
+    auto imgInfo = MockGmm::initImgInfo(imgDesc, 0, nullptr);
+    auto queryGmm = MockGmm::queryImgParams(imgInfo);
+
+    EXPECT_EQ(0u, Gmm::getImageLayoutCacheSize());
+}
+
 TEST_F(GmmTests, given2DimageFromBufferParametersWhenGmmResourceIsCreatedThenItHasDesiredPitchAndSize) {
     cl_image_desc imgDesc{};
     imgDesc.image_type = CL_MEM_OBJECT_IMAGE2D;
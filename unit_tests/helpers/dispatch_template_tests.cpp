@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/dispatch_template.h"
+#include "runtime/indirect_heap/indirect_heap.h"
+#include "gtest/gtest.h"
+
+using namespace OCLRT;
+
+TEST(DispatchTemplateCache, givenKeyWithoutTemplateWhenFindIsCalledThenNullptrIsReturned) {
+    DispatchTemplateCache cache;
+    DispatchTemplateKey key;
+    key.dim = 1;
+    key.gws = {64, 1, 1};
+    EXPECT_EQ(nullptr, cache.find(key));
+
+    auto &dispatchTemplate = cache.obtain(key, {16, 1, 1});
+    EXPECT_EQ(&dispatchTemplate, cache.find(key));
+    EXPECT_EQ(Vec3<size_t>(16, 1, 1), dispatchTemplate.getLocalWorkgroupSize());
+    EXPECT_FALSE(dispatchTemplate.isRecorded());
+
+    key.offset = {1, 0, 0};
+    EXPECT_EQ(nullptr, cache.find(key));
+}
+
+TEST(DispatchTemplateCache, givenKeyDifferingOnlyInSlmSizeWhenFindIsCalledThenNullptrIsReturned) {
+    DispatchTemplateCache cache;
+    DispatchTemplateKey key;
+    key.dim = 1;
+    key.gws = {64, 1, 1};
+    cache.obtain(key, {16, 1, 1});
+
+    key.slmTotalSize = 4 * 1024;
+    EXPECT_EQ(nullptr, cache.find(key));
+}
+
+TEST(DispatchTemplateCache, givenFullCacheWhenNewTemplateIsObtainedThenOldestTemplateIsEvicted) {
+    DispatchTemplateCache cache;
+    DispatchTemplateKey keys[DispatchTemplateCache::maxTemplates + 1];
+    for (size_t i = 0; i < DispatchTemplateCache::maxTemplates + 1; i++) {
+        keys[i].dim = 1;
+        keys[i].gws = {i + 1, 1, 1};
+    }
+    for (size_t i = 0; i < DispatchTemplateCache::maxTemplates; i++) {
+        cache.obtain(keys[i], {1, 1, 1});
+    }
+    EXPECT_EQ(DispatchTemplateCache::maxTemplates, cache.getTemplateCount());
+
+    cache.obtain(keys[DispatchTemplateCache::maxTemplates], {1, 1, 1});
+    EXPECT_EQ(DispatchTemplateCache::maxTemplates, cache.getTemplateCount());
+    EXPECT_EQ(nullptr, cache.find(keys[0]));
+    for (size_t i = 1; i < DispatchTemplateCache::maxTemplates + 1; i++) {
+        EXPECT_NE(nullptr, cache.find(keys[i]));
+    }
+}
+
+TEST(DispatchTemplate, givenRecordedTemplateWhenReplayedThenRecordedBytesAreCopied) {
+    DispatchTemplateCache cache;
+    DispatchTemplateKey key;
+    auto &dispatchTemplate = cache.obtain(key, {1, 1, 1});
+
+    char perThreadData[64];
+    char walker[32];
+    for (size_t i = 0; i < sizeof(perThreadData); i++) {
+        perThreadData[i] = static_cast<char>(i);
+    }
+    for (size_t i = 0; i < sizeof(walker); i++) {
+        walker[i] = static_cast<char>(0xff - i);
+    }
+    dispatchTemplate.recordPerThreadData(perThreadData, sizeof(perThreadData));
+    EXPECT_FALSE(dispatchTemplate.isRecorded());
+    dispatchTemplate.recordWalker(walker, sizeof(walker));
+    EXPECT_TRUE(dispatchTemplate.isRecorded());
+
+    char iohBuffer[256] = {};
+    IndirectHeap ioh(iohBuffer, sizeof(iohBuffer));
+    ioh.getSpace(64);
+    dispatchTemplate.replayPerThreadData(ioh);
+    EXPECT_EQ(64u + sizeof(perThreadData), ioh.getUsed());
+    EXPECT_EQ(0, memcmp(iohBuffer + 64, perThreadData, sizeof(perThreadData)));
+
+    char replayedWalker[32] = {};
+    dispatchTemplate.replayWalker(replayedWalker, sizeof(replayedWalker));
+    EXPECT_EQ(0, memcmp(replayedWalker, walker, sizeof(walker)));
+}
@@ -32,6 +32,7 @@
 #include "unit_tests/fixtures/execution_model_kernel_fixture.h"
 #include "unit_tests/indirect_heap/indirect_heap_fixture.h"
 #include "unit_tests/fixtures/built_in_fixture.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
 #include "unit_tests/mocks/mock_kernel.h"
 #include "unit_tests/mocks/mock_program.h"
 #include "unit_tests/mocks/mock_context.h"
@@ -642,6 +643,79 @@ HWTEST_F(KernelCommandsTest, setBindingTableStatesForNoSurfaces) {
     delete pKernelInfo;
 }
 
+struct KernelCommandsBindingTableCacheTest : KernelCommandsTest {
+    void SetUp() override {
+        KernelCommandsTest::SetUp();
+        DebugManager.flags.EnableBindingTableCache.set(true);
+
+        kernelHeader.SurfaceStateHeapSize = sizeof(surfaceStateHeap);
+        kernelInfo.reset(KernelInfo::create());
+        kernelInfo->heapInfo.pSsh = surfaceStateHeap;
+        kernelInfo->heapInfo.pKernelHeader = &kernelHeader;
+        kernelInfo->usesSsh = true;
+
+        bindingTableState.Token = iOpenCL::PATCH_TOKEN_BINDING_TABLE_STATE;
+        bindingTableState.Size = sizeof(SPatchBindingTableState);
+        bindingTableState.Count = 1;
+        bindingTableState.Offset = 64;
+        bindingTableState.SurfaceStateOffset = 0;
+        kernelInfo->patchInfo.bindingTableState = &bindingTableState;
+
+        program.reset(new MockProgram(pContext, false));
+        kernel.reset(new MockKernel(program.get(), *kernelInfo, *pDevice));
+        ASSERT_EQ(CL_SUCCESS, kernel->initialize());
+    }
+
+    void TearDown() override {
+        kernel.reset();
+        program.reset();
+        kernelInfo->patchInfo.bindingTableState = nullptr;
+        kernelInfo.reset();
+        KernelCommandsTest::TearDown();
+    }
+
+    DebugManagerStateRestore dbgRestore;
+    char surfaceStateHeap[256] = {};
+    SKernelBinaryHeaderCommon kernelHeader = {};
+    SPatchBindingTableState bindingTableState = {};
+    std::unique_ptr<KernelInfo> kernelInfo;
+    std::unique_ptr<MockProgram> program;
+    std::unique_ptr<MockKernel> kernel;
+};
+
+HWTEST_F(KernelCommandsBindingTableCacheTest, givenBindingTableCacheEnabledWhenKernelSshIsUnchangedThenBindingTableAlreadyInHeapIsReused) {
+    CommandQueueHw<FamilyType> cmdQ(nullptr, pDevice, 0);
+    auto &ssh = cmdQ.getIndirectHeap(IndirectHeap::SURFACE_STATE, 8192);
+    ssh.getSpace(64);
+
+    auto firstBindingTablePointer = KernelCommandsHelper<FamilyType>::pushBindingTableAndSurfaceStates(ssh, *kernel);
+    auto usedAfterFirstPush = ssh.getUsed();
+
+    auto secondBindingTablePointer = KernelCommandsHelper<FamilyType>::pushBindingTableAndSurfaceStates(ssh, *kernel);
+    EXPECT_EQ(firstBindingTablePointer, secondBindingTablePointer);
+    EXPECT_EQ(usedAfterFirstPush, ssh.getUsed());
+
+    // non-const access to kernel's SSH invalidates pushed binding table
+    kernel->getSurfaceStateHeap();
+    auto thirdBindingTablePointer = KernelCommandsHelper<FamilyType>::pushBindingTableAndSurfaceStates(ssh, *kernel);
+    EXPECT_NE(firstBindingTablePointer, thirdBindingTablePointer);
+    EXPECT_LT(usedAfterFirstPush, ssh.getUsed());
+}
+
+HWTEST_F(KernelCommandsBindingTableCacheTest, givenBindingTableCacheEnabledWhenSurfaceStateHeapIsReplacedThenBindingTableIsPushedAgain) {
+    CommandQueueHw<FamilyType> cmdQ(nullptr, pDevice, 0);
+    auto &ssh = cmdQ.getIndirectHeap(IndirectHeap::SURFACE_STATE, 8192);
+    KernelCommandsHelper<FamilyType>::pushBindingTableAndSurfaceStates(ssh, *kernel);
+    EXPECT_NE(0u, ssh.getUsed());
+
+    cmdQ.releaseIndirectHeap(IndirectHeap::SURFACE_STATE);
+    auto &newSsh = cmdQ.getIndirectHeap(IndirectHeap::SURFACE_STATE, 8192);
+    EXPECT_EQ(0u, newSsh.getUsed());
+
+    KernelCommandsHelper<FamilyType>::pushBindingTableAndSurfaceStates(newSsh, *kernel);
+    EXPECT_NE(0u, newSsh.getUsed());
+}
+
 HWTEST_F(KernelCommandsTest, slmValueScenarios) {
     if (::renderCoreFamily == IGFX_GEN8_CORE) {
         EXPECT_EQ(0u, KernelCommandsHelper<FamilyType>::computeSlmValues(0));
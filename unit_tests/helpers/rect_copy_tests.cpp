@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/rect_copy.h"
+#include "gtest/gtest.h"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using namespace OCLRT;
+
+namespace {
+size_t referenceOffset(const size_t *origin, size_t x, size_t y, size_t z, size_t rowPitch, size_t slicePitch) {
+    return (origin[2] + z) * slicePitch + (origin[1] + y) * rowPitch + origin[0] + x;
+}
+} // namespace
+
+TEST(RectCopy, givenStridedViewsWhenCopyRectIsCalledThenOnlyRegionBytesAreCopiedToDestinationOrigin) {
+    const size_t srcOrigin[] = {3, 2, 1};
+    const size_t dstOrigin[] = {1, 0, 2};
+    const size_t region[] = {5, 3, 2};
+    const size_t srcRowPitch = 16, srcSlicePitch = 64;
+    const size_t dstRowPitch = 8, dstSlicePitch = 40;
+
+    std::vector<uint8_t> src(4 * srcSlicePitch);
+    std::vector<uint8_t> dst(5 * dstSlicePitch, 0xCD);
+    for (size_t i = 0; i < src.size(); i++) {
+        src[i] = static_cast<uint8_t>(i);
+    }
+    auto expected = dst;
+    for (size_t z = 0; z < region[2]; z++) {
+        for (size_t y = 0; y < region[1]; y++) {
+            for (size_t x = 0; x < region[0]; x++) {
+                expected[referenceOffset(dstOrigin, x, y, z, dstRowPitch, dstSlicePitch)] = src[referenceOffset(srcOrigin, x, y, z, srcRowPitch, srcSlicePitch)];
+            }
+        }
+    }
+
+    copyRect(dst.data(), dstOrigin, dstRowPitch, dstSlicePitch, src.data(), srcOrigin, srcRowPitch, srcSlicePitch, region);
+    EXPECT_EQ(expected, dst);
+}
+
+TEST(RectCopy, givenEmptyRegionWhenCopyRectIsCalledThenDestinationIsNotModified) {
+    const size_t origin[] = {0, 0, 0};
+    const size_t region[] = {0, 4, 1};
+    uint8_t src[16] = {1};
+    uint8_t dst[16] = {};
+
+    copyRect(dst, origin, 4, 16, src, origin, 4, 16, region);
+    EXPECT_EQ(0u, dst[0]);
+}
+
+TEST(RectCopy, givenSmallRegionWhenThreadCountIsQueriedThenSingleThreadIsUsed) {
+    const size_t region[] = {64, 64, 1};
+    EXPECT_EQ(1u, getRectCopyThreadCount(region, rectCopyMaxThreads));
+}
+
+TEST(RectCopy, givenLargeRegionWhenThreadCountIsQueriedThenItIsLimitedByMaxThreadsAndRowCount) {
+    const size_t region[] = {rectCopyParallelThreshold, 2, 1};
+    auto threadCount = getRectCopyThreadCount(region, rectCopyMaxThreads);
+    EXPECT_LE(1u, threadCount);
+    EXPECT_GE(2u, threadCount);
+    EXPECT_EQ(1u, getRectCopyThreadCount(region, 1));
+}
+
+TEST(RectCopy, givenRegionAboveParallelThresholdWhenCopyRectIsCalledThenAllRowsAreCopied) {
+    const size_t origin[] = {0, 0, 0};
+    const size_t dstOrigin[] = {16, 0, 0};
+    const size_t rowSize = 4096;
+    const size_t rows = (rectCopyParallelThreshold / rowSize) + 7;
+    const size_t region[] = {rowSize, rows, 1};
+
+    std::vector<uint8_t> src(rowSize * rows);
+    for (size_t i = 0; i < src.size(); i++) {
+        src[i] = static_cast<uint8_t>(i * 7 + i / rowSize);
+    }
+    std::vector<uint8_t> dst((rowSize + 32) * rows, 0);
+
+    copyRect(dst.data(), dstOrigin, rowSize + 32, (rowSize + 32) * rows, src.data(), origin, rowSize, rowSize * rows, region);
+
+    for (size_t y = 0; y < rows; y++) {
+        EXPECT_EQ(0, memcmp(&dst[y * (rowSize + 32) + 16], &src[y * rowSize], rowSize)) << "row " << y;
+        EXPECT_EQ(0u, dst[y * (rowSize + 32) + 15]);
+    }
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "unit_tests/helpers/tiling.h"
+#include "runtime/helpers/debug_helpers.h"
+#include "runtime/helpers/ptr_math.h"
+#include "runtime/helpers/string.h"
+#include <algorithm>
+
+namespace OCLRT {
+namespace {
+template <ImageTiling tiling>
+struct TileTraits;
+
+template <>
+struct TileTraits<ImageTiling::TileX> {
+    static const size_t width = 512;
+    static const size_t height = 8;
+    // bytes of one tile row that are contiguous in memory
+    static const size_t spanWidth = 512;
+
+    static size_t getOffsetInTile(size_t x, size_t y) {
+        return y * width + x;
+    }
+};
+
+template <>
+struct TileTraits<ImageTiling::TileY> {
+    static const size_t width = 128;
+    static const size_t height = 32;
+    static const size_t spanWidth = 16;
+
+    static size_t getOffsetInTile(size_t x, size_t y) {
+        return (x / spanWidth) * (spanWidth * height) + y * spanWidth + x % spanWidth;
+    }
+};
+
+template <ImageTiling tiling>
+size_t getTiledOffset(size_t rowPitch, size_t x, size_t y) {
+    using Traits = TileTraits<tiling>;
+    auto tileIndex = (y / Traits::height) * (rowPitch / Traits::width) + x / Traits::width;
+    return tileIndex * tileSizeInBytes + Traits::getOffsetInTile(x % Traits::width, y % Traits::height);
+}
+
+// walks a row of the tiled surface in spans that are contiguous on both sides
+template <ImageTiling tiling, bool toTiled>
+void copyRows(void *linear, const size_t *linearOrigin, size_t linearRowPitch, size_t linearSlicePitch,
+              const void *tiled, const size_t *tiledOrigin, size_t tiledRowPitch, size_t tiledSlicePitch,
+              const size_t *region) {
+    using Traits = TileTraits<tiling>;
+    DEBUG_BREAK_IF(tiledRowPitch % Traits::width != 0);
+
+    for (size_t slice = 0; slice < region[2]; slice++) {
+        auto tiledSlice = ptrOffset(tiled, (tiledOrigin[2] + slice) * tiledSlicePitch);
+        for (size_t row = 0; row < region[1]; row++) {
+            auto linearRow = ptrOffset(linear, (linearOrigin[2] + slice) * linearSlicePitch + (linearOrigin[1] + row) * linearRowPitch + linearOrigin[0]);
+            auto y = tiledOrigin[1] + row;
+            size_t x = tiledOrigin[0];
+            size_t end = tiledOrigin[0] + region[0];
+            while (x < end) {
+                auto span = std::min(end - x, Traits::spanWidth - x % Traits::spanWidth);
+                auto tiledPtr = const_cast<void *>(ptrOffset(tiledSlice, getTiledOffset<tiling>(tiledRowPitch, x, y)));
+                auto linearPtr = ptrOffset(linearRow, x - tiledOrigin[0]);
+                if (toTiled) {
+                    memcpy_s(tiledPtr, span, linearPtr, span);
+                } else {
+                    memcpy_s(linearPtr, span, tiledPtr, span);
+                }
+                x += span;
+            }
+        }
+    }
+}
+
+template <bool toTiled>
+void copyTiled(void *linear, const size_t *linearOrigin, size_t linearRowPitch, size_t linearSlicePitch,
+               const void *tiled, ImageTiling tiling, const size_t *tiledOrigin, size_t tiledRowPitch, size_t tiledSlicePitch,
+               const size_t *region) {
+    switch (tiling) {
+    case ImageTiling::TileX:
+        copyRows<ImageTiling::TileX, toTiled>(linear, linearOrigin, linearRowPitch, linearSlicePitch, tiled, tiledOrigin, tiledRowPitch, tiledSlicePitch, region);
+        break;
+    case ImageTiling::TileY:
+        copyRows<ImageTiling::TileY, toTiled>(linear, linearOrigin, linearRowPitch, linearSlicePitch, tiled, tiledOrigin, tiledRowPitch, tiledSlicePitch, region);
+        break;
+    default:
+        DEBUG_BREAK_IF(true);
+        break;
+    }
+}
+} // namespace
+
+size_t getTileWidthInBytes(ImageTiling tiling) {
+    switch (tiling) {
+    case ImageTiling::TileX:
+        return TileTraits<ImageTiling::TileX>::width;
+    case ImageTiling::TileY:
+        return TileTraits<ImageTiling::TileY>::width;
+    default:
+        return 1;
+    }
+}
+
+size_t getTileHeightInRows(ImageTiling tiling) {
+    switch (tiling) {
+    case ImageTiling::TileX:
+        return TileTraits<ImageTiling::TileX>::height;
+    case ImageTiling::TileY:
+        return TileTraits<ImageTiling::TileY>::height;
+    default:
+        return 1;
+    }
+}
+
+size_t getTiledOffset(ImageTiling tiling, size_t rowPitch, size_t x, size_t y) {
+    switch (tiling) {
+    case ImageTiling::TileX:
+        return getTiledOffset<ImageTiling::TileX>(rowPitch, x, y);
+    case ImageTiling::TileY:
+        return getTiledOffset<ImageTiling::TileY>(rowPitch, x, y);
+    default:
+        return y * rowPitch + x;
+    }
+}
+
+void copyTiledToLinear(void *linear, const size_t *linearOrigin, size_t linearRowPitch, size_t linearSlicePitch,
+                       const void *tiled, ImageTiling tiling, const size_t *tiledOrigin, size_t tiledRowPitch, size_t tiledSlicePitch,
+                       const size_t *region) {
+    copyTiled<false>(linear, linearOrigin, linearRowPitch, linearSlicePitch, tiled, tiling, tiledOrigin, tiledRowPitch, tiledSlicePitch, region);
+}
+
+void copyLinearToTiled(void *tiled, ImageTiling tiling, const size_t *tiledOrigin, size_t tiledRowPitch, size_t tiledSlicePitch,
+                       const void *linear, const size_t *linearOrigin, size_t linearRowPitch, size_t linearSlicePitch,
+                       const size_t *region) {
+    copyTiled<true>(const_cast<void *>(linear), linearOrigin, linearRowPitch, linearSlicePitch, tiled, tiling, tiledOrigin, tiledRowPitch, tiledSlicePitch, region);
+}
+} // namespace OCLRT
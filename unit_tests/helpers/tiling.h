@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace OCLRT {
+// Test model of tiled surface layouts as the GPU addresses them, the runtime never accesses tiled
+// storage on the CPU. Tiles are 4KB and follow each other in row-major order across the surface pitch,
+// which is a multiple of the tile width.
+// TileX: 512B x 8 rows, each tile row contiguous.
+// TileY: 128B x 32 rows, stored as 8 columns of 16B x 32 rows.
+enum class ImageTiling : uint32_t {
+    Linear,
+    TileX,
+    TileY
+};
+
+constexpr size_t tileSizeInBytes = 4096;
+
+size_t getTileWidthInBytes(ImageTiling tiling);
+size_t getTileHeightInRows(ImageTiling tiling);
+
+// Offset of byte x in row y of a surface with the given tiling and row pitch, reference for the copies below.
+size_t getTiledOffset(ImageTiling tiling, size_t rowPitch, size_t x, size_t y);
+
+// Host side equivalents of image reads and writes: copy region[0] bytes of region[1] rows in region[2]
+// slices between a linear view and a tiled surface. Origins and region are in bytes, rows and slices,
+// slice pitch of the tiled surface is its qpitch in rows times its row pitch. Bit-6 swizzling is not modeled.
+void copyTiledToLinear(void *linear, const size_t *linearOrigin, size_t linearRowPitch, size_t linearSlicePitch,
+                       const void *tiled, ImageTiling tiling, const size_t *tiledOrigin, size_t tiledRowPitch, size_t tiledSlicePitch,
+                       const size_t *region);
+void copyLinearToTiled(void *tiled, ImageTiling tiling, const size_t *tiledOrigin, size_t tiledRowPitch, size_t tiledSlicePitch,
+                       const void *linear, const size_t *linearOrigin, size_t linearRowPitch, size_t linearSlicePitch,
+                       const size_t *region);
+} // namespace OCLRT
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "unit_tests/helpers/tiling.h"
+#include "gtest/gtest.h"
+#include <cstdint>
+#include <vector>
+
+using namespace OCLRT;
+
+namespace {
+struct TiledSurface {
+    TiledSurface(ImageTiling tiling, size_t widthInTiles, size_t heightInTiles, size_t slices)
+        : tiling(tiling),
+          rowPitch(widthInTiles * getTileWidthInBytes(tiling)),
+          qPitch(heightInTiles * getTileHeightInRows(tiling)),
+          slicePitch(rowPitch * qPitch),
+          storage(slicePitch * slices) {
+        for (size_t i = 0; i < storage.size(); i++) {
+            storage[i] = static_cast<uint8_t>(i * 7 + i / 251);
+        }
+    }
+    uint8_t &at(size_t x, size_t y, size_t z) {
+        return storage[z * slicePitch + getTiledOffset(tiling, rowPitch, x, y)];
+    }
+    ImageTiling tiling;
+    size_t rowPitch;
+    size_t qPitch;
+    size_t slicePitch;
+    std::vector<uint8_t> storage;
+};
+} // namespace
+
+TEST(Tiling, givenTileYWhenGettingTiledOffsetThenOWordColumnsAreStackedWithinTile) {
+    const size_t rowPitch = 256;
+    EXPECT_EQ(0u, getTiledOffset(ImageTiling::TileY, rowPitch, 0, 0));
+    EXPECT_EQ(15u, getTiledOffset(ImageTiling::TileY, rowPitch, 15, 0));
+    EXPECT_EQ(512u, getTiledOffset(ImageTiling::TileY, rowPitch, 16, 0));
+    EXPECT_EQ(16u, getTiledOffset(ImageTiling::TileY, rowPitch, 0, 1));
+    EXPECT_EQ(4096u, getTiledOffset(ImageTiling::TileY, rowPitch, 128, 0));
+    EXPECT_EQ(2 * 4096u, getTiledOffset(ImageTiling::TileY, rowPitch, 0, 32));
+    EXPECT_EQ(3 * 4096u + 512u + 16u + 1u, getTiledOffset(ImageTiling::TileY, rowPitch, 145, 33));
+}
+
+TEST(Tiling, givenTileXWhenGettingTiledOffsetThenTileRowsAreContiguous) {
+    const size_t rowPitch = 1024;
+    EXPECT_EQ(0u, getTiledOffset(ImageTiling::TileX, rowPitch, 0, 0));
+    EXPECT_EQ(511u, getTiledOffset(ImageTiling::TileX, rowPitch, 511, 0));
+    EXPECT_EQ(4096u, getTiledOffset(ImageTiling::TileX, rowPitch, 512, 0));
+    EXPECT_EQ(512u, getTiledOffset(ImageTiling::TileX, rowPitch, 0, 1));
+    EXPECT_EQ(2 * 4096u, getTiledOffset(ImageTiling::TileX, rowPitch, 0, 8));
+    EXPECT_EQ(3 * 4096u + 2 * 512u + 5u, getTiledOffset(ImageTiling::TileX, rowPitch, 517, 10));
+}
+
+TEST(Tiling, givenLinearWhenGettingTiledOffsetThenPitchedOffsetIsReturned) {
+    EXPECT_EQ(3 * 100u + 7u, getTiledOffset(ImageTiling::Linear, 100, 7, 3));
+    EXPECT_EQ(1u, getTileWidthInBytes(ImageTiling::Linear));
+    EXPECT_EQ(1u, getTileHeightInRows(ImageTiling::Linear));
+}
+
+class TilingCopyTest : public ::testing::TestWithParam<ImageTiling> {};
+
+TEST_P(TilingCopyTest, givenUnalignedRegionWhenCopyingTiledToLinearThenBytesMatchReference) {
+    TiledSurface surface(GetParam(), 3, 2, 3);
+    const size_t tiledOrigin[] = {getTileWidthInBytes(GetParam()) - 5, getTileHeightInRows(GetParam()) - 3, 1};
+    const size_t region[] = {getTileWidthInBytes(GetParam()) + 37, 7, 2};
+    const size_t linearOrigin[] = {3, 1, 0};
+    const size_t linearRowPitch = region[0] + 11;
+    const size_t linearSlicePitch = linearRowPitch * (region[1] + 2);
+    std::vector<uint8_t> linear(linearSlicePitch * region[2], 0xcd);
+
+    copyTiledToLinear(linear.data(), linearOrigin, linearRowPitch, linearSlicePitch,
+                      surface.storage.data(), GetParam(), tiledOrigin, surface.rowPitch, surface.slicePitch, region);
+
+    for (size_t z = 0; z < region[2]; z++) {
+        for (size_t y = 0; y < region[1]; y++) {
+            for (size_t x = 0; x < region[0]; x++) {
+                auto linearOffset = (linearOrigin[2] + z) * linearSlicePitch + (linearOrigin[1] + y) * linearRowPitch + linearOrigin[0] + x;
+                ASSERT_EQ(surface.at(tiledOrigin[0] + x, tiledOrigin[1] + y, tiledOrigin[2] + z), linear[linearOffset]);
+            }
+        }
+    }
+    EXPECT_EQ(0xcd, linear[0]);
+    EXPECT_EQ(0xcd, linear[linearRowPitch - 1]);
+}
+
+TEST_P(TilingCopyTest, givenUnalignedRegionWhenCopyingLinearToTiledThenOnlyRegionBytesChange) {
+    TiledSurface surface(GetParam(), 3, 2, 2);
+    auto reference = surface.storage;
+    const size_t tiledOrigin[] = {13, getTileHeightInRows(GetParam()) - 1, 1};
+    const size_t region[] = {2 * getTileWidthInBytes(GetParam()) + 1, 3, 1};
+    const size_t linearOrigin[] = {0, 0, 0};
+    const size_t linearRowPitch = region[0];
+    const size_t linearSlicePitch = linearRowPitch * region[1];
+    std::vector<uint8_t> linear(linearSlicePitch);
+    for (size_t i = 0; i < linear.size(); i++) {
+        linear[i] = static_cast<uint8_t>(i * 13 + 1);
+    }
+
+    copyLinearToTiled(surface.storage.data(), GetParam(), tiledOrigin, surface.rowPitch, surface.slicePitch,
+                      linear.data(), linearOrigin, linearRowPitch, linearSlicePitch, region);
+
+    for (size_t y = 0; y < region[1]; y++) {
+        for (size_t x = 0; x < region[0]; x++) {
+            auto offset = tiledOrigin[2] * surface.slicePitch + getTiledOffset(GetParam(), surface.rowPitch, tiledOrigin[0] + x, tiledOrigin[1] + y);
+            reference[offset] = linear[y * linearRowPitch + x];
+        }
+    }
+    EXPECT_EQ(reference, surface.storage);
+}
+
+TEST_P(TilingCopyTest, givenWholeSurfaceWhenCopiedToLinearAndBackThenSurfaceIsUnchanged) {
+    TiledSurface surface(GetParam(), 2, 2, 1);
+    auto original = surface.storage;
+    const size_t origin[] = {0, 0, 0};
+    const size_t region[] = {surface.rowPitch, surface.qPitch, 1};
+    std::vector<uint8_t> linear(surface.slicePitch);
+
+    copyTiledToLinear(linear.data(), origin, surface.rowPitch, surface.slicePitch,
+                      surface.storage.data(), GetParam(), origin, surface.rowPitch, surface.slicePitch, region);
+    EXPECT_NE(original, linear);
+    std::fill(surface.storage.begin(), surface.storage.end(), static_cast<uint8_t>(0));
+    copyLinearToTiled(surface.storage.data(), GetParam(), origin, surface.rowPitch, surface.slicePitch,
+                      linear.data(), origin, surface.rowPitch, surface.slicePitch, region);
+    EXPECT_EQ(original, surface.storage);
+}
+
+INSTANTIATE_TEST_CASE_P(Tiling,
+                        TilingCopyTest,
+                        ::testing::Values(ImageTiling::TileX, ImageTiling::TileY));
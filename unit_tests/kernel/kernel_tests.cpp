@@ -2129,3 +2129,17 @@ TEST(KernelTest, givenKernelWhenDebugFlagToUseMaxSimdForCalculationsIsUsedThenMa
     kernel.mockKernel->getWorkGroupInfo(device.get(), CL_KERNEL_WORK_GROUP_SIZE, sizeof(size_t), &maxKernelWkgSize, nullptr);
     EXPECT_EQ(256u, maxKernelWkgSize);
 }
+
+TEST(KernelTest, givenKernelWithExecInfoAllocationWhenAllocationsAccessIsQueriedThenExecInfoAllocationIsReportedAsWritten) {
+    auto device = std::unique_ptr<Device>(DeviceHelper<>::create(platformDevices[0]));
+    MockKernelWithInternals kernel(*device);
+    GraphicsAllocation execInfoAllocation(nullptr, 4096);
+    kernel.mockKernel->setKernelExecInfo(&execInfoAllocation);
+
+    std::vector<GraphicsAllocation *> readOnlyAllocations;
+    std::vector<GraphicsAllocation *> writtenAllocations;
+    kernel.mockKernel->getAllocationsAccess(readOnlyAllocations, writtenAllocations);
+
+    EXPECT_EQ(readOnlyAllocations.end(), std::find(readOnlyAllocations.begin(), readOnlyAllocations.end(), &execInfoAllocation));
+    EXPECT_NE(writtenAllocations.end(), std::find(writtenAllocations.begin(), writtenAllocations.end(), &execInfoAllocation));
+}
@@ -226,6 +226,40 @@ TEST_P(ImageRedescribeTest, VerifyCubeFaceIndices) {
     }
 }
 
+TEST_P(ImageRedescribeTest, givenCachedViewWhenRequestedAgainThenSameViewIsReturned) {
+    auto getView = (redescribeMethod == &Image::redescribe) ? &Image::getRedescribedView : &Image::getRedescribedFillView;
+
+    auto view = (image->*getView)();
+    ASSERT_NE(nullptr, view);
+    auto viewAgain = (image->*getView)();
+    EXPECT_EQ(view, viewAgain);
+    EXPECT_EQ(3, view->getReference());
+
+    auto imageNew = (image->*redescribeMethod)();
+    EXPECT_EQ(imageNew->getSurfaceFormatInfo().GenxSurfaceFormat, view->getSurfaceFormatInfo().GenxSurfaceFormat);
+    EXPECT_EQ(image->getGraphicsAllocation(), view->getGraphicsAllocation());
+    delete imageNew;
+
+    view->release();
+    viewAgain->release();
+    EXPECT_EQ(1, view->getReference());
+}
+
+TEST_P(ImageRedescribeTest, givenCachedViewWhenParentCubeFaceIndexChangesThenNewViewIsCreated) {
+    auto getView = (redescribeMethod == &Image::redescribe) ? &Image::getRedescribedView : &Image::getRedescribedFillView;
+
+    auto view = (image->*getView)();
+    ASSERT_NE(nullptr, view);
+    EXPECT_EQ(image->getCubeFaceIndex(), view->getCubeFaceIndex());
+    view->release();
+
+    image->setCubeFaceIndex(__GMM_CUBE_FACE_POS_X);
+    auto newView = (image->*getView)();
+    ASSERT_NE(nullptr, newView);
+    EXPECT_EQ(static_cast<uint32_t>(__GMM_CUBE_FACE_POS_X), newView->getCubeFaceIndex());
+    newView->release();
+}
+
 TEST_P(ImageRedescribeTest, newImageDoesNotExceedMaxSizes) {
     cl_image_format imageFormat;
     cl_image_desc imageDesc;
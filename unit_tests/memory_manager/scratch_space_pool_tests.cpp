@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/memory_manager/graphics_allocation.h"
+#include "runtime/memory_manager/memory_constants.h"
+#include "runtime/memory_manager/os_agnostic_memory_manager.h"
+#include "runtime/memory_manager/scratch_space_pool.h"
+#include "gtest/gtest.h"
+
+using namespace OCLRT;
+
+struct ScratchSpacePoolTest : public ::testing::Test {
+    void SetUp() override {
+        pool = memoryManager.getScratchSpacePool();
+    }
+
+    OsAgnosticMemoryManager memoryManager;
+    ScratchSpacePool *pool = nullptr;
+    volatile uint32_t tag = 0;
+};
+
+TEST(ScratchSpacePool, givenRequiredSizeWhenSizeClassIsQueriedThenPowerOfTwoNotSmallerThan64KBIsReturned) {
+    EXPECT_EQ(MemoryConstants::pageSize64k, ScratchSpacePool::getSizeClass(1));
+    EXPECT_EQ(MemoryConstants::pageSize64k, ScratchSpacePool::getSizeClass(MemoryConstants::pageSize64k));
+    EXPECT_EQ(2 * MemoryConstants::pageSize64k, ScratchSpacePool::getSizeClass(MemoryConstants::pageSize64k + 1));
+    EXPECT_EQ(8 * MemoryConstants::pageSize64k, ScratchSpacePool::getSizeClass(5 * MemoryConstants::pageSize64k));
+}
+
+TEST_F(ScratchSpacePoolTest, givenMemoryManagerWhenScratchSpacePoolIsRequestedTwiceThenSamePoolIsReturned) {
+    EXPECT_NE(nullptr, pool);
+    EXPECT_EQ(pool, memoryManager.getScratchSpacePool());
+    EXPECT_EQ(pool, memoryManager.peekScratchSpacePool());
+}
+
+TEST_F(ScratchSpacePoolTest, givenEmptyPoolWhenAllocationIsObtainedThenItIsCreatedWithSizeClassSize) {
+    auto allocation = pool->obtain(1024);
+    ASSERT_NE(nullptr, allocation);
+    EXPECT_EQ(MemoryConstants::pageSize64k, allocation->getUnderlyingBufferSize());
+    EXPECT_EQ(1u, pool->peekCreatedCount());
+    memoryManager.freeGraphicsMemory(allocation);
+}
+
+TEST_F(ScratchSpacePoolTest, givenIdleRetiredAllocationWhenSameSizeClassIsObtainedThenItIsReused) {
+    auto allocation = pool->obtain(1024);
+    pool->retire(allocation, 5, &tag);
+    EXPECT_EQ(1u, pool->peekPooledCount());
+
+    tag = 5;
+    auto reused = pool->obtain(4096);
+    EXPECT_EQ(allocation, reused);
+    EXPECT_EQ(1u, pool->peekCreatedCount());
+    EXPECT_EQ(0u, pool->peekPooledCount());
+    memoryManager.freeGraphicsMemory(reused);
+}
+
+TEST_F(ScratchSpacePoolTest, givenBusyRetiredAllocationWhenSameSizeClassIsObtainedThenNewAllocationIsCreated) {
+    auto allocation = pool->obtain(1024);
+    pool->retire(allocation, 5, &tag);
+
+    tag = 4;
+    auto newAllocation = pool->obtain(1024);
+    EXPECT_NE(allocation, newAllocation);
+    EXPECT_EQ(2u, pool->peekCreatedCount());
+    EXPECT_EQ(1u, pool->peekPooledCount());
+    memoryManager.freeGraphicsMemory(newAllocation);
+}
+
+TEST_F(ScratchSpacePoolTest, givenIdleRetiredAllocationWhenDifferentSizeClassIsObtainedThenNewAllocationIsCreated) {
+    auto allocation = pool->obtain(1024);
+    pool->retire(allocation, 0, nullptr);
+
+    auto bigAllocation = pool->obtain(2 * MemoryConstants::pageSize64k);
+    EXPECT_NE(allocation, bigAllocation);
+    EXPECT_EQ(2 * MemoryConstants::pageSize64k, bigAllocation->getUnderlyingBufferSize());
+    EXPECT_EQ(1u, pool->peekPooledCount());
+    memoryManager.freeGraphicsMemory(bigAllocation);
+}
+
+TEST_F(ScratchSpacePoolTest, givenBusyRetiredAllocationWhenTagAddressIsReleasedThenAllocationBecomesReusable) {
+    auto allocation = pool->obtain(1024);
+    pool->retire(allocation, 5, &tag);
+
+    pool->releaseTagAddress(&tag);
+    auto reused = pool->obtain(1024);
+    EXPECT_EQ(allocation, reused);
+    memoryManager.freeGraphicsMemory(reused);
+}
+
+TEST_F(ScratchSpacePoolTest, givenFullPoolWithIdleAllocationWhenAllocationIsRetiredThenOldestIdleOneIsFreed) {
+    pool->setMaxPooledAllocations(1);
+    auto first = pool->obtain(1024);
+    auto second = pool->obtain(1024);
+    pool->retire(first, 0, nullptr);
+    pool->retire(second, 5, &tag);
+
+    EXPECT_EQ(1u, pool->peekPooledCount());
+    EXPECT_TRUE(memoryManager.graphicsAllocations.peekIsEmpty());
+}
+
+TEST_F(ScratchSpacePoolTest, givenFullPoolWithBusyAllocationsWhenAllocationIsRetiredThenItIsStoredAsTemporaryAllocation) {
+    pool->setMaxPooledAllocations(1);
+    auto first = pool->obtain(1024);
+    auto second = pool->obtain(1024);
+    pool->retire(first, 5, &tag);
+    pool->retire(second, 7, &tag);
+
+    EXPECT_EQ(1u, pool->peekPooledCount());
+    EXPECT_EQ(second, memoryManager.graphicsAllocations.peekHead());
+    EXPECT_EQ(7u, second->taskCount);
+}
@@ -131,7 +131,7 @@ TEST_F(SVMMemoryAllocatorTest, WhenCouldNotAllocateInMemoryManagerThenReturnsNul
             : SVMAllocsManager(m) {
         }
 
-        MapBasedAllocationTracker &GetSVMAllocs() {
+        SortedArrayAllocationTracker &GetSVMAllocs() {
             return SVMAllocs;
         }
     };
@@ -145,3 +145,58 @@ TEST_F(SVMMemoryAllocatorTest, WhenCouldNotAllocateInMemoryManagerThenReturnsNul
         EXPECT_EQ(0U, svmM.GetSVMAllocs().getNumAllocs());
     }
 }
+
+template <typename TrackerType>
+struct SVMAllocationTrackerTest : public ::testing::Test {
+    TrackerType tracker;
+};
+
+typedef ::testing::Types<SVMAllocsManager::MapBasedAllocationTracker, SVMAllocsManager::SortedArrayAllocationTracker> SVMAllocationTrackerTypes;
+TYPED_TEST_CASE(SVMAllocationTrackerTest, SVMAllocationTrackerTypes);
+
+TYPED_TEST(SVMAllocationTrackerTest, givenInsertedAllocationsWhenLookingUpPointersThenContainingAllocationIsReturned) {
+    GraphicsAllocation first(reinterpret_cast<void *>(0x10000), 0x1000);
+    GraphicsAllocation second(reinterpret_cast<void *>(0x30000), 0x2000);
+    GraphicsAllocation third(reinterpret_cast<void *>(0x20000), 0x1000);
+    this->tracker.insert(first);
+    this->tracker.insert(second);
+    this->tracker.insert(third);
+    EXPECT_EQ(3u, this->tracker.getNumAllocs());
+
+    EXPECT_EQ(nullptr, this->tracker.get(nullptr));
+    EXPECT_EQ(nullptr, this->tracker.get(reinterpret_cast<void *>(0xffff)));
+    EXPECT_EQ(&first, this->tracker.get(reinterpret_cast<void *>(0x10000)));
+    EXPECT_EQ(&first, this->tracker.get(reinterpret_cast<void *>(0x10fff)));
+    EXPECT_EQ(nullptr, this->tracker.get(reinterpret_cast<void *>(0x11000)));
+    EXPECT_EQ(&third, this->tracker.get(reinterpret_cast<void *>(0x20800)));
+    EXPECT_EQ(&second, this->tracker.get(reinterpret_cast<void *>(0x31fff)));
+    EXPECT_EQ(nullptr, this->tracker.get(reinterpret_cast<void *>(0x32000)));
+
+    this->tracker.remove(third);
+    EXPECT_EQ(2u, this->tracker.getNumAllocs());
+    EXPECT_EQ(nullptr, this->tracker.get(reinterpret_cast<void *>(0x20800)));
+    EXPECT_EQ(&first, this->tracker.get(reinterpret_cast<void *>(0x10800)));
+    EXPECT_EQ(&second, this->tracker.get(reinterpret_cast<void *>(0x30000)));
+
+    this->tracker.remove(first);
+    this->tracker.remove(second);
+    EXPECT_EQ(0u, this->tracker.getNumAllocs());
+    EXPECT_EQ(nullptr, this->tracker.get(reinterpret_cast<void *>(0x30000)));
+}
+
+struct MockSortedArrayAllocationTracker : SVMAllocsManager::SortedArrayAllocationTracker {
+    using SortedArrayAllocationTracker::getReaderSlotIndex;
+    using SortedArrayAllocationTracker::readerSlotCount;
+};
+
+TEST(SortedArrayAllocationTrackerTest, givenTwoThreadsWhenLookingUpAllocationsThenTheyAnnounceThemselvesInDifferentReaderSlots) {
+    auto mainThreadSlot = MockSortedArrayAllocationTracker::getReaderSlotIndex();
+    EXPECT_EQ(mainThreadSlot, MockSortedArrayAllocationTracker::getReaderSlotIndex());
+    EXPECT_LT(mainThreadSlot, MockSortedArrayAllocationTracker::readerSlotCount);
+
+    auto otherThreadSlot = std::async(std::launch::async, []() {
+                               return MockSortedArrayAllocationTracker::getReaderSlotIndex();
+                           })
+                               .get();
+    EXPECT_NE(mainThreadSlot, otherThreadSlot);
+}
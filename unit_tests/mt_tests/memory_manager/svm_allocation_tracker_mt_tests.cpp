@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/memory_manager/graphics_allocation.h"
+#include "runtime/memory_manager/os_agnostic_memory_manager.h"
+#include "runtime/memory_manager/svm_memory_manager.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace OCLRT;
+
+// map based tracker is not thread safe on its own, guard it the way SVMAllocsManager used to
+struct LockedMapBasedAllocationTracker {
+    void insert(GraphicsAllocation &ga) {
+        std::lock_guard<std::mutex> lock(mtx);
+        tracker.insert(ga);
+    }
+    void remove(GraphicsAllocation &ga) {
+        std::lock_guard<std::mutex> lock(mtx);
+        tracker.remove(ga);
+    }
+    GraphicsAllocation *get(const void *ptr) {
+        std::lock_guard<std::mutex> lock(mtx);
+        return tracker.get(ptr);
+    }
+
+    SVMAllocsManager::MapBasedAllocationTracker tracker;
+    std::mutex mtx;
+};
+
+struct LockedSortedArrayAllocationTracker {
+    void insert(GraphicsAllocation &ga) {
+        std::lock_guard<std::mutex> lock(mtx);
+        tracker.insert(ga);
+    }
+    void remove(GraphicsAllocation &ga) {
+        std::lock_guard<std::mutex> lock(mtx);
+        tracker.remove(ga);
+    }
+    GraphicsAllocation *get(const void *ptr) {
+        return tracker.get(ptr);
+    }
+
+    SVMAllocsManager::SortedArrayAllocationTracker tracker;
+    std::mutex mtx;
+};
+
+template <typename TrackerType>
+struct SVMAllocationTrackerMtTest : public ::testing::Test {
+    static const int readerThreadCount = 4;
+    static const int churnIterations = 2000;
+    static const size_t allocationSize = 0x1000;
+
+    static void *getAddress(size_t index) {
+        return reinterpret_cast<void *>(0x100000 + index * 2 * allocationSize);
+    }
+
+    // stable allocations sit at even slots, churned ones at odd slots in between
+    static void readerMethod(TrackerType *tracker, std::vector<std::unique_ptr<GraphicsAllocation>> *stable, std::vector<std::unique_ptr<GraphicsAllocation>> *churned,
+                             std::atomic<bool> *stop, std::atomic<int> *mismatches) {
+        while (!*stop) {
+            for (size_t i = 0; i < stable->size(); i++) {
+                auto ptr = reinterpret_cast<char *>((*stable)[i]->getUnderlyingBuffer()) + allocationSize / 2;
+                if (tracker->get(ptr) != (*stable)[i].get()) {
+                    (*mismatches)++;
+                }
+                // churned slot is either not tracked at the moment or found as itself
+                auto gapPtr = reinterpret_cast<char *>((*churned)[i]->getUnderlyingBuffer()) + allocationSize / 2;
+                auto found = tracker->get(gapPtr);
+                if (found != nullptr && found != (*churned)[i].get()) {
+                    (*mismatches)++;
+                }
+            }
+        }
+    }
+
+    void run() {
+        const size_t slotCount = 64;
+        std::vector<std::unique_ptr<GraphicsAllocation>> stable;
+        std::vector<std::unique_ptr<GraphicsAllocation>> churned;
+        for (size_t i = 0; i < slotCount; i++) {
+            stable.emplace_back(new GraphicsAllocation(getAddress(i), allocationSize));
+            churned.emplace_back(new GraphicsAllocation(reinterpret_cast<char *>(getAddress(i)) + allocationSize, allocationSize));
+            tracker.insert(*stable.back());
+        }
+
+        std::atomic<bool> stop(false);
+        std::atomic<int> mismatches(0);
+        std::vector<std::thread> readers;
+        for (int i = 0; i < readerThreadCount; i++) {
+            readers.push_back(std::thread(readerMethod, &tracker, &stable, &churned, &stop, &mismatches));
+        }
+
+        for (int i = 0; i < churnIterations; i++) {
+            auto &allocation = *churned[i % slotCount];
+            tracker.insert(allocation);
+            tracker.remove(allocation);
+        }
+        stop = true;
+        for (auto &reader : readers) {
+            reader.join();
+        }
+
+        EXPECT_EQ(0, mismatches);
+        for (auto &allocation : stable) {
+            tracker.remove(*allocation);
+        }
+    }
+
+    TrackerType tracker;
+};
+
+typedef ::testing::Types<LockedMapBasedAllocationTracker, LockedSortedArrayAllocationTracker> SVMAllocationTrackerMtTypes;
+TYPED_TEST_CASE(SVMAllocationTrackerMtTest, SVMAllocationTrackerMtTypes);
+
+TYPED_TEST(SVMAllocationTrackerMtTest, givenConcurrentLookupsWhenOtherAllocationsAreInsertedAndRemovedThenLookupsReturnContainingAllocation) {
+    this->run();
+}
+
+TEST(SVMAllocsManagerMtTest, givenManyThreadsCreatingLookingUpAndFreeingSvmAllocationsThenEachThreadFindsItsOwnAllocations) {
+    OsAgnosticMemoryManager memoryManager;
+    SVMAllocsManager svmManager(&memoryManager);
+    std::atomic<int> mismatches(0);
+
+    auto threadMethod = [&svmManager, &mismatches]() {
+        for (int i = 0; i < 200; i++) {
+            auto ptr = svmManager.createSVMAlloc(4096);
+            auto allocation = svmManager.getSVMAlloc(reinterpret_cast<char *>(ptr) + 100);
+            if (allocation == nullptr || allocation->getUnderlyingBuffer() != ptr) {
+                mismatches++;
+            }
+            svmManager.freeSVMAlloc(ptr);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++) {
+        threads.push_back(std::thread(threadMethod));
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(0, mismatches);
+    EXPECT_EQ(0u, svmManager.getNumAllocs());
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/os_interface/os_time_correlation.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace OCLRT;
+
+TEST(CpuGpuTimeCorrelationMtTest, givenConcurrentQueriesAndCalibrationsWhenUsingSharedModelThenEachThreadSeesMonotonicTime) {
+    static const int threadCount = 8;
+    static const int iterationCount = 2000;
+    CpuGpuTimeCorrelation timeCorrelation;
+    std::atomic<uint64_t> clock(0);
+    std::atomic<bool> start(false);
+    std::atomic<int> stepsBack(0);
+
+    auto threadMethod = [&]() {
+        while (!start)
+            ;
+        uint64_t lastReported = 0;
+        for (int i = 0; i < iterationCount; i++) {
+            auto cpuTime = clock.fetch_add(CpuGpuTimeCorrelation::minSlopeWindowInNs / 4);
+            TimeStampData timeStamp = {0, 0};
+            if (!timeCorrelation.estimateGpuTime(cpuTime, &timeStamp)) {
+                timeStamp = timeCorrelation.calibrate({cpuTime / 80, cpuTime});
+            }
+            if (timeStamp.GPUTimeStamp < lastReported) {
+                stepsBack++;
+            }
+            lastReported = timeStamp.GPUTimeStamp;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadCount; i++) {
+        threads.push_back(std::thread(threadMethod));
+    }
+    start = true;
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(0, stepsBack);
+    EXPECT_TRUE(timeCorrelation.isCalibrated());
+}
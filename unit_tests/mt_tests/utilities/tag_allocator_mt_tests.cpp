@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/memory_manager/os_agnostic_memory_manager.h"
+#include "runtime/utilities/tag_allocator.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace OCLRT;
+
+struct MtTimeStamps {
+    uint64_t start;
+    uint64_t end;
+};
+
+struct TagAllocatorMtTest : public ::testing::Test {
+    using AllocatorType = TagAllocator<MtTimeStamps>;
+    using NodeType = AllocatorType::NodeType;
+
+    static const int threadCount = 8;
+    static const int iterationCount = 2000;
+    static const int tagsHeldPerThread = 4;
+
+    static void threadMethod(AllocatorType *allocator, std::atomic<bool> *start, std::atomic<uint32_t> *owners, std::atomic<int> *doubleHandouts, std::atomic<int> *misses) {
+        while (!*start)
+            ;
+        NodeType *held[tagsHeldPerThread] = {};
+        for (int i = 0; i < iterationCount; i++) {
+            for (auto &node : held) {
+                // the pool holds a tag for every thread's maximum, so a free tag always exists somewhere
+                while ((node = allocator->getTag()) == nullptr) {
+                    (*misses)++;
+                }
+                // every tag carries its owner count in its memory, more than one owner means it was handed out twice
+                auto index = reinterpret_cast<MtTimeStamps *>(node->tag)->start;
+                if (owners[index].fetch_add(1) != 0) {
+                    (*doubleHandouts)++;
+                }
+            }
+            for (auto &node : held) {
+                owners[reinterpret_cast<MtTimeStamps *>(node->tag)->start].fetch_sub(1);
+                allocator->returnTag(node);
+            }
+        }
+    }
+};
+
+TEST_F(TagAllocatorMtTest, givenManyThreadsGettingAndReturningTagsThenNoTagIsHandedOutTwice) {
+    OsAgnosticMemoryManager memoryManager;
+    AllocatorType allocator(&memoryManager, threadCount * tagsHeldPerThread, sizeof(MtTimeStamps), 1);
+
+    // single pool, index all of its tags to track their owners
+    std::vector<NodeType *> nodes;
+    while (auto node = allocator.getTag()) {
+        node->tag->start = nodes.size();
+        nodes.push_back(node);
+    }
+    ASSERT_GE(nodes.size(), static_cast<size_t>(threadCount * tagsHeldPerThread));
+    for (auto node : nodes) {
+        allocator.returnTag(node);
+    }
+
+    std::atomic<bool> start(false);
+    std::unique_ptr<std::atomic<uint32_t>[]> owners(new std::atomic<uint32_t>[nodes.size()]);
+    for (size_t i = 0; i < nodes.size(); i++) {
+        owners[i] = 0;
+    }
+    std::atomic<int> doubleHandouts(0);
+    std::atomic<int> misses(0);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadCount; i++) {
+        threads.push_back(std::thread(threadMethod, &allocator, &start, owners.get(), &doubleHandouts, &misses));
+    }
+    start = true;
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(0, doubleHandouts);
+    EXPECT_EQ(0, misses);
+    EXPECT_EQ(0u, allocator.peekUsedTagCount());
+}
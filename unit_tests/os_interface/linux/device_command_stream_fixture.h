@@ -31,6 +31,7 @@
 #include "unit_tests/helpers/gtest_helpers.h"
 #include <atomic>
 #include <iostream>
+#include <vector>
 
 #define RENDER_DEVICE_NAME_MATCHER ::testing::StrEq("/dev/dri/renderD128")
 
@@ -90,6 +91,7 @@ class DrmMockCustom : public Drm {
             gemUserptr = 0;
             gemCreate = 0;
             gemSetTiling = 0;
+            gemSetCaching = 0;
             primeFdToHandle = 0;
             gemGetAperture = 0;
             gemMmap = 0;
@@ -104,6 +106,7 @@ class DrmMockCustom : public Drm {
         std::atomic<int32_t> gemUserptr;
         std::atomic<int32_t> gemCreate;
         std::atomic<int32_t> gemSetTiling;
+        std::atomic<int32_t> gemSetCaching;
         std::atomic<int32_t> primeFdToHandle;
         std::atomic<int32_t> gemGetAperture;
         std::atomic<int32_t> gemMmap;
@@ -130,6 +133,7 @@ class DrmMockCustom : public Drm {
         NEO_IOCTL_EXPECT_EQ(gemUserptr);
         NEO_IOCTL_EXPECT_EQ(gemCreate);
         NEO_IOCTL_EXPECT_EQ(gemSetTiling);
+        NEO_IOCTL_EXPECT_EQ(gemSetCaching);
         NEO_IOCTL_EXPECT_EQ(primeFdToHandle);
         NEO_IOCTL_EXPECT_EQ(gemGetAperture);
         NEO_IOCTL_EXPECT_EQ(gemMmap);
@@ -150,6 +154,9 @@ class DrmMockCustom : public Drm {
     __u32 setTilingMode = 0;
     __u32 setTilingHandle = 0;
     __u32 setTilingStride = 0;
+    //DRM_IOCTL_I915_GEM_SET_CACHING
+    __u32 setCachingHandle = 0;
+    __u32 setCachingMode = 0;
     //DRM_IOCTL_PRIME_FD_TO_HANDLE
     __u32 outputHandle = 0;
     __s32 inputFd = 0;
@@ -168,6 +175,23 @@ class DrmMockCustom : public Drm {
     __u32 setDomainReadDomains = 0;
     __u32 setDomainWriteDomain = 0;
 
+    //DRM_IOCTL_I915_GEM_EXECBUFFER2_WR with I915_EXEC_FENCE_OUT, stand-in sync file fds
+    int nextOutFenceFd = 100;
+    bool outFencesSignaled = true;
+    std::atomic<int32_t> outFenceWaits{0};
+    std::vector<int> closedOutFences;
+
+    void setExecFenceSupported(bool supported) { execFenceSupported = supported; }
+
+    bool waitOutFence(int fenceFd, int timeoutMs) override {
+        outFenceWaits++;
+        return outFencesSignaled || timeoutMs != 0;
+    }
+
+    void closeOutFence(int fenceFd) override {
+        closedOutFences.push_back(fenceFd);
+    }
+
     int errnoValue = 0;
 
     int ioctl(unsigned long request, void *arg) override {
@@ -180,6 +204,14 @@ class DrmMockCustom : public Drm {
             this->execBuffer = *execbuf;
             ioctl_cnt.execbuffer2++;
         } break;
+        case DRM_IOCTL_I915_GEM_EXECBUFFER2_WR: {
+            drm_i915_gem_execbuffer2 *execbuf = (drm_i915_gem_execbuffer2 *)arg;
+            if (execbuf->flags & I915_EXEC_FENCE_OUT) {
+                execbuf->rsvd2 = static_cast<__u64>(nextOutFenceFd++) << 32;
+            }
+            this->execBuffer = *execbuf;
+            ioctl_cnt.execbuffer2++;
+        } break;
 
         case DRM_IOCTL_I915_GEM_USERPTR: {
             auto *userPtrParams = (drm_i915_gem_userptr *)arg;
@@ -201,6 +233,12 @@ class DrmMockCustom : public Drm {
             setTilingStride = setTilingParams->stride;
             ioctl_cnt.gemSetTiling++;
         } break;
+        case DRM_IOCTL_I915_GEM_SET_CACHING: {
+            auto *setCachingParams = (drm_i915_gem_caching *)arg;
+            setCachingHandle = setCachingParams->handle;
+            setCachingMode = setCachingParams->caching;
+            ioctl_cnt.gemSetCaching++;
+        } break;
         case DRM_IOCTL_PRIME_FD_TO_HANDLE: {
             auto *primeToHandleParams = (drm_prime_handle *)arg;
             //return BO
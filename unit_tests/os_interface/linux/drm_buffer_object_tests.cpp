@@ -110,6 +110,44 @@ TEST_F(DrmBufferObjectTest, givenDrmWithCoherencyPatchActiveWhenExecIsCalledWith
     EXPECT_EQ(expectedFlag, currentFlag);
 }
 
+TEST_F(DrmBufferObjectTest, givenDrmContextIdWhenExecIsCalledThenContextIdIsPassedToExecBuffer) {
+    mock->ioctl_expected.total = 1;
+    mock->ioctl_res = 0;
+
+    auto ret = bo->exec(0, 0, 0, false, 4u);
+    EXPECT_EQ(mock->ioctl_res, ret);
+    EXPECT_EQ(4u, mock->execBuffer.rsvd1);
+
+    mock->ioctl_expected.total = 2;
+    bo->exec(0, 0, 0);
+    EXPECT_EQ(0u, mock->execBuffer.rsvd1);
+}
+
+TEST_F(DrmBufferObjectTest, givenOutFenceRequestWhenExecIsCalledThenFenceOutFlagIsSetAndSyncFileFdIsReturned) {
+    mock->ioctl_expected.total = 1;
+    mock->ioctl_res = 0;
+
+    int outFenceFd = -1;
+    auto ret = bo->exec(0, 0, 0, false, 0u, &outFenceFd);
+    EXPECT_EQ(mock->ioctl_res, ret);
+    EXPECT_NE(0u, mock->execBuffer.flags & I915_EXEC_FENCE_OUT);
+    EXPECT_EQ(mock->nextOutFenceFd - 1, outFenceFd);
+}
+
+TEST_F(DrmBufferObjectTest, givenOutFenceRequestRejectedByKernelWhenExecIsCalledThenPlainExecBufferIsSubmittedWithoutFence) {
+    mock->ioctl_expected.total = 2;
+    mock->ioctl_res = 0;
+    DrmMockCustom::IoctlResExt ioctlResExt = {0, -1};
+    mock->ioctl_res_ext = &ioctlResExt;
+
+    int outFenceFd = 5;
+    auto ret = bo->exec(0, 0, 0, false, 0u, &outFenceFd);
+    EXPECT_EQ(0, ret);
+    EXPECT_EQ(0u, mock->execBuffer.flags & I915_EXEC_FENCE_OUT);
+    EXPECT_EQ(-1, outFenceFd);
+    mock->ioctl_res_ext = &mock->NONE;
+}
+
 TEST_F(DrmBufferObjectTest, exec_ioctlFailed) {
     mock->ioctl_expected.total = 1;
     mock->ioctl_res = -1;
@@ -251,6 +251,44 @@ TEST_F(DrmCommandStreamTest, FlushWithLowPriorityContext) {
     EXPECT_EQ(cs.getGraphicsAllocation(), nullptr);
 }
 
+#if defined(I915_PARAM_HAS_PREEMPTION)
+MATCHER_P(BoExecContextEq, contextId, "") {
+    drm_i915_gem_execbuffer2 *exec2 = (drm_i915_gem_execbuffer2 *)arg;
+
+    return exec2->rsvd1 == contextId;
+}
+
+TEST_F(DrmCommandStreamTest, givenLowThrottleBatchBufferWhenFlushedThenDefaultContextIsUsedWithoutCreatingNewOne) {
+    ::testing::InSequence inSequence;
+
+    EXPECT_CALL(*mock, ioctl(DRM_IOCTL_I915_GEM_USERPTR, ::testing::_))
+        .Times(1)
+        .WillRepeatedly(::testing::Return(0))
+        .RetiresOnSaturation();
+    EXPECT_CALL(*mock, ioctl(DRM_IOCTL_I915_GEM_CONTEXT_CREATE, ::testing::_))
+        .Times(0);
+    EXPECT_CALL(*mock, ioctl(DRM_IOCTL_I915_GEM_EXECBUFFER2, BoExecContextEq(0u)))
+        .Times(1)
+        .WillRepeatedly(::testing::Return(0))
+        .RetiresOnSaturation();
+    EXPECT_CALL(*mock, ioctl(DRM_IOCTL_I915_GEM_WAIT, ::testing::_))
+        .Times(1)
+        .RetiresOnSaturation();
+    EXPECT_CALL(*mock, ioctl(DRM_IOCTL_GEM_CLOSE, ::testing::_))
+        .Times(1)
+        .RetiresOnSaturation();
+
+    auto *commandBuffer = mm->allocateGraphicsMemory(1024, 4096);
+    ASSERT_NE(nullptr, commandBuffer);
+    LinearStream cs(commandBuffer);
+
+    csr->addBatchBufferEnd(cs, nullptr);
+    csr->alignToCacheLine(cs);
+    BatchBuffer batchBuffer{cs.getGraphicsAllocation(), 0, 0, nullptr, false, false, QueueThrottle::LOW, cs.getUsed(), &cs};
+    csr->flush(batchBuffer, EngineType::ENGINE_RCS, nullptr);
+}
+#endif
+
 TEST_F(DrmCommandStreamTest, FlushInvalidAddress) {
     ::testing::InSequence inSequence;
 
@@ -802,6 +840,12 @@ class DrmCommandStreamEnhancedFixture : public MemoryManagementFixture
         std::vector<drm_i915_gem_exec_object2> &getExecStorage() {
             return this->execObjectsStorage;
         }
+        void enableOutFence() {
+            this->outFenceEnabled = true;
+        }
+        size_t peekOutFenceCount() {
+            return this->outFences.size();
+        }
     };
     TestedDrmCommandStreamReceiver<DEFAULT_TEST_FAMILY_NAME> *tCsr = nullptr;
 
@@ -940,6 +984,136 @@ TEST_F(DrmCommandStreamGemWorkerTests, givenDrmCsrCreatedWithInactiveGemCloseWor
     EXPECT_EQ(gemCloseWorkerMode::gemCloseWorkerInactive, testedCsr.peekGemCloseWorkerOperationMode());
 }
 
+typedef Test<DrmCommandStreamEnhancedFixture> DrmCommandStreamOutFenceTests;
+
+TEST_F(DrmCommandStreamOutFenceTests, givenDebugFlagKernelSupportAndKmdNotifyWhenCsrIsCreatedThenOutFenceIsEnabledOnlyWhenAllAreSet) {
+    EXPECT_FALSE(tCsr->isOutFenceEnabled());
+
+    HardwareInfo hwInfo = *platformDevices[0];
+    hwInfo.capabilityTable.enableKmdNotify = true;
+
+    DebugManager.flags.EnableExecOutFence.set(true);
+    std::unique_ptr<DrmCommandStreamReceiver<DEFAULT_TEST_FAMILY_NAME>> unsupportedCsr(new DrmCommandStreamReceiver<DEFAULT_TEST_FAMILY_NAME>(hwInfo, mock));
+    EXPECT_FALSE(unsupportedCsr->isOutFenceEnabled());
+
+    mock->setExecFenceSupported(true);
+    std::unique_ptr<DrmCommandStreamReceiver<DEFAULT_TEST_FAMILY_NAME>> supportedCsr(new DrmCommandStreamReceiver<DEFAULT_TEST_FAMILY_NAME>(hwInfo, mock));
+    EXPECT_TRUE(supportedCsr->isOutFenceEnabled());
+
+    // without KMD notify waits never sleep on the flush stamp
+    hwInfo.capabilityTable.enableKmdNotify = false;
+    std::unique_ptr<DrmCommandStreamReceiver<DEFAULT_TEST_FAMILY_NAME>> pollingCsr(new DrmCommandStreamReceiver<DEFAULT_TEST_FAMILY_NAME>(hwInfo, mock));
+    EXPECT_FALSE(pollingCsr->isOutFenceEnabled());
+}
+
+TEST_F(DrmCommandStreamOutFenceTests, givenOutFenceEnabledWhenFlushedThenFenceIsRequestedAndWaitPollsItInsteadOfGemWait) {
+    tCsr->overrideGemCloseWorkerOperationMode(gemCloseWorkerMode::gemCloseWorkerInactive);
+    tCsr->enableOutFence();
+
+    auto commandBuffer = mm->allocateGraphicsMemory(1024, 4096);
+    ASSERT_NE(nullptr, commandBuffer);
+    LinearStream cs(commandBuffer);
+    csr->addBatchBufferEnd(cs, nullptr);
+    csr->alignToCacheLine(cs);
+
+    BatchBuffer batchBuffer{cs.getGraphicsAllocation(), 0, 0, nullptr, false, false, QueueThrottle::MEDIUM, cs.getUsed(), &cs};
+    auto flushStamp = csr->flush(batchBuffer, EngineType::ENGINE_RCS, nullptr);
+
+    EXPECT_NE(0u, mock->execBuffer.flags & I915_EXEC_FENCE_OUT);
+    EXPECT_TRUE(DrmCommandStreamReceiver<DEFAULT_TEST_FAMILY_NAME>::isOutFenceFlushStamp(flushStamp));
+    EXPECT_EQ(1u, tCsr->peekOutFenceCount());
+
+    auto gemWaitsBefore = mock->ioctl_cnt.gemWait.load();
+    EXPECT_TRUE(csr->waitForFlushStamp(flushStamp));
+    EXPECT_EQ(1, mock->outFenceWaits.load());
+    EXPECT_EQ(gemWaitsBefore, mock->ioctl_cnt.gemWait.load());
+
+    mm->freeGraphicsMemory(commandBuffer);
+}
+
+TEST_F(DrmCommandStreamOutFenceTests, givenPendingOutFencesWhenTheySignalThenNextFlushClosesThemAndWaitReturnsWithoutPolling) {
+    tCsr->overrideGemCloseWorkerOperationMode(gemCloseWorkerMode::gemCloseWorkerInactive);
+    tCsr->enableOutFence();
+
+    auto commandBuffer = mm->allocateGraphicsMemory(1024, 4096);
+    ASSERT_NE(nullptr, commandBuffer);
+    LinearStream cs(commandBuffer);
+    csr->addBatchBufferEnd(cs, nullptr);
+    csr->alignToCacheLine(cs);
+    BatchBuffer batchBuffer{cs.getGraphicsAllocation(), 0, 0, nullptr, false, false, QueueThrottle::MEDIUM, cs.getUsed(), &cs};
+
+    mock->outFencesSignaled = false;
+    auto firstFlushStamp = csr->flush(batchBuffer, EngineType::ENGINE_RCS, nullptr);
+    auto secondFlushStamp = csr->flush(batchBuffer, EngineType::ENGINE_RCS, nullptr);
+    EXPECT_NE(firstFlushStamp, secondFlushStamp);
+    EXPECT_EQ(2u, tCsr->peekOutFenceCount());
+    EXPECT_EQ(0u, mock->closedOutFences.size());
+
+    mock->outFencesSignaled = true;
+    csr->flush(batchBuffer, EngineType::ENGINE_RCS, nullptr);
+    EXPECT_EQ(1u, tCsr->peekOutFenceCount());
+    ASSERT_EQ(2u, mock->closedOutFences.size());
+    EXPECT_EQ(100, mock->closedOutFences[0]);
+    EXPECT_EQ(101, mock->closedOutFences[1]);
+
+    auto waitsBefore = mock->outFenceWaits.load();
+    EXPECT_TRUE(csr->waitForFlushStamp(firstFlushStamp));
+    EXPECT_EQ(waitsBefore, mock->outFenceWaits.load());
+
+    mm->freeGraphicsMemory(commandBuffer);
+}
+
+TEST_F(DrmCommandStreamOutFenceTests, givenPendingOutFencesWhenWaitForFlushStampReturnsThenSignaledFencesAreClosedWithoutNextFlush) {
+    tCsr->overrideGemCloseWorkerOperationMode(gemCloseWorkerMode::gemCloseWorkerInactive);
+    tCsr->enableOutFence();
+
+    auto commandBuffer = mm->allocateGraphicsMemory(1024, 4096);
+    ASSERT_NE(nullptr, commandBuffer);
+    LinearStream cs(commandBuffer);
+    csr->addBatchBufferEnd(cs, nullptr);
+    csr->alignToCacheLine(cs);
+    BatchBuffer batchBuffer{cs.getGraphicsAllocation(), 0, 0, nullptr, false, false, QueueThrottle::MEDIUM, cs.getUsed(), &cs};
+
+    mock->outFencesSignaled = false;
+    csr->flush(batchBuffer, EngineType::ENGINE_RCS, nullptr);
+    auto lastFlushStamp = csr->flush(batchBuffer, EngineType::ENGINE_RCS, nullptr);
+    EXPECT_EQ(2u, tCsr->peekOutFenceCount());
+
+    mock->outFencesSignaled = true;
+    EXPECT_TRUE(csr->waitForFlushStamp(lastFlushStamp));
+    EXPECT_EQ(0u, tCsr->peekOutFenceCount());
+    EXPECT_EQ(2u, mock->closedOutFences.size());
+
+    mm->freeGraphicsMemory(commandBuffer);
+}
+
+TEST_F(DrmCommandStreamOutFenceTests, givenMaxOutstandingOutFencesWhenFlushedThenNoFenceIsRequestedAndBatchBufferHandleIsReturned) {
+    typedef DrmCommandStreamReceiver<DEFAULT_TEST_FAMILY_NAME> DrmCsr;
+    tCsr->overrideGemCloseWorkerOperationMode(gemCloseWorkerMode::gemCloseWorkerInactive);
+    tCsr->enableOutFence();
+
+    auto commandBuffer = mm->allocateGraphicsMemory(1024, 4096);
+    ASSERT_NE(nullptr, commandBuffer);
+    LinearStream cs(commandBuffer);
+    csr->addBatchBufferEnd(cs, nullptr);
+    csr->alignToCacheLine(cs);
+    BatchBuffer batchBuffer{cs.getGraphicsAllocation(), 0, 0, nullptr, false, false, QueueThrottle::MEDIUM, cs.getUsed(), &cs};
+
+    mock->outFencesSignaled = false;
+    size_t maxOutFences = DrmCsr::maxOutstandingOutFences;
+    for (size_t i = 0; i < maxOutFences; i++) {
+        EXPECT_TRUE(DrmCsr::isOutFenceFlushStamp(csr->flush(batchBuffer, EngineType::ENGINE_RCS, nullptr)));
+    }
+    EXPECT_EQ(maxOutFences, tCsr->peekOutFenceCount());
+
+    auto flushStamp = csr->flush(batchBuffer, EngineType::ENGINE_RCS, nullptr);
+    EXPECT_FALSE(DrmCsr::isOutFenceFlushStamp(flushStamp));
+    EXPECT_EQ(0u, mock->execBuffer.flags & I915_EXEC_FENCE_OUT);
+    EXPECT_EQ(maxOutFences, tCsr->peekOutFenceCount());
+
+    mm->freeGraphicsMemory(commandBuffer);
+}
+
 typedef Test<DrmCommandStreamEnhancedFixture> DrmCommandStreamBatchingTests;
 
 TEST_F(DrmCommandStreamBatchingTests, givenCSRWhenFlushIsCalledThenProperFlagsArePassed) {
@@ -72,6 +72,14 @@ int munmapMock(void *addr, size_t length) noexcept {
     return 0;
 }
 
+static int madviseMockReturn = 0;
+static int madviseMockCallCount = 0;
+
+int madviseMock(void *addr, size_t length, int advice) noexcept {
+    madviseMockCallCount++;
+    return madviseMockReturn;
+}
+
 int closeMock(int) {
     return 0;
 }
@@ -81,25 +89,31 @@ class TestedDrmMemoryManager : public DrmMemoryManager {
     using DrmMemoryManager::allocUserptr;
     using DrmMemoryManager::setDomainCpu;
 
-    TestedDrmMemoryManager(Drm *drm) : DrmMemoryManager(drm, gemCloseWorkerMode::gemCloseWorkerConsumingCommandBuffers, false, false) {
+    TestedDrmMemoryManager(Drm *drm) : DrmMemoryManager(drm, gemCloseWorkerMode::gemCloseWorkerConsumingCommandBuffers, false, false, false) {
         this->lseekFunction = &lseekMock;
         this->mmapFunction = &mmapMock;
         this->munmapFunction = &munmapMock;
+        this->madviseFunction = &madviseMock;
         this->closeFunction = &closeMock;
         lseekReturn = 4096;
         lseekCalledCount = 0;
         mmapMockCallCount = 0;
         munmapMockCallCount = 0;
+        madviseMockReturn = 0;
+        madviseMockCallCount = 0;
     };
-    TestedDrmMemoryManager(Drm *drm, bool allowForcePin, bool validateHostPtrMemory) : DrmMemoryManager(drm, gemCloseWorkerMode::gemCloseWorkerConsumingCommandBuffers, allowForcePin, validateHostPtrMemory) {
+    TestedDrmMemoryManager(Drm *drm, bool allowForcePin, bool validateHostPtrMemory) : DrmMemoryManager(drm, gemCloseWorkerMode::gemCloseWorkerConsumingCommandBuffers, allowForcePin, validateHostPtrMemory, false) {
         this->lseekFunction = &lseekMock;
         this->mmapFunction = &mmapMock;
         this->munmapFunction = &munmapMock;
+        this->madviseFunction = &madviseMock;
         this->closeFunction = &closeMock;
         lseekReturn = 4096;
         lseekCalledCount = 0;
         mmapMockCallCount = 0;
         munmapMockCallCount = 0;
+        madviseMockReturn = 0;
+        madviseMockCallCount = 0;
     }
 
     void unreference(BufferObject *bo) {
@@ -217,6 +231,44 @@ TEST_F(DrmMemoryManagerTest, pinAfterAllocateWhenAskedAndAllowedAndBigAllocation
     delete mm;
 }
 
+TEST_F(DrmMemoryManagerTest, givenPinBBWhenAllocationsArePrefetchedThenTheirBOsArePinnedWithSingleExec) {
+    mock->ioctl_expected.gemUserptr = 3;
+    mock->ioctl_expected.execbuffer2 = 1;
+    mock->ioctl_expected.gemWait = 2;
+    mock->ioctl_expected.gemClose = 3;
+
+    std::unique_ptr<TestedDrmMemoryManager> mm(new (std::nothrow) TestedDrmMemoryManager(this->mock, true, false));
+    ASSERT_NE(nullptr, mm->getPinBB());
+
+    auto alloc1 = mm->allocateGraphicsMemory(MemoryConstants::pageSize, MemoryConstants::pageSize);
+    auto alloc2 = mm->allocateGraphicsMemory(MemoryConstants::pageSize, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, alloc1);
+    ASSERT_NE(nullptr, alloc2);
+
+    ResidencyContainer allocations = {alloc1, alloc2};
+    mm->prefetchAllocations(allocations);
+
+    mm->freeGraphicsMemory(alloc1);
+    mm->freeGraphicsMemory(alloc2);
+}
+
+TEST_F(DrmMemoryManagerTest, givenNoPinBBWhenAllocationsArePrefetchedThenNothingIsSubmitted) {
+    mock->ioctl_expected.gemUserptr = 1;
+    mock->ioctl_expected.gemWait = 1;
+    mock->ioctl_expected.gemClose = 1;
+
+    std::unique_ptr<TestedDrmMemoryManager> mm(new (std::nothrow) TestedDrmMemoryManager(this->mock, false, false));
+    ASSERT_EQ(nullptr, mm->getPinBB());
+
+    auto alloc = mm->allocateGraphicsMemory(MemoryConstants::pageSize, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, alloc);
+
+    ResidencyContainer allocations = {alloc};
+    mm->prefetchAllocations(allocations);
+
+    mm->freeGraphicsMemory(alloc);
+}
+
 TEST_F(DrmMemoryManagerTest, doNotPinAfterAllocateWhenAskedAndAllowedButSmallAllocation) {
     mock->ioctl_expected.gemUserptr = 2;
     mock->ioctl_expected.gemWait = 1;
@@ -365,7 +417,7 @@ TEST_F(DrmMemoryManagerTest, UnreferenceNullPtr) {
 TEST_F(DrmMemoryManagerWithExplicitExpectationsTest, givenDrmMemoryManagerCreatedWithGemCloseWorkerModeInactiveThenGemCloseWorkerIsNotCreated) {
     class MyTestedDrmMemoryManager : public DrmMemoryManager {
       public:
-        MyTestedDrmMemoryManager(Drm *drm, gemCloseWorkerMode mode) : DrmMemoryManager(drm, mode, false, false) {}
+        MyTestedDrmMemoryManager(Drm *drm, gemCloseWorkerMode mode) : DrmMemoryManager(drm, mode, false, false, false) {}
         DrmGemCloseWorker *getgemCloseWorker() { return this->gemCloseWorker.get(); }
     };
 
@@ -679,9 +731,163 @@ TEST_F(DrmMemoryManagerTest, GivenPointerAndSizeWhenAskedToCreateGrahicsAllocati
     delete allocation;
 }
 
-TEST_F(DrmMemoryManagerTest, GivenPointerAndSizeWhenAskedToCreateGrahicsAllocation64kThenNullPtr) {
-    auto allocation = memoryManager->allocateGraphicsMemory64kb(65536, 65536, false);
-    EXPECT_EQ(nullptr, allocation);
+TEST_F(DrmMemoryManagerTest, givenSizeWhenAskedToCreateGraphicsAllocation64kbThenAllocationIs64kbAlignedAndBackedByUserptr) {
+    mock->ioctl_expected.gemUserptr = 1;
+    mock->ioctl_expected.gemWait = 1;
+    mock->ioctl_expected.gemClose = 1;
+
+    auto allocation = memoryManager->allocateGraphicsMemory64kb(65537, MemoryConstants::pageSize64k, false);
+    ASSERT_NE(nullptr, allocation);
+    EXPECT_NE(nullptr, allocation->getBO());
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(allocation->getUnderlyingBuffer()) & MemoryConstants::page64kMask);
+    EXPECT_EQ(2 * MemoryConstants::pageSize64k, allocation->getUnderlyingBufferSize());
+    EXPECT_EQ(allocation->getUnderlyingBuffer(), allocation->getBO()->peekAddress());
+    EXPECT_EQ(0, mmapMockCallCount);
+    EXPECT_EQ(0, madviseMockCallCount);
+
+    memoryManager->freeGraphicsMemory(allocation);
+}
+
+TEST_F(DrmMemoryManagerTest, givenHugePageAllocationsEnabledWhenLarge64kbAllocationIsCreatedThenItIsBackedByHugePageAlignedMapping) {
+    DebugManagerStateRestore dbgRestorer;
+    DebugManager.flags.EnableHugePageAllocations.set(true);
+    mock->ioctl_expected.gemUserptr = 1;
+    mock->ioctl_expected.gemWait = 1;
+    mock->ioctl_expected.gemClose = 1;
+
+    auto size = MemoryConstants::pageSize2Mb + MemoryConstants::pageSize64k;
+    auto allocation = memoryManager->allocateGraphicsMemory64kb(size, MemoryConstants::pageSize64k, false);
+    ASSERT_NE(nullptr, allocation);
+    EXPECT_EQ(reinterpret_cast<void *>(MemoryConstants::pageSize2Mb), allocation->getUnderlyingBuffer());
+    EXPECT_EQ(2 * MemoryConstants::pageSize2Mb, allocation->getUnderlyingBufferSize());
+    EXPECT_EQ(2 * MemoryConstants::pageSize2Mb, allocation->getBO()->peekUnmapSize());
+    EXPECT_EQ(MMAP_ALLOCATOR, allocation->getBO()->peekAllocationType());
+    EXPECT_EQ(1, mmapMockCallCount);
+    EXPECT_EQ(1, madviseMockCallCount);
+    // reservation is trimmed at both ends to huge page boundaries
+    EXPECT_EQ(2, munmapMockCallCount);
+
+    memoryManager->freeGraphicsMemory(allocation);
+    EXPECT_EQ(3, munmapMockCallCount);
+}
+
+TEST_F(DrmMemoryManagerTest, givenHugePageAllocationsEnabledWhenMadviseFailsThen64kbAllocationFallsBackToRegularPages) {
+    DebugManagerStateRestore dbgRestorer;
+    DebugManager.flags.EnableHugePageAllocations.set(true);
+    mock->ioctl_expected.gemUserptr = 1;
+    mock->ioctl_expected.gemWait = 1;
+    mock->ioctl_expected.gemClose = 1;
+    madviseMockReturn = -1;
+
+    auto size = MemoryConstants::pageSize2Mb;
+    auto allocation = memoryManager->allocateGraphicsMemory64kb(size, MemoryConstants::pageSize64k, false);
+    ASSERT_NE(nullptr, allocation);
+    EXPECT_EQ(1, madviseMockCallCount);
+    EXPECT_EQ(0u, allocation->getBO()->peekUnmapSize());
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(allocation->getUnderlyingBuffer()) & MemoryConstants::page64kMask);
+    EXPECT_EQ(size, allocation->getUnderlyingBufferSize());
+    auto munmapCallsAfterFallback = munmapMockCallCount;
+
+    memoryManager->freeGraphicsMemory(allocation);
+    EXPECT_EQ(munmapCallsAfterFallback, munmapMockCallCount);
+}
+
+TEST_F(DrmMemoryManagerTest, givenHugePageAllocationsEnabledWhenSmall64kbAllocationIsCreatedThenHugePagesAreNotUsed) {
+    DebugManagerStateRestore dbgRestorer;
+    DebugManager.flags.EnableHugePageAllocations.set(true);
+    mock->ioctl_expected.gemUserptr = 1;
+    mock->ioctl_expected.gemWait = 1;
+    mock->ioctl_expected.gemClose = 1;
+
+    auto allocation = memoryManager->allocateGraphicsMemory64kb(MemoryConstants::pageSize64k, MemoryConstants::pageSize64k, false);
+    ASSERT_NE(nullptr, allocation);
+    EXPECT_EQ(0, mmapMockCallCount);
+    EXPECT_EQ(0, madviseMockCallCount);
+
+    memoryManager->freeGraphicsMemory(allocation);
+}
+
+TEST_F(DrmMemoryManagerTest, givenGemCreateForInternalAllocationsEnabledWhenDriverInternalAllocationIsCreatedThenItIsBackedByGemCreateAndMmap) {
+    DebugManagerStateRestore dbgRestorer;
+    DebugManager.flags.EnableGemCreateForInternalAllocations.set(true);
+    mock->ioctl_expected.gemUserptr = 0;
+    mock->ioctl_expected.gemCreate = 1;
+    mock->ioctl_expected.gemSetCaching = 1;
+    mock->ioctl_expected.gemMmap = 1;
+    mock->ioctl_expected.gemWait = 1;
+    mock->ioctl_expected.gemClose = 1;
+
+    auto allocation = static_cast<DrmAllocation *>(memoryManager->allocateDriverInternalGraphicsMemory(5000, MemoryConstants::pageSize));
+    ASSERT_NE(nullptr, allocation);
+    EXPECT_EQ(2 * MemoryConstants::pageSize, mock->createParamsSize);
+    EXPECT_EQ(mock->createParamsHandle, mock->setCachingHandle);
+    EXPECT_EQ(static_cast<__u32>(I915_CACHING_CACHED), mock->setCachingMode);
+    EXPECT_EQ(mock->createParamsHandle, mock->mmapHandle);
+    EXPECT_EQ(2 * MemoryConstants::pageSize, mock->mmapSize);
+    EXPECT_EQ(reinterpret_cast<void *>(mock->mmapAddrPtr), allocation->getUnderlyingBuffer());
+    EXPECT_EQ(2 * MemoryConstants::pageSize, allocation->getUnderlyingBufferSize());
+
+    auto bo = allocation->getBO();
+    ASSERT_NE(nullptr, bo);
+    EXPECT_EQ(allocation->getUnderlyingBuffer(), bo->peekAddress());
+    EXPECT_EQ(2 * MemoryConstants::pageSize, bo->peekUnmapSize());
+    EXPECT_EQ(MMAP_ALLOCATOR, bo->peekAllocationType());
+
+    memoryManager->freeGraphicsMemory(allocation);
+    EXPECT_EQ(1, munmapMockCallCount);
+}
+
+TEST_F(DrmMemoryManagerTest, givenGemCreateForInternalAllocationsDisabledWhenDriverInternalAllocationIsCreatedThenUserptrIsUsed) {
+    mock->ioctl_expected.gemUserptr = 1;
+    mock->ioctl_expected.gemCreate = 0;
+    mock->ioctl_expected.gemMmap = 0;
+    mock->ioctl_expected.gemWait = 1;
+    mock->ioctl_expected.gemClose = 1;
+
+    auto allocation = memoryManager->allocateDriverInternalGraphicsMemory(MemoryConstants::pageSize, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, allocation);
+    memoryManager->freeGraphicsMemory(allocation);
+}
+
+TEST_F(DrmMemoryManagerTest, givenGemCreateForInternalAllocationsEnabledWhenGemMmapFailsThenObjectIsClosedAndUserptrIsUsed) {
+    DebugManagerStateRestore dbgRestorer;
+    DebugManager.flags.EnableGemCreateForInternalAllocations.set(true);
+    DrmMockCustom::IoctlResExt ioctlResExt = {2, -1};
+    mock->ioctl_res_ext = &ioctlResExt;
+    mock->ioctl_expected.gemCreate = 1;
+    mock->ioctl_expected.gemSetCaching = 1;
+    mock->ioctl_expected.gemMmap = 1;
+    mock->ioctl_expected.gemUserptr = 1;
+    mock->ioctl_expected.gemWait = 1;
+    mock->ioctl_expected.gemClose = 2;
+
+    auto allocation = memoryManager->allocateDriverInternalGraphicsMemory(MemoryConstants::pageSize, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, allocation);
+    EXPECT_NE(reinterpret_cast<void *>(mock->mmapAddrPtr), allocation->getUnderlyingBuffer());
+    EXPECT_EQ(0, munmapMockCallCount);
+
+    memoryManager->freeGraphicsMemory(allocation);
+    mock->ioctl_res_ext = &mock->NONE;
+}
+
+TEST_F(DrmMemoryManagerTest, givenGemCreateForInternalAllocationsEnabledWhenSetCachingFailsThenObjectIsClosedWithoutMappingAndUserptrIsUsed) {
+    DebugManagerStateRestore dbgRestorer;
+    DebugManager.flags.EnableGemCreateForInternalAllocations.set(true);
+    DrmMockCustom::IoctlResExt ioctlResExt = {1, -1};
+    mock->ioctl_res_ext = &ioctlResExt;
+    mock->ioctl_expected.gemCreate = 1;
+    mock->ioctl_expected.gemSetCaching = 1;
+    mock->ioctl_expected.gemMmap = 0;
+    mock->ioctl_expected.gemUserptr = 1;
+    mock->ioctl_expected.gemWait = 1;
+    mock->ioctl_expected.gemClose = 2;
+
+    auto allocation = memoryManager->allocateDriverInternalGraphicsMemory(MemoryConstants::pageSize, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, allocation);
+    EXPECT_EQ(0, munmapMockCallCount);
+
+    memoryManager->freeGraphicsMemory(allocation);
+    mock->ioctl_res_ext = &mock->NONE;
 }
 
 TEST_F(DrmMemoryManagerTest, GivenMisalignedHostPtrAndMultiplePagesSizeWhenAskedForGraphicsAllcoationThenItContainsAllFragmentsWithProperGpuAdrresses) {
@@ -1170,6 +1376,54 @@ TEST_F(DrmMemoryManagerTest, GivenMemoryManagerWhenAllocateGraphicsMemoryForImag
     EXPECT_EQ(1, munmapMockCallCount);
 }
 
+TEST_F(DrmMemoryManagerTest, givenGpuVirtualAddressHeapEnabledWhenImagesAreAllocatedThenAddressesAreSuballocatedFromSingleReservation) {
+    if (!is64bit) {
+        return;
+    }
+    DebugManagerStateRestore dbgRestorer;
+    DebugManager.flags.EnableGpuVirtualAddressHeap.set(true);
+    mock->ioctl_expected.gemCreate = 2;
+    mock->ioctl_expected.gemSetTiling = 2;
+    mock->ioctl_expected.gemWait = 2;
+    mock->ioctl_expected.gemClose = 2;
+
+    cl_image_desc imgDesc = {};
+    imgDesc.image_type = CL_MEM_OBJECT_IMAGE2D;
+    imgDesc.image_width = 512;
+    imgDesc.image_height = 512;
+    auto imgInfo = MockGmm::initImgInfo(imgDesc, 0, nullptr);
+    imgInfo.imgDesc = &imgDesc;
+    imgInfo.size = 4096u;
+    imgInfo.rowPitch = 512u;
+
+    auto queryGmm = MockGmm::queryImgParams(imgInfo);
+    auto firstImage = memoryManager->allocateGraphicsMemoryForImage(imgInfo, queryGmm.get());
+    queryGmm.release();
+    queryGmm = MockGmm::queryImgParams(imgInfo);
+    auto secondImage = memoryManager->allocateGraphicsMemoryForImage(imgInfo, queryGmm.get());
+    queryGmm.release();
+
+    ASSERT_NE(nullptr, firstImage);
+    ASSERT_NE(nullptr, secondImage);
+    EXPECT_EQ(1, mmapMockCallCount);
+    EXPECT_NE(0u, firstImage->getGpuAddress());
+    EXPECT_NE(0u, secondImage->getGpuAddress());
+    EXPECT_NE(firstImage->getGpuAddress(), secondImage->getGpuAddress());
+
+    auto bo = static_cast<DrmAllocation *>(firstImage)->getBO();
+    EXPECT_EQ(GPU_VA_HEAP_ALLOCATOR, bo->peekAllocationType());
+    EXPECT_LE(imgInfo.size, bo->peekUnmapSize());
+    EXPECT_EQ(firstImage->getGpuAddress(), reinterpret_cast<uint64_t>(bo->peekAddress()));
+
+    memoryManager->freeGraphicsMemory(firstImage);
+    memoryManager->freeGraphicsMemory(secondImage);
+    EXPECT_EQ(0, munmapMockCallCount);
+
+    delete memoryManager;
+    memoryManager = nullptr;
+    EXPECT_EQ(1, munmapMockCallCount);
+}
+
 TEST_F(DrmMemoryManagerTest, givenDrmMemoryManagerWhenTiledImageWithMipLevelZeroIsBeingCreatedThenallocateGraphicsMemoryForImageIsUsed) {
     mock->ioctl_expected.gemCreate = 1;
     mock->ioctl_expected.gemSetTiling = 1;
@@ -1915,6 +2169,30 @@ TEST_F(DrmMemoryManagerTest, givenMemoryManagerSupportingVirutalPaddingWhenItIsR
     memoryManager->freeGraphicsMemory(buffer);
 }
 
+TEST_F(DrmMemoryManagerTest, givenGpuVirtualAddressHeapEnabledWhenPaddedAllocationIsCreatedThenItsGpuRangeComesFromHeap) {
+    if (!is64bit) {
+        return;
+    }
+    DebugManagerStateRestore dbgRestorer;
+    DebugManager.flags.EnableGpuVirtualAddressHeap.set(true);
+    mock->ioctl_expected.gemUserptr = 2;
+    mock->ioctl_expected.gemWait = 2;
+    mock->ioctl_expected.gemClose = 2;
+
+    auto buffer = memoryManager->allocateGraphicsMemory(MemoryConstants::pageSize, MemoryConstants::pageSize);
+    auto paddedAllocation = memoryManager->createGraphicsAllocationWithPadding(buffer, 8192u);
+    ASSERT_NE(nullptr, paddedAllocation);
+
+    auto bo = static_cast<DrmAllocation *>(paddedAllocation)->getBO();
+    EXPECT_EQ(GPU_VA_HEAP_ALLOCATOR, bo->peekAllocationType());
+    EXPECT_EQ(8192u, bo->peekUnmapSize());
+    EXPECT_EQ(1, mmapMockCallCount);
+
+    memoryManager->freeGraphicsMemory(paddedAllocation);
+    memoryManager->freeGraphicsMemory(buffer);
+    EXPECT_EQ(0, munmapMockCallCount);
+}
+
 TEST_F(DrmMemoryManagerTest, givenMemoryManagerWhenAskedForInternalAllocationWithNoPointerThenAllocationFromInternalHeapIsReturned) {
     mock->ioctl_expected.gemUserptr = 1;
     mock->ioctl_expected.gemWait = 1;
@@ -131,6 +131,10 @@ class Drm2 : public Drm {
                 *((int *)(gp->value)) = this->StoredExecSoftPin;
                 return this->StoredRetVal;
             }
+            if (gp->param == I915_PARAM_HAS_EXEC_FENCE) {
+                *((int *)(gp->value)) = this->StoredExecFence;
+                return this->StoredRetVal;
+            }
         }
 #if defined(I915_PARAM_HAS_PREEMPTION)
         if ((request == DRM_IOCTL_I915_GEM_CONTEXT_CREATE) && (arg != nullptr)) {
@@ -249,6 +253,7 @@ class Drm2 : public Drm {
     int StoredPreemptionSupport = 1;
     int StoredMockPreemptionSupport = 0;
     int StoredExecSoftPin = 0;
+    int StoredExecFence = 0;
     uint32_t StoredCtxId = 1;
 
     //DRM_IOCTL_I915_GEM_EXECBUFFER2
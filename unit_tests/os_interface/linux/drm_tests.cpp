@@ -236,6 +236,19 @@ TEST(DrmTest, getExecSoftPin) {
     delete pDrm;
 }
 
+TEST(DrmTest, givenKernelWithExecFenceWhenQueriedThenSupportIsReported) {
+    std::unique_ptr<Drm2> pDrm(new Drm2);
+    int execFence = -1;
+
+    EXPECT_EQ(0, pDrm->getExecFence(execFence));
+    EXPECT_EQ(0, execFence);
+
+    pDrm->StoredExecFence = 1;
+    EXPECT_EQ(0, pDrm->getExecFence(execFence));
+    EXPECT_EQ(1, execFence);
+    EXPECT_FALSE(pDrm->isExecFenceSupported());
+}
+
 TEST(DrmTest, enableTurboBoost) {
     Drm2 *pDrm = new Drm2;
 
@@ -20,12 +20,14 @@
  * OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#include "unit_tests/helpers/debug_manager_state_restore.h"
 #include "unit_tests/os_interface/linux/device_command_stream_fixture.h"
 #include "unit_tests/os_interface/linux/mock_os_time_linux.h"
 #include "runtime/os_interface/linux/drm_neo.h"
 #include "test.h"
 #include "gtest/gtest.h"
 #include "runtime/os_interface/linux/os_interface.h"
+#include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/os_interface/linux/os_time.h"
 
 #include <dlfcn.h>
@@ -229,3 +231,86 @@ TEST_F(DrmTimeTest, givenAlwaysPassingResolutionFuncWhenGetCpuRawTimestampIsCall
     auto retVal = osTime->getCpuRawTimestamp();
     EXPECT_EQ(1ull, retVal);
 }
+
+namespace {
+uint64_t fakeCpuTimeInNs = 0;
+
+int getTimeFuncFake(clockid_t clkId, struct timespec *tp) throw() {
+    tp->tv_sec = fakeCpuTimeInNs / NSEC_PER_SEC;
+    tp->tv_nsec = fakeCpuTimeInNs % NSEC_PER_SEC;
+    return 0;
+}
+
+// GPU timestamp driven by the fake CPU clock, one tick every 80ns
+class DrmMockClock : public DrmMockSuccess {
+  public:
+    int ioctl(unsigned long request, void *arg) override {
+        if (request == DRM_IOCTL_I915_REG_READ) {
+            regReadCount++;
+            reinterpret_cast<drm_i915_reg_read *>(arg)->val = fakeCpuTimeInNs / 80;
+        }
+        return 0;
+    }
+    uint32_t regReadCount = 0;
+};
+} // namespace
+
+struct DrmTimeCorrelationTest : public DrmTimeTest {
+    void SetUp() override {
+        DrmTimeTest::SetUp();
+        fakeCpuTimeInNs = 1000 * 1000;
+        osTime->setGetTimeFunc(getTimeFuncFake);
+        osTime->updateDrm(&drm);
+        drm.regReadCount = 0;
+    }
+    DrmMockClock drm;
+};
+
+TEST_F(DrmTimeCorrelationTest, givenCalibratedModelWhenGetCpuGpuTimeIsCalledWithinIntervalThenRegisterIsNotRead) {
+    TimeStampData timeStamp = {0, 0};
+    EXPECT_TRUE(osTime->getCpuGpuTime(&timeStamp));
+    fakeCpuTimeInNs += CpuGpuTimeCorrelation::minSlopeWindowInNs;
+    EXPECT_TRUE(osTime->getCpuGpuTime(&timeStamp));
+    EXPECT_EQ(2u, drm.regReadCount);
+    ASSERT_TRUE(osTime->getTimeCorrelation()->isCalibrated());
+
+    for (int i = 0; i < 10; i++) {
+        fakeCpuTimeInNs += 8000;
+        EXPECT_TRUE(osTime->getCpuGpuTime(&timeStamp));
+        EXPECT_EQ(fakeCpuTimeInNs, timeStamp.CPUTimeinNS);
+        EXPECT_NEAR(static_cast<double>(fakeCpuTimeInNs / 80), static_cast<double>(timeStamp.GPUTimeStamp), 1.0);
+    }
+    EXPECT_EQ(2u, drm.regReadCount);
+}
+
+TEST_F(DrmTimeCorrelationTest, givenCalibratedModelWhenIntervalElapsesThenTimestampIsRecalibrated) {
+    TimeStampData timeStamp = {0, 0};
+    osTime->getCpuGpuTime(&timeStamp);
+    fakeCpuTimeInNs += CpuGpuTimeCorrelation::minSlopeWindowInNs;
+    osTime->getCpuGpuTime(&timeStamp);
+    EXPECT_EQ(2u, drm.regReadCount);
+
+    fakeCpuTimeInNs += CpuGpuTimeCorrelation::defaultCalibrationIntervalInNs;
+    EXPECT_TRUE(osTime->getCpuGpuTime(&timeStamp));
+    EXPECT_EQ(3u, drm.regReadCount);
+    EXPECT_EQ(fakeCpuTimeInNs / 80, timeStamp.GPUTimeStamp);
+    EXPECT_TRUE(osTime->getTimeCorrelation()->isCalibrated());
+    EXPECT_EQ(0u, osTime->getTimeCorrelation()->getLastCalibrationErrorInNs());
+}
+
+TEST_F(DrmTimeCorrelationTest, givenZeroCalibrationIntervalWhenGetCpuGpuTimeIsCalledThenRegisterIsReadEveryTime) {
+    DebugManagerStateRestore restore;
+    DebugManager.flags.OverrideGpuTimestampCalibrationIntervalMs.set(0);
+    auto osTimeNoCorrelation = MockOSTimeLinux::create(osInterface.get());
+    osTimeNoCorrelation->setGetTimeFunc(getTimeFuncFake);
+    osTimeNoCorrelation->updateDrm(&drm);
+    drm.regReadCount = 0;
+
+    TimeStampData timeStamp = {0, 0};
+    for (int i = 0; i < 4; i++) {
+        fakeCpuTimeInNs += CpuGpuTimeCorrelation::minSlopeWindowInNs;
+        EXPECT_TRUE(osTimeNoCorrelation->getCpuGpuTime(&timeStamp));
+    }
+    EXPECT_EQ(4u, drm.regReadCount);
+    EXPECT_FALSE(osTimeNoCorrelation->getTimeCorrelation()->isCalibrated());
+}
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/os_interface/os_time_correlation.h"
+#include "gtest/gtest.h"
+
+using namespace OCLRT;
+
+namespace {
+// fake clock: 1 GPU tick every 80ns
+TimeStampData sampleAt(uint64_t cpuTimeInNs) {
+    return {cpuTimeInNs / 80, cpuTimeInNs};
+}
+} // namespace
+
+TEST(CpuGpuTimeCorrelationTest, givenNoCalibrationWhenEstimatingThenEstimationFails) {
+    CpuGpuTimeCorrelation timeCorrelation;
+    TimeStampData timeStamp = {0, 0};
+    EXPECT_FALSE(timeCorrelation.isCalibrated());
+    EXPECT_FALSE(timeCorrelation.estimateGpuTime(1000, &timeStamp));
+}
+
+TEST(CpuGpuTimeCorrelationTest, givenSamplesCloserThanSlopeWindowWhenCalibratingThenModelIsNotCalibrated) {
+    CpuGpuTimeCorrelation timeCorrelation;
+    timeCorrelation.calibrate(sampleAt(1000));
+    timeCorrelation.calibrate(sampleAt(1000 + CpuGpuTimeCorrelation::minSlopeWindowInNs / 2));
+    EXPECT_FALSE(timeCorrelation.isCalibrated());
+    EXPECT_EQ(2u, timeCorrelation.getCalibrationCount());
+}
+
+TEST(CpuGpuTimeCorrelationTest, givenTwoSamplesWhenEstimatingWithinIntervalThenGpuTimeIsInterpolated) {
+    CpuGpuTimeCorrelation timeCorrelation;
+    uint64_t start = 1000 * 1000;
+    uint64_t calibrated = start + 2 * CpuGpuTimeCorrelation::minSlopeWindowInNs;
+    timeCorrelation.calibrate(sampleAt(start));
+    timeCorrelation.calibrate(sampleAt(calibrated));
+    ASSERT_TRUE(timeCorrelation.isCalibrated());
+    EXPECT_NEAR(80.0, timeCorrelation.getGpuTimerResolution(), 0.001);
+
+    TimeStampData timeStamp = {0, 0};
+    uint64_t query = calibrated + 8000;
+    EXPECT_TRUE(timeCorrelation.estimateGpuTime(query, &timeStamp));
+    EXPECT_EQ(query, timeStamp.CPUTimeinNS);
+    EXPECT_NEAR(static_cast<double>(query / 80), static_cast<double>(timeStamp.GPUTimeStamp), 1.0);
+}
+
+TEST(CpuGpuTimeCorrelationTest, givenCalibratedModelWhenIntervalElapsedThenEstimationFails) {
+    CpuGpuTimeCorrelation timeCorrelation;
+    timeCorrelation.setCalibrationInterval(10 * CpuGpuTimeCorrelation::minSlopeWindowInNs);
+    timeCorrelation.calibrate(sampleAt(0));
+    timeCorrelation.calibrate(sampleAt(CpuGpuTimeCorrelation::minSlopeWindowInNs));
+    ASSERT_TRUE(timeCorrelation.isCalibrated());
+
+    TimeStampData timeStamp = {0, 0};
+    EXPECT_FALSE(timeCorrelation.estimateGpuTime(11 * CpuGpuTimeCorrelation::minSlopeWindowInNs, &timeStamp));
+}
+
+TEST(CpuGpuTimeCorrelationTest, givenDisabledModelWhenEstimatingThenEstimationFails) {
+    CpuGpuTimeCorrelation timeCorrelation;
+    timeCorrelation.setCalibrationInterval(0);
+    timeCorrelation.calibrate(sampleAt(0));
+    timeCorrelation.calibrate(sampleAt(CpuGpuTimeCorrelation::minSlopeWindowInNs));
+    TimeStampData timeStamp = {0, 0};
+    EXPECT_FALSE(timeCorrelation.isEnabled());
+    EXPECT_FALSE(timeCorrelation.estimateGpuTime(CpuGpuTimeCorrelation::minSlopeWindowInNs + 1, &timeStamp));
+}
+
+TEST(CpuGpuTimeCorrelationTest, givenSampleOutsideErrorBoundWhenCalibratingThenModelIsReset) {
+    CpuGpuTimeCorrelation timeCorrelation;
+    uint64_t window = CpuGpuTimeCorrelation::minSlopeWindowInNs;
+    timeCorrelation.calibrate(sampleAt(0));
+    timeCorrelation.calibrate(sampleAt(window));
+    ASSERT_TRUE(timeCorrelation.isCalibrated());
+
+    auto driftedSample = sampleAt(2 * window);
+    driftedSample.GPUTimeStamp += 1000;
+    timeCorrelation.calibrate(driftedSample);
+    EXPECT_FALSE(timeCorrelation.isCalibrated());
+    EXPECT_GT(timeCorrelation.getLastCalibrationErrorInNs(), CpuGpuTimeCorrelation::defaultMaxErrorInNs);
+}
+
+TEST(CpuGpuTimeCorrelationTest, givenSampleWithinErrorBoundWhenCalibratingThenErrorIsReported) {
+    CpuGpuTimeCorrelation timeCorrelation;
+    uint64_t window = CpuGpuTimeCorrelation::minSlopeWindowInNs;
+    timeCorrelation.calibrate(sampleAt(0));
+    timeCorrelation.calibrate(sampleAt(window));
+
+    auto sample = sampleAt(2 * window);
+    sample.GPUTimeStamp += 2;
+    timeCorrelation.calibrate(sample);
+    EXPECT_TRUE(timeCorrelation.isCalibrated());
+    EXPECT_NEAR(160.0, static_cast<double>(timeCorrelation.getLastCalibrationErrorInNs()), 1.0);
+}
+
+TEST(CpuGpuTimeCorrelationTest, givenGpuTimestampWrapWhenCalibratingAndEstimatingThenModelStaysMonotonic) {
+    CpuGpuTimeCorrelation timeCorrelation;
+    timeCorrelation.setGpuTimestampBits(32);
+    uint64_t mask = 0xFFFFFFFFull;
+    uint64_t window = CpuGpuTimeCorrelation::minSlopeWindowInNs;
+    uint64_t baseTicks = mask - window / 160;
+
+    timeCorrelation.calibrate({baseTicks, 0});
+    timeCorrelation.calibrate({(baseTicks + window / 80) & mask, window});
+    ASSERT_TRUE(timeCorrelation.isCalibrated());
+    EXPECT_NEAR(80.0, timeCorrelation.getGpuTimerResolution(), 0.001);
+
+    TimeStampData timeStamp = {0, 0};
+    EXPECT_TRUE(timeCorrelation.estimateGpuTime(window + 800, &timeStamp));
+    auto expectedTicks = (baseTicks + window / 80 + 10) & mask;
+    EXPECT_LE((expectedTicks - timeStamp.GPUTimeStamp) & mask, 1u);
+}
+
+TEST(CpuGpuTimeCorrelationTest, givenJitteryClockWhenCalibratingPeriodicallyThenModelIsKeptAndReportedTimeIsMonotonic) {
+    CpuGpuTimeCorrelation timeCorrelation;
+    const int64_t jitterInNs = static_cast<int64_t>(CpuGpuTimeCorrelation::defaultMaxErrorInNs);
+    uint32_t seed = 12345;
+    // register read lands up to jitterInNs away from the CPU timestamp taken with it
+    auto jitteryRead = [&](uint64_t cpuTimeInNs) {
+        seed = seed * 1103515245u + 12345u;
+        auto jitter = static_cast<int64_t>((seed >> 16) % (2 * jitterInNs + 1)) - jitterInNs;
+        return TimeStampData{static_cast<uint64_t>(static_cast<int64_t>(cpuTimeInNs) + jitter) / 80, cpuTimeInNs};
+    };
+
+    uint64_t cpuTime = 10 * CpuGpuTimeCorrelation::minSlopeWindowInNs;
+    timeCorrelation.calibrate(jitteryRead(cpuTime));
+    cpuTime += CpuGpuTimeCorrelation::minSlopeWindowInNs;
+    timeCorrelation.calibrate(jitteryRead(cpuTime));
+    ASSERT_TRUE(timeCorrelation.isCalibrated());
+
+    uint64_t lastReported = 0;
+    const uint64_t step = CpuGpuTimeCorrelation::defaultCalibrationIntervalInNs / 10;
+    for (int calibration = 0; calibration < 50; calibration++) {
+        for (int query = 0; query < 9; query++) {
+            cpuTime += step;
+            TimeStampData timeStamp = {0, 0};
+            ASSERT_TRUE(timeCorrelation.estimateGpuTime(cpuTime, &timeStamp));
+            EXPECT_GE(timeStamp.GPUTimeStamp, lastReported);
+            lastReported = timeStamp.GPUTimeStamp;
+        }
+        cpuTime += step - 1;
+        auto reported = timeCorrelation.calibrate(jitteryRead(cpuTime));
+        EXPECT_TRUE(timeCorrelation.isCalibrated());
+        EXPECT_GE(reported.GPUTimeStamp, lastReported);
+        lastReported = reported.GPUTimeStamp;
+    }
+    EXPECT_NEAR(80.0, timeCorrelation.getGpuTimerResolution(), 0.01);
+}
+
+TEST(CpuGpuTimeCorrelationTest, givenResetAfterExtrapolationAheadOfRealClockWhenCalibratingThenReportedTimeDoesNotGoBack) {
+    CpuGpuTimeCorrelation timeCorrelation;
+    uint64_t window = CpuGpuTimeCorrelation::minSlopeWindowInNs;
+    timeCorrelation.calibrate(sampleAt(0));
+    timeCorrelation.calibrate(sampleAt(window));
+
+    TimeStampData timeStamp = {0, 0};
+    ASSERT_TRUE(timeCorrelation.estimateGpuTime(2 * window, &timeStamp));
+    auto estimated = timeStamp.GPUTimeStamp;
+
+    auto slowSample = sampleAt(2 * window);
+    slowSample.GPUTimeStamp -= 1000;
+    auto reported = timeCorrelation.calibrate(slowSample);
+    EXPECT_FALSE(timeCorrelation.isCalibrated());
+    EXPECT_EQ(estimated, reported.GPUTimeStamp);
+}
+
+TEST(CpuGpuTimeCorrelationTest, givenSampleOlderThanLastWhenCalibratingThenModelIsKept) {
+    CpuGpuTimeCorrelation timeCorrelation;
+    uint64_t window = CpuGpuTimeCorrelation::minSlopeWindowInNs;
+    timeCorrelation.calibrate(sampleAt(window));
+    timeCorrelation.calibrate(sampleAt(2 * window));
+    ASSERT_TRUE(timeCorrelation.isCalibrated());
+
+    timeCorrelation.calibrate(sampleAt(window + window / 2));
+    EXPECT_TRUE(timeCorrelation.isCalibrated());
+    EXPECT_NEAR(80.0, timeCorrelation.getGpuTimerResolution(), 0.001);
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/memory_manager/graphics_allocation.h"
+#include "runtime/memory_manager/svm_memory_manager.h"
+#include "runtime/utilities/timer_util.h"
+#include "unit_tests/perf_tests/perf_test_utils.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace OCLRT;
+
+namespace ULT {
+
+const size_t trackedAllocationCount = 1024;
+const size_t trackedAllocationSize = 0x10000;
+const int lookupThreadCount = 4;
+const int lookupsPerThread = 200000;
+
+// every thread resolves kernel argument pointers, as applications setting SVM arguments from many threads do
+template <typename LookupT>
+long long measureLookups(LookupT lookup) {
+    std::atomic<bool> start(false);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < lookupThreadCount; t++) {
+        threads.push_back(std::thread([&start, &lookup, t]() {
+            while (!start)
+                ;
+            size_t found = 0;
+            for (int i = 0; i < lookupsPerThread; i++) {
+                auto index = (i * 7 + t) % trackedAllocationCount;
+                auto ptr = reinterpret_cast<void *>(0x10000000 + index * trackedAllocationSize + i % trackedAllocationSize);
+                found += lookup(ptr) != nullptr;
+            }
+            EXPECT_EQ(static_cast<size_t>(lookupsPerThread), found);
+        }));
+    }
+
+    Timer timer;
+    timer.start();
+    start = true;
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    timer.end();
+    return timer.get();
+}
+
+TEST(SVMAllocationTrackerPerfTest, givenManyThreadsLookingUpAllocationsThenLookupTimesOfBothTrackersAreReported) {
+    std::vector<std::unique_ptr<GraphicsAllocation>> allocations;
+    SVMAllocsManager::MapBasedAllocationTracker mapTracker;
+    SVMAllocsManager::SortedArrayAllocationTracker sortedArrayTracker;
+    for (size_t i = 0; i < trackedAllocationCount; i++) {
+        allocations.emplace_back(new GraphicsAllocation(reinterpret_cast<void *>(0x10000000 + i * trackedAllocationSize), trackedAllocationSize));
+        mapTracker.insert(*allocations.back());
+        sortedArrayTracker.insert(*allocations.back());
+    }
+
+    std::mutex mapMutex;
+    long long mapTimes[3] = {0, 0, 0};
+    long long sortedArrayTimes[3] = {0, 0, 0};
+    for (int run = 0; run < 3; run++) {
+        mapTimes[run] = measureLookups([&](const void *ptr) {
+            std::lock_guard<std::mutex> lock(mapMutex);
+            return mapTracker.get(ptr);
+        });
+        sortedArrayTimes[run] = measureLookups([&](const void *ptr) {
+            return sortedArrayTracker.get(ptr);
+        });
+    }
+
+    long long mapTime = majorityVote(mapTimes[0], mapTimes[1], mapTimes[2]);
+    long long sortedArrayTime = majorityVote(sortedArrayTimes[0], sortedArrayTimes[1], sortedArrayTimes[2]);
+    // timings depend on the machine and its load, they are reported for comparison rather than asserted
+    RecordProperty("sortedArrayNs", std::to_string(sortedArrayTime));
+    RecordProperty("lockedMapNs", std::to_string(mapTime));
+
+    for (auto &allocation : allocations) {
+        mapTracker.remove(*allocation);
+        sortedArrayTracker.remove(*allocation);
+    }
+}
+} // namespace ULT
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/utilities/binary_tracer.h"
+#include "runtime/utilities/timer_util.h"
+#include "unit_tests/perf_tests/perf_test_utils.h"
+
+using namespace OCLRT;
+
+namespace ULT {
+
+TEST(BinaryTracerPerfTest, givenEnabledTracerWhenRecordingEventsThenAverageCostIsReportedAndNothingIsDropped) {
+    Tracer tracer;
+    tracer.enable();
+    std::vector<TraceRecord> records;
+    records.reserve(TraceRingBuffer::capacity);
+
+    const uint32_t eventsPerRun = TraceRingBuffer::capacity;
+    long long times[3] = {0, 0, 0};
+
+    for (int run = 0; run < 3; run++) {
+        Timer t;
+        t.start();
+        for (uint32_t i = 0; i < eventsPerRun; i += 2) {
+            tracer.record(TraceCategory::Api, TracePhase::Begin, "benchmark", i);
+            tracer.record(TraceCategory::Api, TracePhase::End, "benchmark", 0);
+        }
+        t.end();
+        times[run] = t.get();
+
+        records.clear();
+        tracer.drain(records);
+        EXPECT_EQ(eventsPerRun, records.size());
+    }
+
+    long long time = majorityVote(times[0], times[1], times[2]);
+    RecordProperty("nanosecondsPerEvent", static_cast<int>(time / eventsPerRun));
+    EXPECT_EQ(0u, tracer.getDroppedCount());
+
+    tracer.disable();
+    tracer.releaseBuffers();
+}
+} // namespace ULT
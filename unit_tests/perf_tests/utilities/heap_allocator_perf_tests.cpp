@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/utilities/heap_allocator.h"
+#include "runtime/utilities/timer_util.h"
+#include "runtime/utilities/tlsf_heap_allocator.h"
+#include "unit_tests/perf_tests/perf_test_utils.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace OCLRT;
+
+namespace ULT {
+
+const uint64_t churnHeapSize = 256 * MemoryConstants::megaByte;
+const uint32_t liveAllocationCount = 4096;
+const uint32_t churnIterations = 50000;
+
+// keeps many allocations alive and replaces random ones, as builds of programs with thousands of kernels do
+template <typename AllocatorT>
+long long measureChurn(AllocatorT &allocator) {
+    std::mt19937 generator(0);
+    std::uniform_int_distribution<size_t> sizeDistribution(1, 16 * MemoryConstants::pageSize);
+    std::vector<std::pair<void *, size_t>> live(liveAllocationCount, {nullptr, 0});
+
+    Timer t;
+    t.start();
+    for (uint32_t i = 0; i < churnIterations; i++) {
+        auto &slot = live[generator() % liveAllocationCount];
+        if (slot.first != nullptr) {
+            allocator.free(slot.first, slot.second);
+        }
+        slot.second = sizeDistribution(generator);
+        slot.first = allocator.allocate(slot.second);
+    }
+    t.end();
+
+    for (auto &slot : live) {
+        if (slot.first != nullptr) {
+            allocator.free(slot.first, slot.second);
+        }
+    }
+    return t.get();
+}
+
+TEST(TlsfHeapAllocatorPerfTest, givenManyLiveAllocationsWhenChurningHeapThenChurnTimesOfBothAllocatorsAreReported) {
+    void *heapBase = reinterpret_cast<void *>(0x10000000);
+    long long tlsfTimes[3] = {0, 0, 0};
+    long long heapTimes[3] = {0, 0, 0};
+
+    for (int run = 0; run < 3; run++) {
+        TlsfHeapAllocator tlsfAllocator(heapBase, churnHeapSize);
+        tlsfTimes[run] = measureChurn(tlsfAllocator);
+        EXPECT_EQ(churnHeapSize, tlsfAllocator.getLeftSize());
+
+        HeapAllocator heapAllocator(heapBase, churnHeapSize);
+        heapTimes[run] = measureChurn(heapAllocator);
+    }
+
+    long long tlsfTime = majorityVote(tlsfTimes[0], tlsfTimes[1], tlsfTimes[2]);
+    long long heapTime = majorityVote(heapTimes[0], heapTimes[1], heapTimes[2]);
+    // timings depend on the machine and its load, they are reported for comparison rather than asserted
+    RecordProperty("tlsfNs", std::to_string(tlsfTime));
+    RecordProperty("heapAllocatorNs", std::to_string(heapTime));
+}
+} // namespace ULT
@@ -21,7 +21,9 @@
  */
 
 #include "runtime/program/printf_handler.h"
+#include "runtime/program/printf_output_worker.h"
 #include "unit_tests/fixtures/device_fixture.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
 #include "unit_tests/mocks/mock_context.h"
 #include "unit_tests/mocks/mock_device.h"
 #include "unit_tests/mocks/mock_graphics_allocation.h"
@@ -123,3 +125,71 @@ TEST(PrintfHandlerTest, givenParentKernelWithPrintfAndBlockKernelWithoutPrintfWh
 
     ASSERT_NE(nullptr, printfHandler);
 }
+
+TEST(PrintfHandlerTest, givenPrintfHandlerReleasedWhenNextHandlerIsPreparedThenPrintfSurfaceIsReused) {
+    std::unique_ptr<MockDevice> device(DeviceHelper<>::create());
+    MockContext context;
+    SPatchAllocateStatelessPrintfSurface printfSurface = {};
+    printfSurface.DataParamOffset = 0;
+    printfSurface.DataParamSize = 8;
+
+    KernelInfo kernelInfo;
+    kernelInfo.patchInfo.pAllocateStatelessPrintfSurface = &printfSurface;
+
+    std::unique_ptr<MockProgram> program(new MockProgram(&context, false));
+
+    uint64_t crossThread[10];
+    std::unique_ptr<MockKernel> kernel(new MockKernel(program.get(), kernelInfo, *device));
+    kernel->setCrossThreadData(&crossThread, sizeof(uint64_t) * 8);
+
+    MockMultiDispatchInfo multiDispatchInfo(kernel.get());
+    std::unique_ptr<PrintfHandler> printfHandler(PrintfHandler::create(multiDispatchInfo, *device));
+    printfHandler->prepareDispatch(multiDispatchInfo);
+    auto firstSurface = printfHandler->getSurface();
+    ASSERT_NE(nullptr, firstSurface);
+    printfHandler.reset();
+
+    printfHandler.reset(PrintfHandler::create(multiDispatchInfo, *device));
+    printfHandler->prepareDispatch(multiDispatchInfo);
+    EXPECT_EQ(firstSurface, printfHandler->getSurface());
+    EXPECT_EQ(sizeof(uint32_t), *reinterpret_cast<uint32_t *>(printfHandler->getSurface()->getUnderlyingBuffer()));
+}
+
+TEST(PrintfHandlerTest, givenAsyncPrintfOutputEnabledWhenOutputIsFlushedThenItIsPrintedByWorkerAndSurfaceReturnsToPool) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.EnableAsyncPrintfOutput.set(true);
+
+    std::unique_ptr<MockDevice> device(DeviceHelper<>::create());
+    MockContext context;
+    SPatchAllocateStatelessPrintfSurface printfSurface = {};
+    printfSurface.DataParamOffset = 0;
+    printfSurface.DataParamSize = 8;
+
+    KernelInfo kernelInfo;
+    kernelInfo.patchInfo.pAllocateStatelessPrintfSurface = &printfSurface;
+
+    std::unique_ptr<MockProgram> program(new MockProgram(&context, false));
+
+    uint64_t crossThread[10];
+    auto kernel = new MockKernel(program.get(), kernelInfo, *device);
+    kernel->incRefInternal();
+    kernel->setCrossThreadData(&crossThread, sizeof(uint64_t) * 8);
+
+    MockMultiDispatchInfo multiDispatchInfo(kernel);
+    std::unique_ptr<PrintfHandler> printfHandler(PrintfHandler::create(multiDispatchInfo, *device));
+    printfHandler->prepareDispatch(multiDispatchInfo);
+    auto surface = printfHandler->getSurface();
+
+    PrintfHandler::flushEnqueueOutput(std::move(printfHandler));
+    EXPECT_EQ(nullptr, printfHandler.get());
+
+    device->getPrintfOutputWorker().drain();
+    EXPECT_EQ(1, kernel->getRefInternalCount());
+
+    printfHandler.reset(PrintfHandler::create(multiDispatchInfo, *device));
+    printfHandler->prepareDispatch(multiDispatchInfo);
+    EXPECT_EQ(surface, printfHandler->getSurface());
+    printfHandler.reset();
+
+    kernel->decRefInternal();
+}
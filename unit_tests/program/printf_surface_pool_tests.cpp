@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/memory_manager/graphics_allocation.h"
+#include "runtime/memory_manager/os_agnostic_memory_manager.h"
+#include "runtime/program/printf_surface_pool.h"
+#include "gtest/gtest.h"
+
+using namespace OCLRT;
+
+struct PrintfSurfacePoolTest : public ::testing::Test {
+    void TearDown() override {
+        pool.freeSurfaces(memoryManager);
+    }
+
+    OsAgnosticMemoryManager memoryManager;
+    PrintfSurfacePool pool;
+    volatile uint32_t tag = 0;
+    const size_t surfaceSize = 4096;
+};
+
+TEST_F(PrintfSurfacePoolTest, givenEmptyPoolWhenSurfaceIsObtainedThenNewSurfaceOfRequestedSizeIsCreated) {
+    auto surface = pool.obtainSurface(memoryManager, surfaceSize, &tag);
+    ASSERT_NE(nullptr, surface);
+    EXPECT_EQ(surfaceSize, surface->getUnderlyingBufferSize());
+    memoryManager.freeGraphicsMemory(surface);
+}
+
+TEST_F(PrintfSurfacePoolTest, givenSurfaceReturnedForCompletedTaskWhenSurfaceIsObtainedThenItIsReused) {
+    auto surface = pool.obtainSurface(memoryManager, surfaceSize, &tag);
+    pool.returnSurface(surface, 5);
+
+    tag = 6;
+    auto reused = pool.obtainSurface(memoryManager, surfaceSize, &tag);
+    EXPECT_EQ(surface, reused);
+    memoryManager.freeGraphicsMemory(reused);
+}
+
+TEST_F(PrintfSurfacePoolTest, givenSurfaceReturnedForBusyTaskWhenSurfaceIsObtainedThenNewSurfaceIsCreated) {
+    auto surface = pool.obtainSurface(memoryManager, surfaceSize, &tag);
+    pool.returnSurface(surface, 5);
+
+    tag = 5;
+    auto newSurface = pool.obtainSurface(memoryManager, surfaceSize, &tag);
+    ASSERT_NE(nullptr, newSurface);
+    EXPECT_NE(surface, newSurface);
+    memoryManager.freeGraphicsMemory(newSurface);
+
+    tag = 6;
+    auto reused = pool.obtainSurface(memoryManager, surfaceSize, &tag);
+    EXPECT_EQ(surface, reused);
+    memoryManager.freeGraphicsMemory(reused);
+}
+
+TEST_F(PrintfSurfacePoolTest, givenSurfaceReturnedWithoutPendingTaskWhenSurfaceIsObtainedThenItIsReusedRegardlessOfTag) {
+    auto surface = pool.obtainSurface(memoryManager, surfaceSize, &tag);
+    pool.returnSurface(surface, 0);
+
+    auto reused = pool.obtainSurface(memoryManager, surfaceSize, &tag);
+    EXPECT_EQ(surface, reused);
+    memoryManager.freeGraphicsMemory(reused);
+}
+
+TEST_F(PrintfSurfacePoolTest, givenPooledSurfaceSmallerThanRequestedWhenSurfaceIsObtainedThenNewSurfaceIsCreated) {
+    auto surface = pool.obtainSurface(memoryManager, surfaceSize, &tag);
+    pool.returnSurface(surface, 5);
+
+    tag = 6;
+    auto biggerSurface = pool.obtainSurface(memoryManager, 2 * surfaceSize, &tag);
+    ASSERT_NE(nullptr, biggerSurface);
+    EXPECT_NE(surface, biggerSurface);
+    EXPECT_EQ(2 * surfaceSize, biggerSurface->getUnderlyingBufferSize());
+    memoryManager.freeGraphicsMemory(biggerSurface);
+
+    auto reused = pool.obtainSurface(memoryManager, surfaceSize, &tag);
+    EXPECT_EQ(surface, reused);
+    memoryManager.freeGraphicsMemory(reused);
+}
+
+TEST_F(PrintfSurfacePoolTest, givenPooledSurfaceBiggerThanRequestedWhenSurfaceIsObtainedThenItIsReused) {
+    auto surface = pool.obtainSurface(memoryManager, 2 * surfaceSize, &tag);
+    pool.returnSurface(surface, 5);
+
+    tag = 6;
+    auto reused = pool.obtainSurface(memoryManager, surfaceSize, &tag);
+    EXPECT_EQ(surface, reused);
+    memoryManager.freeGraphicsMemory(reused);
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "unit_tests/fixtures/scenario_test_fixture.h"
+#include "unit_tests/mocks/mock_command_queue.h"
+#include "unit_tests/mocks/mock_kernel.h"
+#include "runtime/event/event.h"
+#include "runtime/event/user_event.h"
+
+#include "gtest/gtest.h"
+#include "test.h"
+
+using namespace OCLRT;
+
+typedef ScenarioTest BlockedEnqueuePoolScenarioTest;
+
+HWTEST_F(BlockedEnqueuePoolScenarioTest, givenRepeatedBlockedEnqueuesWhenUserEventsAreUnblockedThenCommandStorageIsReused) {
+    auto mockCmdQ = new MockCommandQueueHw<FamilyType>(context, pPlatform->getDevice(0), nullptr);
+    cl_command_queue clCommandQ = mockCmdQ;
+    auto &pool = mockCmdQ->getBlockedCommandsPool();
+
+    cl_kernel clKernel = kernel;
+    size_t offset[] = {0, 0, 0};
+    size_t gws[] = {1, 1, 1};
+    cl_int retVal = CL_SUCCESS;
+
+    uint64_t allocationsAfterFirstEnqueue = 0;
+    for (int i = 0; i < 4; i++) {
+        UserEvent *userEvent = new UserEvent(context);
+        cl_event eventBlocking = userEvent;
+
+        retVal = clEnqueueNDRangeKernel(clCommandQ, clKernel, 1, offset, gws, nullptr, 1, &eventBlocking, nullptr);
+        EXPECT_EQ(CL_SUCCESS, retVal);
+        EXPECT_NE(nullptr, mockCmdQ->virtualEvent);
+
+        clSetUserEventStatus(eventBlocking, CL_COMPLETE);
+        userEvent->release();
+
+        if (i == 0) {
+            allocationsAfterFirstEnqueue = pool.peekSystemAllocationsCount();
+            EXPECT_NE(0u, allocationsAfterFirstEnqueue);
+        } else {
+            EXPECT_EQ(allocationsAfterFirstEnqueue, pool.peekSystemAllocationsCount());
+        }
+        EXPECT_NE(0u, pool.peekCachedBuffersCount());
+    }
+
+    retVal = clFinish(clCommandQ);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    mockCmdQ->release();
+}
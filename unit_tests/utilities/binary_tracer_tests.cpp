@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/utilities/binary_tracer.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+using namespace OCLRT;
+
+struct BinaryTracerTest : public ::testing::Test {
+    void TearDown() override {
+        tracer.disable();
+        tracer.releaseBuffers();
+    }
+    Tracer tracer;
+};
+
+TEST(TraceRingBufferTest, givenPushedRecordsWhenDrainedThenRecordsAreReturnedInOrder) {
+    std::unique_ptr<TraceRingBuffer> ringBuffer(new TraceRingBuffer(7));
+    EXPECT_TRUE(ringBuffer->push(TraceCategory::Api, TracePhase::Begin, "first", 1, 10));
+    EXPECT_TRUE(ringBuffer->push(TraceCategory::Api, TracePhase::End, "first", 2, 20));
+
+    std::vector<TraceRecord> records;
+    EXPECT_EQ(2u, ringBuffer->drain(records));
+    ASSERT_EQ(2u, records.size());
+    EXPECT_EQ(10u, records[0].timestamp);
+    EXPECT_EQ(TracePhase::Begin, records[0].phase);
+    EXPECT_EQ(20u, records[1].timestamp);
+    EXPECT_EQ(2u, records[1].payload);
+    EXPECT_EQ(7u, records[1].threadId);
+
+    records.clear();
+    EXPECT_EQ(0u, ringBuffer->drain(records));
+}
+
+TEST(TraceRingBufferTest, givenFullRingWhenPushingThenRecordIsDroppedAndCounted) {
+    std::unique_ptr<TraceRingBuffer> ringBuffer(new TraceRingBuffer(0));
+    for (uint32_t i = 0; i < TraceRingBuffer::capacity; i++) {
+        EXPECT_TRUE(ringBuffer->push(TraceCategory::Csr, TracePhase::Instant, "fill", i, i));
+    }
+    EXPECT_FALSE(ringBuffer->push(TraceCategory::Csr, TracePhase::Instant, "overflow", 0, 0));
+    EXPECT_EQ(1u, ringBuffer->peekDroppedCount());
+
+    std::vector<TraceRecord> records;
+    EXPECT_EQ(static_cast<size_t>(TraceRingBuffer::capacity), ringBuffer->drain(records));
+    EXPECT_TRUE(ringBuffer->push(TraceCategory::Csr, TracePhase::Instant, "afterDrain", 0, 0));
+}
+
+TEST_F(BinaryTracerTest, givenDisabledTracerWhenRecordingThenNothingIsStored) {
+    tracer.record(TraceCategory::Api, TracePhase::Begin, "clFinish", 0);
+    std::vector<TraceRecord> records;
+    EXPECT_EQ(0u, tracer.drain(records));
+}
+
+TEST_F(BinaryTracerTest, givenEnabledTracerWhenRecordingFromManyThreadsThenEachThreadHasOwnBuffer) {
+    tracer.enable();
+    tracer.record(TraceCategory::Api, TracePhase::Begin, "main", 0);
+    std::thread worker([this] {
+        tracer.record(TraceCategory::Wait, TracePhase::Begin, "worker", 1);
+        tracer.record(TraceCategory::Wait, TracePhase::End, "worker", 0);
+    });
+    worker.join();
+    tracer.record(TraceCategory::Api, TracePhase::End, "main", 0);
+
+    std::vector<TraceRecord> records;
+    EXPECT_EQ(4u, tracer.drain(records));
+    ASSERT_EQ(4u, records.size());
+    EXPECT_EQ(records[0].threadId, records[1].threadId);
+    EXPECT_NE(records[0].threadId, records[2].threadId);
+    EXPECT_EQ(records[2].threadId, records[3].threadId);
+    EXPECT_LE(records[0].timestamp, records[1].timestamp);
+    EXPECT_EQ(0u, tracer.getDroppedCount());
+}
+
+TEST_F(BinaryTracerTest, givenExitedThreadWhenDrainingThenItsRecordsAreKeptAndItsBufferIsFreed) {
+    tracer.enable();
+    tracer.record(TraceCategory::Api, TracePhase::Instant, "main", 0);
+    for (int i = 0; i < 4; i++) {
+        std::thread worker([this] {
+            tracer.record(TraceCategory::Wait, TracePhase::Instant, "worker", 1);
+        });
+        worker.join();
+    }
+    EXPECT_EQ(5u, tracer.getBufferCount());
+
+    std::vector<TraceRecord> records;
+    EXPECT_EQ(5u, tracer.drain(records));
+    EXPECT_EQ(1u, tracer.getBufferCount());
+
+    records.clear();
+    tracer.record(TraceCategory::Api, TracePhase::Instant, "mainAgain", 0);
+    EXPECT_EQ(1u, tracer.drain(records));
+    EXPECT_EQ(1u, tracer.getBufferCount());
+}
+
+TEST_F(BinaryTracerTest, givenRecordsWhenExportingThenChromeTraceEventsAreWritten) {
+    tracer.enable();
+    tracer.record(TraceCategory::Api, TracePhase::Begin, "clEnqueueNDRangeKernel", 0);
+    tracer.record(TraceCategory::Memory, TracePhase::Instant, "allocateGraphicsMemory", 4096);
+    tracer.record(TraceCategory::Api, TracePhase::End, "clEnqueueNDRangeKernel", 0);
+
+    std::vector<TraceRecord> records;
+    tracer.drain(records);
+    std::stringstream output;
+    bool firstRecord = true;
+    tracer.exportChromeTrace(records, output, firstRecord);
+    EXPECT_FALSE(firstRecord);
+
+    auto json = output.str();
+    EXPECT_NE(std::string::npos, json.find("{\"name\":\"clEnqueueNDRangeKernel\",\"cat\":\"api\",\"ph\":\"B\""));
+    EXPECT_NE(std::string::npos, json.find("\"cat\":\"api\",\"ph\":\"E\""));
+    EXPECT_NE(std::string::npos, json.find("\"name\":\"allocateGraphicsMemory\",\"cat\":\"memory\",\"ph\":\"i\""));
+    EXPECT_NE(std::string::npos, json.find("\"args\":{\"value\":4096}"));
+    EXPECT_EQ(2u, static_cast<size_t>(std::count(json.begin(), json.end(), '\n')));
+}
+
+TEST_F(BinaryTracerTest, givenReleasedBuffersWhenRecordingAgainThenNewBufferIsRegistered) {
+    tracer.enable();
+    tracer.record(TraceCategory::Api, TracePhase::Instant, "before", 0);
+    tracer.releaseBuffers();
+    tracer.record(TraceCategory::Api, TracePhase::Instant, "after", 0);
+
+    std::vector<TraceRecord> records;
+    EXPECT_EQ(1u, tracer.drain(records));
+    EXPECT_STREQ("after", records[0].name);
+}
+
+TEST_F(BinaryTracerTest, givenStartedDrainerWhenStoppedThenTraceFileContainsCompleteJson) {
+    const char *fileName = "binary_tracer_test.json";
+    ASSERT_TRUE(tracer.startDrainer(fileName));
+    EXPECT_TRUE(tracer.isEnabled());
+    tracer.record(TraceCategory::Csr, TracePhase::Begin, "flushTask", 3);
+    tracer.record(TraceCategory::Csr, TracePhase::End, "flushTask", 0);
+    tracer.stopDrainer();
+
+    std::ifstream traceFile(fileName);
+    std::stringstream content;
+    content << traceFile.rdbuf();
+    traceFile.close();
+    std::remove(fileName);
+
+    auto json = content.str();
+    EXPECT_EQ(0u, json.find("{\"traceEvents\":["));
+    EXPECT_NE(std::string::npos, json.find("\"name\":\"flushTask\",\"cat\":\"csr\",\"ph\":\"B\""));
+    EXPECT_NE(std::string::npos, json.find("]}"));
+}
@@ -47,19 +47,27 @@ class MockTagAllocator : public TagAllocator<timeStamps> {
     }
 
     TagNode<timeStamps> *getFreeTagsHead() {
-        return TagAllocator<timeStamps>::freeTags.peekHead();
+        return TagAllocator<timeStamps>::freeTags[getFreeTagListIndex()].peekHead();
     }
 
-    TagNode<timeStamps> *getUsedTagsHead() {
-        return TagAllocator<timeStamps>::usedTags.peekHead();
+    bool isFreeTag(TagNode<timeStamps> *node) {
+        for (auto &freeTagList : freeTags) {
+            for (auto freeNode = freeTagList.peekHead(); freeNode != nullptr; freeNode = freeNode->next) {
+                if (freeNode == node) {
+                    return true;
+                }
+            }
+        }
+        return false;
     }
 
-    IDList<TagNode<timeStamps>> &getFreeTags() {
-        return TagAllocator<timeStamps>::freeTags;
-    }
-
-    IDList<TagNode<timeStamps>> &getUsedTags() {
-        return TagAllocator<timeStamps>::usedTags;
+    bool isDeferredTag(TagNode<timeStamps> *node) {
+        for (auto deferredNode = deferredTags.peekHead(); deferredNode != nullptr; deferredNode = deferredNode->next) {
+            if (deferredNode == node) {
+                return true;
+            }
+        }
+        return false;
     }
 
     size_t getGraphicsAllocationsCount() {
@@ -69,6 +77,15 @@ class MockTagAllocator : public TagAllocator<timeStamps> {
     size_t getTagPoolCount() {
         return tagPoolMemory.size();
     }
+
+    size_t getCallingThreadListIndex() {
+        return getFreeTagListIndex();
+    }
+
+    void returnTagToList(TagNode<timeStamps> *node, size_t listIndex) {
+        usedTagCount--;
+        pushFreeTags(listIndex, *node, *node, 1);
+    }
 };
 
 TEST_F(TagAllocatorTest, Initialize) {
@@ -78,7 +95,7 @@ TEST_F(TagAllocatorTest, Initialize) {
     ASSERT_NE(nullptr, tagAllocator.getGraphicsAllocation());
 
     ASSERT_NE(nullptr, tagAllocator.getFreeTagsHead());
-    EXPECT_EQ(nullptr, tagAllocator.getUsedTagsHead());
+    EXPECT_EQ(0u, tagAllocator.peekUsedTagCount());
 
     void *gfxMemory = tagAllocator.getGraphicsAllocation()->getUnderlyingBuffer();
     void *head = reinterpret_cast<void *>(tagAllocator.getFreeTagsHead()->tag);
@@ -91,28 +108,19 @@ TEST_F(TagAllocatorTest, GetReturnTagCheckFreeAndUsedLists) {
 
     ASSERT_NE(nullptr, tagAllocator.getGraphicsAllocation());
     ASSERT_NE(nullptr, tagAllocator.getFreeTagsHead());
-    EXPECT_EQ(nullptr, tagAllocator.getUsedTagsHead());
+    EXPECT_EQ(0u, tagAllocator.peekUsedTagCount());
 
     TagNode<timeStamps> *tagNode = tagAllocator.getTag();
 
     EXPECT_NE(nullptr, tagNode);
 
-    IDList<TagNode<timeStamps>> &freeList = tagAllocator.getFreeTags();
-    IDList<TagNode<timeStamps>> &usedList = tagAllocator.getUsedTags();
-
-    bool isFoundOnUsedList = usedList.peekContains(*tagNode);
-    bool isFoundOnFreeList = freeList.peekContains(*tagNode);
-
-    EXPECT_FALSE(isFoundOnFreeList);
-    EXPECT_TRUE(isFoundOnUsedList);
+    EXPECT_FALSE(tagAllocator.isFreeTag(tagNode));
+    EXPECT_EQ(1u, tagAllocator.peekUsedTagCount());
 
     tagAllocator.returnTag(tagNode);
 
-    isFoundOnUsedList = usedList.peekContains(*tagNode);
-    isFoundOnFreeList = freeList.peekContains(*tagNode);
-
-    EXPECT_TRUE(isFoundOnFreeList);
-    EXPECT_FALSE(isFoundOnUsedList);
+    EXPECT_TRUE(tagAllocator.isFreeTag(tagNode));
+    EXPECT_EQ(0u, tagAllocator.peekUsedTagCount());
 }
 
 TEST_F(TagAllocatorTest, TagAlignment) {
@@ -168,25 +176,19 @@ TEST_F(TagAllocatorTest, GetTagsAndReturnInDifferentOrder) {
     TagNode<timeStamps> *nullTag = tagAllocator.getTag();
     EXPECT_EQ(nullptr, nullTag);
 
-    IDList<TagNode<timeStamps>> &freeList = tagAllocator.getFreeTags();
-    bool isFoundOnFreeList = freeList.peekContains(*tagNodes[0]);
-    EXPECT_FALSE(isFoundOnFreeList);
+    EXPECT_FALSE(tagAllocator.isFreeTag(tagNodes[0]));
 
     tagAllocator.returnTag(tagNodes[2]);
-    isFoundOnFreeList = freeList.peekContains(*tagNodes[2]);
-    EXPECT_TRUE(isFoundOnFreeList);
+    EXPECT_TRUE(tagAllocator.isFreeTag(tagNodes[2]));
     EXPECT_NE(nullptr, tagAllocator.getFreeTagsHead());
 
     tagAllocator.returnTag(tagNodes[3]);
-    isFoundOnFreeList = freeList.peekContains(*tagNodes[3]);
-    EXPECT_TRUE(isFoundOnFreeList);
+    EXPECT_TRUE(tagAllocator.isFreeTag(tagNodes[3]));
 
     tagAllocator.returnTag(tagNodes[1]);
-    isFoundOnFreeList = freeList.peekContains(*tagNodes[1]);
-    EXPECT_TRUE(isFoundOnFreeList);
+    EXPECT_TRUE(tagAllocator.isFreeTag(tagNodes[1]));
 
-    isFoundOnFreeList = freeList.peekContains(*tagNodes[0]);
-    EXPECT_FALSE(isFoundOnFreeList);
+    EXPECT_FALSE(tagAllocator.isFreeTag(tagNodes[0]));
 
     tagAllocator.returnTag(tagNodes[0]);
 }
@@ -245,3 +247,100 @@ TEST_F(TagAllocatorTest, CleanupResources) {
     EXPECT_EQ(0u, tagAllocator.getGraphicsAllocationsCount());
     EXPECT_EQ(0u, tagAllocator.getTagPoolCount());
 }
+
+TEST_F(TagAllocatorTest, givenCompletedTaskWhenTagIsReturnedWhenCompletedThenItIsFreeImmediately) {
+    MockTagAllocator<> tagAllocator(memoryManager, 10, 16);
+    volatile uint32_t tagAddress = 5;
+
+    auto tagNode = tagAllocator.getTag();
+    tagAllocator.returnTagWhenCompleted(tagNode, 5, &tagAddress);
+
+    EXPECT_TRUE(tagAllocator.isFreeTag(tagNode));
+    EXPECT_FALSE(tagAllocator.isDeferredTag(tagNode));
+    EXPECT_EQ(0u, tagAllocator.peekUsedTagCount());
+}
+
+TEST_F(TagAllocatorTest, givenPendingTaskWhenTagIsReturnedWhenCompletedThenItIsNotReusedBeforeTaskCompletes) {
+    // Big alignment to force only 1 tag
+    MockTagAllocator<> tagAllocator(memoryManager, 1, 4096);
+    volatile uint32_t tagAddress = 4;
+
+    auto tagNode = tagAllocator.getTag();
+    ASSERT_NE(nullptr, tagNode);
+    tagAllocator.returnTagWhenCompleted(tagNode, 5, &tagAddress);
+
+    EXPECT_FALSE(tagAllocator.isFreeTag(tagNode));
+    EXPECT_TRUE(tagAllocator.isDeferredTag(tagNode));
+    EXPECT_EQ(0u, tagAllocator.peekUsedTagCount());
+    EXPECT_EQ(nullptr, tagAllocator.getTag());
+
+    tagAddress = 5;
+    EXPECT_EQ(tagNode, tagAllocator.getTag());
+    EXPECT_FALSE(tagAllocator.isDeferredTag(tagNode));
+    tagAllocator.returnTag(tagNode);
+}
+
+TEST_F(TagAllocatorTest, givenFreeTagsOnlyOnListOfOtherThreadWhenTagIsRequestedThenItIsTakenFromThereWithoutNewPool) {
+    // Big alignment to force only 1 tag per pool
+    MockTagAllocator<0> tagAllocator(memoryManager, 1, 4096);
+
+    auto tagNode = tagAllocator.getTag();
+    ASSERT_NE(nullptr, tagNode);
+    tagAllocator.returnTagToList(tagNode, (tagAllocator.getCallingThreadListIndex() + 1) % TagAllocator<timeStamps>::freeTagListCount);
+
+    EXPECT_EQ(tagNode, tagAllocator.getTag());
+    EXPECT_EQ(1u, tagAllocator.getGraphicsAllocationsCount());
+    tagAllocator.returnTag(tagNode);
+}
+
+TEST_F(TagAllocatorTest, givenNoFreeTagsWhenTagIsRequestedFromUnboundedAllocatorThenNewPoolIsAllocated) {
+    MockTagAllocator<0> tagAllocator(memoryManager, 1, 4096);
+
+    auto tagNode1 = tagAllocator.getTag();
+    auto tagNode2 = tagAllocator.getTag();
+    ASSERT_NE(nullptr, tagNode2);
+    EXPECT_NE(tagNode1->getGraphicsAllocation(), tagNode2->getGraphicsAllocation());
+    EXPECT_EQ(2u, tagAllocator.getGraphicsAllocationsCount());
+
+    tagAllocator.returnTag(tagNode1);
+    tagAllocator.returnTag(tagNode2);
+}
+
+struct MockTagNodeStack : public TagNodeStack<TagNode<timeStamps>> {
+    using TagNodeStack<TagNode<timeStamps>>::head;
+};
+
+struct TestTagNode : public TagNode<timeStamps> {};
+
+TEST(TagNodeStackTest, givenPushedNodesWhenPoppedThenTheyAreReturnedInReverseOrder) {
+    TestTagNode nodes[3];
+    MockTagNodeStack stack;
+    EXPECT_EQ(nullptr, stack.pop());
+
+    nodes[0].next = &nodes[1];
+    stack.push(nodes[0], nodes[1]);
+    stack.push(nodes[2], nodes[2]);
+    EXPECT_EQ(&nodes[2], stack.peekHead());
+
+    EXPECT_EQ(&nodes[2], stack.pop());
+    EXPECT_EQ(nullptr, nodes[2].next);
+    EXPECT_EQ(&nodes[0], stack.pop());
+    EXPECT_EQ(&nodes[1], stack.pop());
+    EXPECT_EQ(nullptr, stack.pop());
+}
+
+TEST(TagNodeStackTest, givenHeadNodePoppedAndPushedBackWhenHeadIsComparedWithOldValueThenItDiffers) {
+    TestTagNode nodes[2];
+    MockTagNodeStack stack;
+    stack.push(nodes[1], nodes[1]);
+    stack.push(nodes[0], nodes[0]);
+    uint64_t staleHead = stack.head.load();
+
+    // same head node, different next - a pop holding staleHead would install &nodes[1]
+    stack.pop();
+    stack.pop();
+    stack.push(nodes[0], nodes[0]);
+
+    EXPECT_EQ(&nodes[0], stack.peekHead());
+    EXPECT_NE(staleHead, stack.head.load());
+}
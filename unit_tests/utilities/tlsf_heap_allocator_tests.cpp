@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/utilities/tlsf_heap_allocator.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace OCLRT;
+
+namespace {
+void *const heapBase = reinterpret_cast<void *>(0x100000);
+const uint64_t heapSize = 1024 * MemoryConstants::pageSize;
+} // namespace
+
+TEST(TlsfHeapAllocatorTest, givenNewAllocatorWhenCreatedThenWholeRangeIsAvailable) {
+    TlsfHeapAllocator allocator(heapBase, heapSize);
+    EXPECT_EQ(heapSize, allocator.getLeftSize());
+    EXPECT_EQ(0u, allocator.getUsedSize());
+
+    auto statistics = allocator.getStatistics();
+    EXPECT_EQ(1u, statistics.freeBlockCount);
+    EXPECT_EQ(heapSize, statistics.largestFreeBlockSize);
+}
+
+TEST(TlsfHeapAllocatorTest, givenSizeNotMultipleOfPageWhenCreatedThenSizeIsRoundedDown) {
+    TlsfHeapAllocator allocator(heapBase, heapSize + 100);
+    EXPECT_EQ(heapSize, allocator.getLeftSize());
+}
+
+TEST(TlsfHeapAllocatorTest, givenUnalignedSizeWhenAllocatingThenSizeIsAlignedToPageAndPointerIsInRange) {
+    TlsfHeapAllocator allocator(heapBase, heapSize);
+    size_t size = 100;
+    auto ptr = allocator.allocate(size);
+    ASSERT_NE(nullptr, ptr);
+    EXPECT_EQ(MemoryConstants::pageSize, size);
+    EXPECT_EQ(heapBase, ptr);
+    EXPECT_EQ(heapSize - MemoryConstants::pageSize, allocator.getLeftSize());
+    allocator.free(ptr, size);
+    EXPECT_EQ(heapSize, allocator.getLeftSize());
+}
+
+TEST(TlsfHeapAllocatorTest, givenZeroSizeWhenAllocatingThenOnePageIsReturned) {
+    TlsfHeapAllocator allocator(heapBase, heapSize);
+    size_t size = 0;
+    auto ptr = allocator.allocate(size);
+    EXPECT_NE(nullptr, ptr);
+    EXPECT_EQ(MemoryConstants::pageSize, size);
+}
+
+TEST(TlsfHeapAllocatorTest, givenSizeBiggerThanHeapWhenAllocatingThenNullptrIsReturnedAndFailureIsCounted) {
+    TlsfHeapAllocator allocator(heapBase, heapSize);
+    size_t size = static_cast<size_t>(heapSize) + MemoryConstants::pageSize;
+    EXPECT_EQ(nullptr, allocator.allocate(size));
+    EXPECT_EQ(1u, allocator.getStatistics().failedAllocationCount);
+}
+
+TEST(TlsfHeapAllocatorTest, givenWholeHeapSizeWhenAllocatingThenAllocationSucceedsAndNextOneFails) {
+    TlsfHeapAllocator allocator(heapBase, heapSize);
+    size_t size = static_cast<size_t>(heapSize);
+    auto ptr = allocator.allocate(size);
+    EXPECT_EQ(heapBase, ptr);
+    EXPECT_EQ(0u, allocator.getLeftSize());
+
+    size_t nextSize = MemoryConstants::pageSize;
+    EXPECT_EQ(nullptr, allocator.allocate(nextSize));
+
+    allocator.free(ptr, size);
+    EXPECT_EQ(heapSize, allocator.getLeftSize());
+}
+
+TEST(TlsfHeapAllocatorTest, givenFragmentedHeapWhenNeighboursAreFreedThenBlocksAreCoalesced) {
+    TlsfHeapAllocator allocator(heapBase, heapSize);
+    const size_t chunkSize = 16 * MemoryConstants::pageSize;
+    std::vector<void *> ptrs;
+    for (int i = 0; i < 8; i++) {
+        size_t size = chunkSize;
+        ptrs.push_back(allocator.allocate(size));
+        ASSERT_NE(nullptr, ptrs.back());
+    }
+
+    allocator.free(ptrs[1], chunkSize);
+    allocator.free(ptrs[3], chunkSize);
+    auto statistics = allocator.getStatistics();
+    EXPECT_EQ(3u, statistics.freeBlockCount);
+    EXPECT_EQ(6u, statistics.usedBlockCount);
+
+    allocator.free(ptrs[2], chunkSize);
+    statistics = allocator.getStatistics();
+    EXPECT_EQ(2u, statistics.freeBlockCount);
+
+    size_t size = 3 * chunkSize;
+    EXPECT_EQ(ptrs[1], allocator.allocate(size));
+    allocator.free(ptrs[1], size);
+
+    for (auto i : {0, 4, 5, 6, 7}) {
+        allocator.free(ptrs[i], chunkSize);
+    }
+    statistics = allocator.getStatistics();
+    EXPECT_EQ(1u, statistics.freeBlockCount);
+    EXPECT_EQ(0u, statistics.usedBlockCount);
+    EXPECT_EQ(heapSize, statistics.largestFreeBlockSize);
+}
+
+TEST(TlsfHeapAllocatorTest, givenAllocationsWhenFreedThenStatisticsAreUpdated) {
+    TlsfHeapAllocator allocator(heapBase, heapSize);
+    size_t size1 = 4 * MemoryConstants::pageSize;
+    size_t size2 = 8 * MemoryConstants::pageSize;
+    auto ptr1 = allocator.allocate(size1);
+    auto ptr2 = allocator.allocate(size2);
+
+    auto statistics = allocator.getStatistics();
+    EXPECT_EQ(2u, statistics.allocationCount);
+    EXPECT_EQ(2u, statistics.usedBlockCount);
+    EXPECT_EQ(size1 + size2, statistics.usedSize);
+    EXPECT_EQ(size1 + size2, statistics.peakUsedSize);
+    EXPECT_EQ(heapSize - size1 - size2, statistics.largestFreeBlockSize);
+
+    allocator.free(ptr1, size1);
+    allocator.free(ptr2, size2);
+    statistics = allocator.getStatistics();
+    EXPECT_EQ(2u, statistics.freeCount);
+    EXPECT_EQ(0u, statistics.usedSize);
+    EXPECT_EQ(size1 + size2, statistics.peakUsedSize);
+}
+
+TEST(TlsfHeapAllocatorTest, givenNullptrWhenFreeingThenNothingChanges) {
+    TlsfHeapAllocator allocator(heapBase, heapSize);
+    allocator.free(nullptr, MemoryConstants::pageSize);
+    EXPECT_EQ(0u, allocator.getStatistics().freeCount);
+}
+
+TEST(TlsfHeapAllocatorTest, givenRandomAllocationsAndFreesWhenStressedThenAllocationsNeverOverlapAndHeapIsFullyRestored) {
+    const uint64_t stressHeapSize = 64 * MemoryConstants::megaByte;
+    void *stressHeapBase = reinterpret_cast<void *>(0x10000000);
+    TlsfHeapAllocator allocator(stressHeapBase, stressHeapSize);
+
+    struct Allocation {
+        uintptr_t address;
+        size_t size;
+    };
+    std::vector<Allocation> allocations;
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<size_t> sizeDistribution(1, 64 * MemoryConstants::pageSize);
+
+    for (int iteration = 0; iteration < 10000; iteration++) {
+        if (allocations.empty() || generator() % 3 != 0) {
+            size_t size = sizeDistribution(generator);
+            auto ptr = allocator.allocate(size);
+            if (ptr != nullptr) {
+                auto address = reinterpret_cast<uintptr_t>(ptr);
+                EXPECT_GE(address, reinterpret_cast<uintptr_t>(stressHeapBase));
+                EXPECT_LE(address + size, reinterpret_cast<uintptr_t>(stressHeapBase) + stressHeapSize);
+                allocations.push_back({address, size});
+            }
+        } else {
+            auto position = generator() % allocations.size();
+            allocator.free(reinterpret_cast<void *>(allocations[position].address), allocations[position].size);
+            allocations[position] = allocations.back();
+            allocations.pop_back();
+        }
+    }
+
+    std::sort(allocations.begin(), allocations.end(), [](const Allocation &a, const Allocation &b) { return a.address < b.address; });
+    size_t usedSize = 0;
+    for (size_t i = 0; i < allocations.size(); i++) {
+        usedSize += allocations[i].size;
+        if (i > 0) {
+            EXPECT_LE(allocations[i - 1].address + allocations[i - 1].size, allocations[i].address);
+        }
+    }
+    EXPECT_EQ(usedSize, allocator.getUsedSize());
+
+    for (auto &allocation : allocations) {
+        allocator.free(reinterpret_cast<void *>(allocation.address), allocation.size);
+    }
+    auto statistics = allocator.getStatistics();
+    EXPECT_EQ(stressHeapSize, allocator.getLeftSize());
+    EXPECT_EQ(1u, statistics.freeBlockCount);
+    EXPECT_EQ(stressHeapSize, statistics.largestFreeBlockSize);
+}